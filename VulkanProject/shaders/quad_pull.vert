@@ -0,0 +1,50 @@
+#version 450
+
+// Vertex pulling: no vertex or index buffer. Each quad is one 8-byte
+// record (see PackedQuad.h) drawn as six vertices, so a draw of quads
+// [first, first + n) is vkCmdDraw(n * 6, 1, first * 6, 0).
+
+layout(set = 0, binding = 0) uniform MVPBlock {
+    mat4 mvp;
+} ubo;
+
+layout(std430, set = 1, binding = 0) readonly buffer QuadBuffer {
+    uvec2 quads[];
+};
+
+layout(push_constant) uniform MeshOrigin {
+    ivec4 origin;
+} mesh;
+
+layout(location = 0) out vec3 fragColor;
+
+// Corner order of ChunkMesher's buildQuad helpers, (u, v) steps per face
+const uvec2 CORNERS[24] = uvec2[](
+    uvec2(0,0), uvec2(0,1), uvec2(1,1), uvec2(1,0),  // +X
+    uvec2(0,1), uvec2(0,0), uvec2(1,0), uvec2(1,1),  // -X
+    uvec2(0,0), uvec2(1,0), uvec2(1,1), uvec2(0,1),  // +Y
+    uvec2(1,0), uvec2(0,0), uvec2(0,1), uvec2(1,1),  // -Y
+    uvec2(0,0), uvec2(1,0), uvec2(1,1), uvec2(0,1),  // +Z
+    uvec2(1,0), uvec2(0,0), uvec2(0,1), uvec2(1,1)   // -Z
+);
+const uint TRIANGLE_CORNERS[6] = uint[](0u, 1u, 2u, 2u, 3u, 0u);
+
+// In-plane axes per face axis: X faces (y, z), Y faces (x, z), Z faces (x, y)
+const int U_AXES[3] = int[](1, 0, 0);
+const int V_AXES[3] = int[](2, 2, 1);
+
+void main()
+{
+    uvec2 q = quads[gl_VertexIndex / 6];
+    uint corner = TRIANGLE_CORNERS[gl_VertexIndex % 6];
+    uint face = (q.y >> 8) & 7u;
+    int axis = int(face / 2u);
+
+    vec3 pos = vec3(q.x & 255u, (q.x >> 8) & 255u, (q.x >> 16) & 255u);
+    uvec2 step = CORNERS[face * 4u + corner];
+    pos[U_AXES[axis]] += float(step.x * (q.x >> 24));
+    pos[V_AXES[axis]] += float(step.y * (q.y & 255u));
+
+    fragColor = vec3((q.y >> 11) & 127u, (q.y >> 18) & 127u, (q.y >> 25) & 127u) / 127.0;
+    gl_Position = ubo.mvp * vec4(pos + vec3(mesh.origin.xyz), 1.0);
+}
@@ -3,16 +3,18 @@
 #include "Time.h"
 #include "Engine/Graphics/VulkanContext.h"
 #include "Engine/Graphics/Renderer.h"
+#include "Engine/Graphics/VulkanMeshSink.h"
 #include <GLFW/glfw3.h>
 #include "Engine/Scene/Camera.h"
 #include "Engine/Utils/Logger.h"
+#include "Engine/Utils/Profiler.h"
 #include "Engine/Voxels/VoxelWorld.h"
 #include "Engine/Voxels/VoxelSetup.h"
 
 
 
 #include <stdexcept>
-#include <iostream>
+#include <fstream>
 
 // ----------------------------------------------
 // ADD: ThreadPool
@@ -41,13 +43,15 @@ Application::~Application()
 // -----------------------------------------------------------------------------
 void Application::init()
 {
+    Profiler::setThreadName("Main");
+
     // 1) register all voxel types from VoxelTypeRegistry.
     registerAllVoxels();
-    std::cout << "DEBUG: Registered all voxel types." << std::endl;
+    LOG_DEBUG("Registered all voxel types.");
 
     // 2) Create GLFW window
     m_window = new Window(800, 600, "My Voxel Engine");
-    std::cout << "DEBUG:  Created Window " << std::endl;
+    LOG_DEBUG("Created Window");
 
     // 3) Time / DeltaTime -- this is for tracking the time between frames.
     m_time = new Time();
@@ -56,14 +60,24 @@ void Application::init()
     m_vulkanCtx = new VulkanContext();
     m_vulkanCtx->init(m_window);
 
-    // 5) Create VoxelWorld
-    m_voxelWorld = new VoxelWorld(m_vulkanCtx);
+    // 5) Create VoxelWorld (meshes go to the GPU through the mesh sink).
+    //    Packed quads (vertex pulling) when their shader has been compiled.
+    VulkanMeshSink::Format meshFormat = VulkanMeshSink::Format::SharedQuadIndices;
+    if (std::ifstream("shaders/quad_pull.vert.spv").good()) {
+        meshFormat = VulkanMeshSink::Format::PackedQuads;
+    }
+    else {
+        LOG_WARN("shaders/quad_pull.vert.spv not found, drawing vertex buffers with shared quad indices");
+    }
+    m_meshSink = new VulkanMeshSink(m_vulkanCtx, meshFormat);
+    m_voxelWorld = new VoxelWorld(m_meshSink);
     m_voxelWorld->initWorld();
 
     // 6) Create Renderer
     m_renderer = new Renderer(m_vulkanCtx, m_window, m_voxelWorld);
 
     m_renderer->setTime(m_time);
+    m_renderer->setMeshSink(m_meshSink);
 
     m_isRunning = true;
 }
@@ -116,6 +130,7 @@ void Application::runLoop()
     bool wireframeWasPressed = false;
 
     while (m_isRunning && !m_window->shouldClose()) {
+        m_renderer->getFrameTiming().beginFrame();
 
         m_window->pollEvents();
         m_time->update();
@@ -126,7 +141,7 @@ void Application::runLoop()
 
         // 2) Update chunks near the player's position
         if (m_voxelWorld) {
-            m_voxelWorld->updateChunksAroundPlayer(camera.position.x, camera.position.z);
+            m_voxelWorld->updateChunksAroundPlayer(camera.position);
         }
 
         // 3) Press F => toggle wireframe
@@ -134,7 +149,7 @@ void Application::runLoop()
             (glfwGetKey(m_window->getGLFWwindow(), GLFW_KEY_F) == GLFW_PRESS);
 
         if (wireframeIsPressed && !wireframeWasPressed) {
-            Logger::Info("Toggling wireframe mode...");
+            LOG_INFO("Toggling wireframe mode...");
             m_renderer->toggleWireframe();
         }
         wireframeWasPressed = wireframeIsPressed;
@@ -153,6 +168,12 @@ void Application::cleanup()
         m_voxelWorld = nullptr;
     }
 
+    // The world hands its meshes back on destruction, so the sink goes second
+    if (m_meshSink) {
+        delete m_meshSink;
+        m_meshSink = nullptr;
+    }
+
     // 2) Destroy the Renderer
     if (m_renderer) {
         delete m_renderer;
@@ -181,4 +202,7 @@ void Application::cleanup()
     // But it's also called automatically in its destructor.
 
     m_isRunning = false;
+
+    // Write out anything still queued and stop the log flusher
+    Logger::shutdown();
 }
@@ -9,6 +9,7 @@ class VulkanContext;
 class Renderer;
 class Camera;
 class VoxelWorld;
+class VulkanMeshSink;
 
 // -----------------------------------------------------------------------------
 // Class Definition
@@ -62,6 +63,7 @@ private:
     VulkanContext* m_vulkanCtx = nullptr;  ///< Pointer to the Vulkan context
     Renderer* m_renderer = nullptr;  ///< Pointer to the renderer
     VoxelWorld* m_voxelWorld = nullptr;  ///< Pointer to the voxel world
+    VulkanMeshSink* m_meshSink = nullptr;  ///< Uploads the world's chunk meshes
 
     bool           m_isRunning = false;    ///< Flag to keep the main loop running
 };
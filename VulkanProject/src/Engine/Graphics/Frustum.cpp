@@ -1,6 +1,36 @@
 #include "Frustum.h"
 #include <cmath>   // for std::sqrt
 
+// Widest float SIMD the build targets; cullAABBs falls back to scalar
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define FRUSTUM_AVX2 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define FRUSTUM_SSE 1
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define FRUSTUM_NEON 1
+#endif
+
+void AABBList::clear()
+{
+    minX.clear(); minY.clear(); minZ.clear();
+    maxX.clear(); maxY.clear(); maxZ.clear();
+}
+
+void AABBList::reserve(size_t count)
+{
+    minX.reserve(count); minY.reserve(count); minZ.reserve(count);
+    maxX.reserve(count); maxY.reserve(count); maxZ.reserve(count);
+}
+
+void AABBList::add(const glm::vec3& minB, const glm::vec3& maxB)
+{
+    minX.push_back(minB.x); minY.push_back(minB.y); minZ.push_back(minB.z);
+    maxX.push_back(maxB.x); maxY.push_back(maxB.y); maxZ.push_back(maxB.z);
+}
+
 void Frustum::extractPlanes(const glm::mat4& vp)
 {
     // The typical approach is to extract planes from the rows/columns of vp.
@@ -67,12 +97,11 @@ bool Frustum::intersectsAABB(const glm::vec3& minB, const glm::vec3& maxB) const
     {
         const Plane& p = planes[i];
 
-        // Find the "closest point" (in terms of plane normal direction)
-        // For the plane normal, if A>0 => use max x, else use min x, etc.
-        // This point is the "most likely to be outside" corner of the box.
-        float x = (p.A >= 0.0f) ? minB.x : maxB.x;
-        float y = (p.B >= 0.0f) ? minB.y : maxB.y;
-        float z = (p.C >= 0.0f) ? minB.z : maxB.z;
+        // The corner furthest along the plane normal: if A>=0 => use max x,
+        // else use min x, etc. If even that one is behind, the whole box is.
+        float x = (p.A >= 0.0f) ? maxB.x : minB.x;
+        float y = (p.B >= 0.0f) ? maxB.y : minB.y;
+        float z = (p.C >= 0.0f) ? maxB.z : minB.z;
 
         // Distance from plane
         float dist = p.A * x + p.B * y + p.C * z + p.D;
@@ -86,3 +115,139 @@ bool Frustum::intersectsAABB(const glm::vec3& minB, const glm::vec3& maxB) const
     // If we never found it completely outside, it's at least partially inside.
     return true;
 }
+
+Frustum::Containment Frustum::classifyAABB(const glm::vec3& minB, const glm::vec3& maxB) const
+{
+    Containment result = INSIDE;
+    for (int i = 0; i < 6; i++)
+    {
+        const Plane& p = planes[i];
+
+        // Furthest corner along the normal behind => all of the box is
+        float x = (p.A >= 0.0f) ? maxB.x : minB.x;
+        float y = (p.B >= 0.0f) ? maxB.y : minB.y;
+        float z = (p.C >= 0.0f) ? maxB.z : minB.z;
+        if (p.A * x + p.B * y + p.C * z + p.D < 0.0f) {
+            return OUTSIDE;
+        }
+
+        // Nearest corner behind => the plane cuts through the box
+        x = (p.A >= 0.0f) ? minB.x : maxB.x;
+        y = (p.B >= 0.0f) ? minB.y : maxB.y;
+        z = (p.C >= 0.0f) ? minB.z : maxB.z;
+        if (p.A * x + p.B * y + p.C * z + p.D < 0.0f) {
+            result = INTERSECTS;
+        }
+    }
+    return result;
+}
+
+void Frustum::cullAABBs(const AABBList& boxes, std::vector<uint32_t>& outVisible) const
+{
+    const size_t count = boxes.size();
+    outVisible.resize(count);
+    uint32_t* out = outVisible.data();
+    size_t visible = 0;
+    size_t i = 0;
+
+#if FRUSTUM_AVX2 || FRUSTUM_SSE || FRUSTUM_NEON
+    // Per plane, the arrays holding each box's furthest corner along the
+    // normal (same choice as intersectsAABB)
+    const float* xs[6];
+    const float* ys[6];
+    const float* zs[6];
+    for (int k = 0; k < 6; k++)
+    {
+        xs[k] = (planes[k].A >= 0.0f) ? boxes.maxX.data() : boxes.minX.data();
+        ys[k] = (planes[k].B >= 0.0f) ? boxes.maxY.data() : boxes.minY.data();
+        zs[k] = (planes[k].C >= 0.0f) ? boxes.maxZ.data() : boxes.minZ.data();
+    }
+#endif
+
+#if FRUSTUM_AVX2
+    for (; i + 8 <= count; i += 8)
+    {
+        __m256 outside = _mm256_setzero_ps();
+        for (int k = 0; k < 6; k++)
+        {
+            const Plane& p = planes[k];
+            __m256 dist = _mm256_add_ps(
+                _mm256_add_ps(
+                    _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(p.A), _mm256_loadu_ps(xs[k] + i)),
+                                  _mm256_mul_ps(_mm256_set1_ps(p.B), _mm256_loadu_ps(ys[k] + i))),
+                    _mm256_mul_ps(_mm256_set1_ps(p.C), _mm256_loadu_ps(zs[k] + i))),
+                _mm256_set1_ps(p.D));
+            outside = _mm256_or_ps(outside, _mm256_cmp_ps(dist, _mm256_setzero_ps(), _CMP_LT_OQ));
+        }
+        unsigned mask = ~(unsigned)_mm256_movemask_ps(outside) & 0xFFu;
+        for (uint32_t lane = 0; mask; lane++, mask >>= 1) {
+            if (mask & 1u) out[visible++] = (uint32_t)i + lane;
+        }
+    }
+#elif FRUSTUM_SSE
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128 outside = _mm_setzero_ps();
+        for (int k = 0; k < 6; k++)
+        {
+            const Plane& p = planes[k];
+            __m128 dist = _mm_add_ps(
+                _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(_mm_set1_ps(p.A), _mm_loadu_ps(xs[k] + i)),
+                               _mm_mul_ps(_mm_set1_ps(p.B), _mm_loadu_ps(ys[k] + i))),
+                    _mm_mul_ps(_mm_set1_ps(p.C), _mm_loadu_ps(zs[k] + i))),
+                _mm_set1_ps(p.D));
+            outside = _mm_or_ps(outside, _mm_cmplt_ps(dist, _mm_setzero_ps()));
+        }
+        unsigned mask = ~(unsigned)_mm_movemask_ps(outside) & 0xFu;
+        for (uint32_t lane = 0; mask; lane++, mask >>= 1) {
+            if (mask & 1u) out[visible++] = (uint32_t)i + lane;
+        }
+    }
+#elif FRUSTUM_NEON
+    for (; i + 4 <= count; i += 4)
+    {
+        uint32x4_t outside = vdupq_n_u32(0);
+        for (int k = 0; k < 6; k++)
+        {
+            const Plane& p = planes[k];
+            float32x4_t dist = vaddq_f32(
+                vaddq_f32(
+                    vaddq_f32(vmulq_n_f32(vld1q_f32(xs[k] + i), p.A),
+                              vmulq_n_f32(vld1q_f32(ys[k] + i), p.B)),
+                    vmulq_n_f32(vld1q_f32(zs[k] + i), p.C)),
+                vdupq_n_f32(p.D));
+            outside = vorrq_u32(outside, vcltq_f32(dist, vdupq_n_f32(0.0f)));
+        }
+        uint32_t lanes[4];
+        vst1q_u32(lanes, outside);
+        for (uint32_t lane = 0; lane < 4; lane++) {
+            if (!lanes[lane]) out[visible++] = (uint32_t)i + lane;
+        }
+    }
+#endif
+
+    // Scalar for the rest (or everything without SIMD)
+    for (; i < count; i++)
+    {
+        glm::vec3 minB(boxes.minX[i], boxes.minY[i], boxes.minZ[i]);
+        glm::vec3 maxB(boxes.maxX[i], boxes.maxY[i], boxes.maxZ[i]);
+        if (intersectsAABB(minB, maxB)) {
+            out[visible++] = (uint32_t)i;
+        }
+    }
+    outVisible.resize(visible);
+}
+
+const char* Frustum::simdPath()
+{
+#if FRUSTUM_AVX2
+    return "avx2";
+#elif FRUSTUM_SSE
+    return "sse";
+#elif FRUSTUM_NEON
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
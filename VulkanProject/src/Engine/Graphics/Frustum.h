@@ -1,5 +1,22 @@
 #pragma once
 #include <glm/glm.hpp>
+#include <vector>
+#include <cstdint>
+
+///
+/// Axis-aligned boxes as a structure of arrays, so Frustum::cullAABBs can
+/// test several per instruction. Index i is the i-th add() since clear().
+///
+struct AABBList
+{
+    std::vector<float> minX, minY, minZ;
+    std::vector<float> maxX, maxY, maxZ;
+
+    size_t size() const { return minX.size(); }
+    void clear();
+    void reserve(size_t count);
+    void add(const glm::vec3& minB, const glm::vec3& maxB);
+};
 
 ///
 /// A small utility for culling objects against the cameras frustum.
@@ -21,6 +38,20 @@ public:
     /// Checks if the given axis-aligned bounding box (min/max) intersects the frustum.
     bool intersectsAABB(const glm::vec3& minB, const glm::vec3& maxB) const;
 
+    enum Containment { OUTSIDE, INTERSECTS, INSIDE };
+
+    /// Like intersectsAABB, but also tells boxes entirely inside (no
+    /// corner behind any plane) from those crossing a plane.
+    Containment classifyAABB(const glm::vec3& minB, const glm::vec3& maxB) const;
+
+    /// intersectsAABB over every box in the list, 8 (AVX2) or 4 (SSE, NEON)
+    /// at a time. Overwrites outVisible with the indices of the boxes that
+    /// intersect, in increasing order.
+    void cullAABBs(const AABBList& boxes, std::vector<uint32_t>& outVisible) const;
+
+    /// "avx2", "sse", "neon" or "scalar": the path cullAABBs was built with.
+    static const char* simdPath();
+
 private:
     /// Normalize a plane's (A,B,C) so that its normal is unit-length.
     void normalizePlane(Plane& plane);
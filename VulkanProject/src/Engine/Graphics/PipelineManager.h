@@ -65,6 +65,34 @@ public:
         VkExtent2D viewportExtent,
         VkDescriptorSetLayout descriptorLayout);
 
+    // -----------------------------------------------------------------------------
+    // 4) "Translucent" pipeline WITH descriptor layout
+    //
+    //    Fill pipeline that blends over the scene without writing depth.
+    //    Drawn after all opaque geometry (water).
+    // -----------------------------------------------------------------------------
+    void createVoxelPipelineTranslucent(
+        const std::string& pipelineName,
+        VkRenderPass renderPass,
+        VkExtent2D viewportExtent,
+        VkDescriptorSetLayout descriptorLayout);
+
+    // -----------------------------------------------------------------------------
+    // 5) "Pulled" pipeline: MVP layout + packed quad buffer (set 1)
+    //
+    //    Vertex pulling (shaders/quad_pull.vert) for VulkanMeshSink's
+    //    PackedQuads meshes: no vertex input, the mesh origin is a push
+    //    constant. Fill or wireframe, optionally blended like (4).
+    // -----------------------------------------------------------------------------
+    void createVoxelPipelinePulled(
+        const std::string& pipelineName,
+        VkRenderPass renderPass,
+        VkExtent2D viewportExtent,
+        VkDescriptorSetLayout descriptorLayout,
+        VkDescriptorSetLayout quadSetLayout,
+        VkPolygonMode polygonMode,
+        bool translucent);
+
     // -----------------------------------------------------------------------------
     // Create a descriptor set layout for the MVP uniform
     // -----------------------------------------------------------------------------
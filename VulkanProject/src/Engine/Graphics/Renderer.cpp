@@ -7,15 +7,20 @@
 #include "RenderPassManager.h"
 #include "Engine/Voxels/VoxelWorld.h"
 #include "Engine/Voxels/Chunk.h"
+#include "Engine/Voxels/VoxelRaycast.h"
+#include "Engine/Voxels/VoxelTypeRegistry.h"
+#include "Engine/Voxels/BuiltinVoxels.h"
 #include "Engine/Scene/Camera.h"
 #include "Engine/Core/Time.h"
 #include "../Utils/CpuProfiler.h"
+#include "../Utils/Profiler.h"
 
 #include "../External Libraries/imgui/imgui.h"
 #include "../External Libraries/imgui/backends/imgui_impl_glfw.h"
 #include "../External Libraries/imgui/backends/imgui_impl_vulkan.h"
 
 #include "Frustum.h"
+#include "VulkanMeshSink.h"
 
 #include <stdexcept>
 #include <vector>
@@ -23,6 +28,8 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <Engine/Utils/Logger.h>
 #include <deque>
+#include <algorithm>
+#include <chrono>
 #include <Engine/Utils/ThreadPool.h>
 
 // If you want to query CPU usage
@@ -98,6 +105,11 @@ Renderer::Renderer(VulkanContext* context, Window* window, VoxelWorld* voxelWorl
     m_mvpLayout = m_pipelineMgr->createMVPDescriptorSetLayout();
     m_pipelineMgr->createVoxelPipelineFill("voxel_fill", renderPass, extent, m_mvpLayout);
     m_pipelineMgr->createVoxelPipelineWireframe("voxel_wireframe", renderPass, extent, m_mvpLayout);
+    m_pipelineMgr->createVoxelPipelineTranslucent("voxel_translucent", renderPass, extent, m_mvpLayout);
+
+    if (m_voxelWorld) {
+        m_voxelWorld->getLODPolicy().setProjection(glm::radians(45.f), float(extent.height));
+    }
 
     // 6) MVP Uniform Buffer
     createMVPUniformBuffer();
@@ -137,6 +149,7 @@ Renderer::Renderer(VulkanContext* context, Window* window, VoxelWorld* voxelWorl
             throw std::runtime_error("Failed to create fence for frame " + std::to_string(i));
         }
     }
+    createTimestampQueries();
 
     // 8) Initialize ImGui
     {
@@ -235,6 +248,12 @@ Renderer::~Renderer()
         }
     }
 
+    if (m_timestampPool)
+    {
+        vkDestroyQueryPool(m_context->getDevice(), m_timestampPool, nullptr);
+        m_timestampPool = VK_NULL_HANDLE;
+    }
+
     // MVP
     if (m_mvpBuffer)
     {
@@ -367,21 +386,377 @@ void Renderer::updateMVP()
     vkUnmapMemory(m_context->getDevice(), m_mvpMemory);
 }
 
-static int computeLODLevel(float dist)
+static bool hasDrawableMesh(const Chunk* chunk, int lod)
+{
+    const auto& lodData = chunk->getLODData(lod);
+    return lodData.valid && lodData.mesh != nullptr && lodData.indexCount > 0;
+}
+
+// Seams built for this chunk LOD (a seam for another LOD would leave gaps)
+static bool isSeamDrawable(const ChunkSeamData& seam, int lod)
+{
+    return seam.valid && seam.mesh != nullptr && seam.indexCount > 0 && seam.lod == lod;
+}
+
+// A chunk can be all border faces (e.g. solid underground), so seams count too
+static bool hasDrawableGeometry(const Chunk* chunk, int lod)
+{
+    if (hasDrawableMesh(chunk, lod)) return true;
+    for (int face = 0; face < 6; face++) {
+        if (isSeamDrawable(chunk->getSeamData(static_cast<Chunk::SeamDirection>(face)), lod)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// The LOD VoxelWorld picked for this chunk (LODPolicy). While that mesh is
+// still being built, keep drawing the closest LOD we do have (finer first)
+// so the chunk doesn't blink out. Returns -1 if there is nothing to draw.
+static int pickDrawLOD(const Chunk* chunk)
+{
+    int target = chunk->getTargetLOD();
+    if (target < 0) target = 0;
+
+    bool targetReady = !chunk->isLODDirty(target) && !chunk->isUploading();
+    if (targetReady) {
+        // Up to date; an empty mesh just means nothing to draw (all air)
+        return hasDrawableGeometry(chunk, target) ? target : -1;
+    }
+
+    for (int step = 0; step < Chunk::MAX_LOD_LEVELS; step++)
+    {
+        if (target - step >= 0 && hasDrawableMesh(chunk, target - step)) {
+            return target - step;
+        }
+        if (step > 0 && target + step < Chunk::MAX_LOD_LEVELS && hasDrawableMesh(chunk, target + step)) {
+            return target + step;
+        }
+    }
+    return -1;
+}
+
+// ------------------------------------------------
+// collectVisibleChunks
+//  Frustum + visibility-graph culling, then LOD pick (pickDrawLOD).
+//  Fills m_visibleChunks for recordChunkDraws(). The chunk
+//  quadtree drops whole areas outside the frustum or the view
+//  distance; chunks in columns crossing a plane are then
+//  tested batched (Frustum::cullAABBs).
+// ------------------------------------------------
+void Renderer::collectVisibleChunks(const Frustum& frustum)
+{
+    PROFILE_ZONE("Collect Visible Chunks");
+    m_visibleChunks.clear();
+    m_visibleSuperChunks.clear();
+    m_chunksCulledFrustum = 0;
+    m_chunksCulledVisibility = 0;
+    m_chunksInSuperChunks = 0;
+
+    if (!m_voxelWorld) return;
+
+    // Far-field superchunks first; their members are skipped below
+    const SuperChunkManager& superChunks = m_voxelWorld->getSuperChunks();
+    for (auto& kv : superChunks.getAll())
+    {
+        const SuperChunk& sc = kv.second;
+        if (!sc.active || !sc.mesh || sc.indexCount == 0) continue;
+
+        if (m_enableFrustumCulling)
+        {
+            glm::vec3 minB, maxB;
+            superChunks.getBoundingBox(sc, minB, maxB);
+            if (!frustum.intersectsAABB(minB, maxB)) continue;
+        }
+        m_visibleSuperChunks.push_back(&sc);
+    }
+
+    const ChunkManager& chunkMgr = m_voxelWorld->getChunkManager();
+    if (m_enableCaveCulling)
+    {
+        m_visibilityCuller.update(chunkMgr, m_camera.position,
+            m_enableFrustumCulling ? &frustum : nullptr);
+    }
+
+    MeshResidency& residency = m_voxelWorld->getMeshResidency();
+
+    ChunkQuadtree::CullStats treeStats;
+    chunkMgr.getQuadtree().cull(m_enableFrustumCulling ? &frustum : nullptr,
+        m_camera.position, m_viewDistance,
+        m_treeChunks, m_candidateBounds, m_candidateChunks, &treeStats);
+    m_quadtreeNodesVisited = treeStats.nodesVisited;
+    m_quadtreeNodesCulled = treeStats.nodesCulled;
+    m_chunksCulledFrustum = treeStats.chunksCulled;
+
+    if (!m_candidateChunks.empty())
+    {
+        frustum.cullAABBs(m_candidateBounds, m_candidateVisible);
+        m_chunksCulledFrustum += (uint32_t)(m_candidateChunks.size() - m_candidateVisible.size());
+        for (uint32_t index : m_candidateVisible) {
+            m_treeChunks.push_back(m_candidateChunks[index]);
+        }
+    }
+
+    for (Chunk* chunk : m_treeChunks)
+    {
+        const int cx = chunk->worldX(), cy = chunk->worldY(), cz = chunk->worldZ();
+
+        if (superChunks.findActive(cx, cy, cz))
+        {
+            m_chunksInSuperChunks++;
+            continue;
+        }
+
+        if (m_enableCaveCulling && !m_visibilityCuller.isVisible(cx, cy, cz))
+        {
+            m_chunksCulledVisibility++;
+            continue;
+        }
+
+        int lodLevel = pickDrawLOD(chunk);
+        if (lodLevel < 0) {
+            continue;
+        }
+        residency.markUsed(*chunk, lodLevel);
+
+        VisibleChunk vc;
+        vc.chunk = chunk;
+        vc.lodLevel = lodLevel;
+        m_visibleChunks.push_back(vc);
+    }
+}
+
+// ------------------------------------------------
+// selectDrawRanges
+//  The parts of a mesh's opaque index range [0,
+//  opaqueIndexCount) or its translucent one [opaqueIndexCount,
+//  indexCount) to draw, into m_drawFirsts / m_drawCounts.
+//  With meshlet culling and meshlets: those inside the
+//  frustum and (with facing culling) facing the camera,
+//  touching ones merged.
+//  Otherwise the face ranges whose directions are in
+//  faceMask (see MeshFaceRanges; meshes without face
+//  ranges draw the whole range). Adds the indices left out
+//  to skippedIndices.
+// ------------------------------------------------
+void Renderer::selectDrawRanges(uint32_t indexCount, uint32_t opaqueIndexCount, bool translucent,
+    const MeshFaceRanges& faceRanges, const std::vector<Meshlet>* meshlets, uint8_t faceMask,
+    const Frustum& frustum, uint32_t& skippedIndices)
+{
+    m_drawFirsts.clear();
+    m_drawCounts.clear();
+
+    const int pass = translucent ? 1 : 0;
+    const uint32_t passBegin = translucent ? opaqueIndexCount : 0;
+    const uint32_t passEnd = translucent ? indexCount : opaqueIndexCount;
+    if (passEnd <= passBegin) return;
+
+    uint32_t drawn = 0;
+    if (m_enableMeshletCulling && meshlets && !meshlets->empty())
+    {
+        for (const Meshlet& m : *meshlets)
+        {
+            if (m.firstIndex < passBegin || m.firstIndex >= passEnd) continue;
+            if (m.isEmpty() || (m_enableFacingCulling && !m.facesEye(m_camera.position))
+                || !frustum.intersectsAABB(m.minB, m.maxB))
+            {
+                if (!m.isEmpty()) m_meshletsCulled++;
+                continue;
+            }
+            m_meshletsDrawn++;
+            drawn += m.indexCount;
+            if (!m_drawFirsts.empty() && m_drawFirsts.back() + m_drawCounts.back() == m.firstIndex) {
+                m_drawCounts.back() += m.indexCount;
+            }
+            else {
+                m_drawFirsts.push_back(m.firstIndex);
+                m_drawCounts.push_back(m.indexCount);
+            }
+        }
+    }
+    else
+    {
+        uint32_t firsts[MeshFaceRanges::MAX_RANGES];
+        uint32_t counts[MeshFaceRanges::MAX_RANGES];
+        const int ranges = faceRanges.visibleRanges(pass, passBegin, passEnd, faceMask, firsts, counts);
+        for (int r = 0; r < ranges; r++)
+        {
+            m_drawFirsts.push_back(firsts[r]);
+            m_drawCounts.push_back(counts[r]);
+            drawn += counts[r];
+        }
+    }
+    skippedIndices += (passEnd - passBegin) - drawn;
+}
+
+// Binds a mesh and draws the index ranges in m_drawFirsts / m_drawCounts.
+// Returns the number of draws recorded.
+//
+// Meshes without an index buffer use the shared 16-bit quad pattern; it
+// only reaches SHARED_INDEX_QUADS quads, so longer ranges are drawn in
+// pieces, each rebasing the pattern with vertexOffset. Packed quads have
+// no vertex input at all: six vertices per quad, starting at the range's
+// first quad, read from the mesh's storage buffer.
+uint32_t Renderer::drawRanges(VkCommandBuffer cmdBuf, const GpuMesh* gpuMesh, VkBuffer quadIndexBuffer,
+    VkPipelineLayout pipelineLayout) const
+{
+    const size_t ranges = m_drawFirsts.size();
+    if (ranges == 0) return 0;
+
+    const VulkanGpuMesh* mesh = VulkanMeshSink::cast(gpuMesh);
+    if (mesh->quadSet != VK_NULL_HANDLE)
+    {
+        vkCmdBindDescriptorSets(cmdBuf, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout,
+            1, 1, &mesh->quadSet, 0, nullptr);
+        vkCmdPushConstants(cmdBuf, pipelineLayout, VK_SHADER_STAGE_VERTEX_BIT,
+            0, sizeof(mesh->origin), mesh->origin);
+        for (size_t r = 0; r < ranges; r++) {
+            vkCmdDraw(cmdBuf, m_drawCounts[r], 1, m_drawFirsts[r], 0);
+        }
+        return (uint32_t)ranges;
+    }
+
+    VkDeviceSize offsets[] = { 0 };
+    vkCmdBindVertexBuffers(cmdBuf, 0, 1, &mesh->vertexBuffer, offsets);
+    if (mesh->indexBuffer != VK_NULL_HANDLE)
+    {
+        vkCmdBindIndexBuffer(cmdBuf, mesh->indexBuffer, 0, VK_INDEX_TYPE_UINT32);
+        for (size_t r = 0; r < ranges; r++) {
+            vkCmdDrawIndexed(cmdBuf, m_drawCounts[r], 1, m_drawFirsts[r], 0, 0);
+        }
+        return (uint32_t)ranges;
+    }
+
+    vkCmdBindIndexBuffer(cmdBuf, quadIndexBuffer, 0, VK_INDEX_TYPE_UINT16);
+    uint32_t draws = 0;
+    for (size_t r = 0; r < ranges; r++)
+    {
+        uint32_t quad = m_drawFirsts[r] / 6;
+        uint32_t endQuad = quad + m_drawCounts[r] / 6;
+        while (quad < endQuad)
+        {
+            uint32_t n = std::min(endQuad - quad, ChunkMesher::SHARED_INDEX_QUADS);
+            vkCmdDrawIndexed(cmdBuf, n * 6, 1, 0, (int32_t)(quad * 4), 0);
+            quad += n;
+            draws++;
+        }
+    }
+    return draws;
+}
+
+void Renderer::setMeshSink(VulkanMeshSink* meshSink)
+{
+    m_meshSink = meshSink;
+    createPulledPipelines();
+}
+
+bool Renderer::usesPulledQuads() const
 {
-    if (dist < 40.f)  return 0;
-    else if (dist < 80.f) return 1;
-    else return 2;
+    return m_meshSink && m_meshSink->getFormat() == VulkanMeshSink::Format::PackedQuads;
+}
+
+void Renderer::createPulledPipelines()
+{
+    if (!usesPulledQuads()) return;
+
+    auto extent = m_swapChain->getExtent();
+    auto renderPass = m_rpManager->getRenderPass();
+    VkDescriptorSetLayout quadLayout = m_meshSink->getQuadSetLayout();
+    m_pipelineMgr->createVoxelPipelinePulled("voxel_pull_fill", renderPass, extent,
+        m_mvpLayout, quadLayout, VK_POLYGON_MODE_FILL, false);
+    m_pipelineMgr->createVoxelPipelinePulled("voxel_pull_wireframe", renderPass, extent,
+        m_mvpLayout, quadLayout, VK_POLYGON_MODE_LINE, false);
+    m_pipelineMgr->createVoxelPipelinePulled("voxel_pull_translucent", renderPass, extent,
+        m_mvpLayout, quadLayout, VK_POLYGON_MODE_FILL, true);
+}
+
+// ------------------------------------------------
+// recordChunkDraws
+//  Binds & draws each visible chunk's LOD mesh and seams,
+//  one index range per pass, minus the meshlets outside
+//  the frustum or facing away, or (without meshlets) the
+//  face directions that point away from the camera
+//  everywhere in the chunk's box (a seam holds a single
+//  direction). Vertices are counted in the opaque pass.
+// ------------------------------------------------
+void Renderer::recordChunkDraws(VkCommandBuffer cmdBuf, bool translucent, VkPipelineLayout pipelineLayout,
+    const Frustum& frustum, uint32_t& totalVertices, uint32_t& drawCallCount)
+{
+    PROFILE_ZONE("Record Chunk Draws");
+    VkBuffer quadIndexBuffer = m_meshSink ? m_meshSink->getQuadIndexBuffer() : VK_NULL_HANDLE;
+    const MeshFaceRanges noFaceRanges{};
+    const uint8_t allFaces = 0x3F;
+    uint32_t skippedIndices = 0;
+    for (const VisibleChunk& vc : m_visibleChunks)
+    {
+        const Chunk* chunk = vc.chunk;
+        uint8_t faceMask = allFaces;
+        if (m_enableFacingCulling)
+        {
+            glm::vec3 minB, maxB;
+            chunk->getBoundingBox(minB, maxB);
+            faceMask = MeshFaceRanges::facingMask(m_camera.position, minB, maxB);
+        }
+
+        if (hasDrawableMesh(chunk, vc.lodLevel))
+        {
+            const auto& lodData = chunk->getLODData(vc.lodLevel);
+            selectDrawRanges(lodData.indexCount, lodData.opaqueIndexCount, translucent,
+                lodData.faceRanges, &lodData.meshlets, faceMask, frustum, skippedIndices);
+            drawCallCount += drawRanges(cmdBuf, lodData.mesh, quadIndexBuffer, pipelineLayout);
+            if (!translucent) totalVertices += lodData.vertexCount;
+        }
+
+        // Border faces: the seams built for the LOD we're drawing
+        for (int faceDir = 0; faceDir < 6; faceDir++)
+        {
+            const auto& seamData = chunk->getSeamData(static_cast<Chunk::SeamDirection>(faceDir));
+            if (!isSeamDrawable(seamData, vc.lodLevel)) {
+                continue;
+            }
+            selectDrawRanges(seamData.indexCount, seamData.opaqueIndexCount, translucent,
+                noFaceRanges, nullptr, (faceMask & (1u << faceDir)) ? allFaces : 0, frustum, skippedIndices);
+            drawCallCount += drawRanges(cmdBuf, seamData.mesh, quadIndexBuffer, pipelineLayout);
+            if (!translucent) totalVertices += seamData.vertexCount;
+        }
+    }
+
+    for (const SuperChunk* sc : m_visibleSuperChunks)
+    {
+        uint8_t faceMask = allFaces;
+        if (m_enableFacingCulling)
+        {
+            glm::vec3 minB, maxB;
+            m_voxelWorld->getSuperChunks().getBoundingBox(*sc, minB, maxB);
+            faceMask = MeshFaceRanges::facingMask(m_camera.position, minB, maxB);
+        }
+        selectDrawRanges(sc->indexCount, sc->opaqueIndexCount, translucent,
+            sc->faceRanges, &sc->meshlets, faceMask, frustum, skippedIndices);
+        drawCallCount += drawRanges(cmdBuf, sc->mesh, quadIndexBuffer, pipelineLayout);
+        if (!translucent) totalVertices += sc->vertexCount;
+    }
+    m_trianglesSkipped += skippedIndices / 3;
 }
 
 void Renderer::renderFrame()
 {
+    PROFILE_ZONE("Render Frame");
+
     // Wait on fence
-    vkWaitForFences(m_context->getDevice(),
-        1,
-        &m_frames[m_currentFrame].inFlightFence,
-        VK_TRUE,
-        UINT64_MAX);
+    {
+        PROFILE_ZONE("Wait For Fence");
+        auto waitStart = std::chrono::steady_clock::now();
+        vkWaitForFences(m_context->getDevice(),
+            1,
+            &m_frames[m_currentFrame].inFlightFence,
+            VK_TRUE,
+            UINT64_MAX);
+        m_frameTiming.addWaitTime(std::chrono::duration<double, std::milli>(
+            std::chrono::steady_clock::now() - waitStart).count());
+    }
+
+    // This slot's previous frame is done: its timestamps are ready
+    readGpuTimestamps(m_frames[m_currentFrame], m_currentFrame);
 
     // Reset fence
     vkResetFences(m_context->getDevice(),
@@ -391,15 +766,12 @@ void Renderer::renderFrame()
     // Update MVP
     updateMVP();
 
-    // Possibly build frustum for culling
-    Frustum frustum;
-    if (m_enableFrustumCulling)
-    {
-        frustum = buildCameraFrustum(m_camera, m_swapChain->getExtent());
-    }
+    // Build frustum for culling (also prunes the visibility walk)
+    Frustum frustum = buildCameraFrustum(m_camera, m_swapChain->getExtent());
 
     // Acquire swapchain image
     uint32_t imageIndex;
+    auto acquireStart = std::chrono::steady_clock::now();
     VkResult result = vkAcquireNextImageKHR(
         m_context->getDevice(),
         m_swapChain->getSwapChain(),
@@ -408,6 +780,8 @@ void Renderer::renderFrame()
         VK_NULL_HANDLE,
         &imageIndex
     );
+    m_frameTiming.addWaitTime(std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - acquireStart).count());
     if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR) {
         recreateSwapChain();
         return;
@@ -428,6 +802,13 @@ void Renderer::renderFrame()
         throw std::runtime_error("Failed to begin recording command buffer!");
     }
 
+    if (m_timestampPool)
+    {
+        uint32_t firstQuery = uint32_t(m_currentFrame) * 2;
+        vkCmdResetQueryPool(cmdBuf, m_timestampPool, firstQuery, 2);
+        vkCmdWriteTimestamp(cmdBuf, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, m_timestampPool, firstQuery);
+    }
+
     // Begin render pass
     VkClearValue clearVals[2];
     clearVals[0].color = { {0.1f, 0.2f, 0.3f, 1.f} };
@@ -445,7 +826,10 @@ void Renderer::renderFrame()
     vkCmdBeginRenderPass(cmdBuf, &rpBegin, VK_SUBPASS_CONTENTS_INLINE);
 
     // Choose pipeline
-    std::string pipelineName = (m_wireframeOn ? "voxel_wireframe" : "voxel_fill");
+    const bool pulled = usesPulledQuads();
+    std::string pipelineName = pulled
+        ? (m_wireframeOn ? "voxel_pull_wireframe" : "voxel_pull_fill")
+        : (m_wireframeOn ? "voxel_wireframe" : "voxel_fill");
     PipelineInfo pipelineInfo = m_pipelineMgr->getPipeline(pipelineName);
 
     vkCmdBindPipeline(cmdBuf, VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineInfo.pipeline);
@@ -460,115 +844,36 @@ void Renderer::renderFrame()
     float dt = (m_time ? m_time->getDeltaTime() : 0.f);
     float fps = (dt > 0.f ? 1.f / dt : 0.f);
 
-    addSample(m_fpsSamples, fps);
-    float avgFps = computeAverage(m_fpsSamples);
+    FrameTimingStats presentStats = m_frameTiming.getStats(FrameTiming::PRESENT_INTERVAL);
+    float medianFps = (presentStats.p50Ms > 0.0 ? float(1000.0 / presentStats.p50Ms) : 0.f);
 
     float cpuUsage = g_cpuProfiler.GetCpuUsage();
     addSample(m_cpuSamples, cpuUsage);
     float avgCpu = computeAverage(m_cpuSamples);
 
-    // Draw chunks
-    if (m_voxelWorld)
-    {
-        const auto& allChunks = m_voxelWorld->getChunkManager().getAllChunks();
-        for (auto& kv : allChunks)
-        {
-            Chunk* chunk = kv.second.get();
-            if (!chunk) continue;
-
-            // compute distance from camera
-            float chunkCenterX = (chunk->worldX() + 0.5f) * float(Chunk::SIZE_X);
-            float chunkCenterY = (chunk->worldY() + 0.5f) * float(Chunk::SIZE_Y);
-            float chunkCenterZ = (chunk->worldZ() + 0.5f) * float(Chunk::SIZE_Z);
-
-            glm::vec3 diff = (m_camera.position
-                - glm::vec3(chunkCenterX, chunkCenterY, chunkCenterZ));
-            float dist = glm::length(diff);
-
-            int lodLevel = computeLODLevel(dist);
-
-            // Access LOD data
-            const auto& lodData = chunk->getLODData(lodLevel);
-            if (!lodData.valid
-                || lodData.vertexBuffer == VK_NULL_HANDLE
-                || lodData.indexBuffer == VK_NULL_HANDLE
-                || lodData.indexCount == 0)
-            {
-                // fallback to LOD0 if possible
-                const auto& fallbackLOD = chunk->getLODData(0);
-                if (!fallbackLOD.valid
-                    || fallbackLOD.vertexBuffer == VK_NULL_HANDLE
-                    || fallbackLOD.indexBuffer == VK_NULL_HANDLE
-                    || fallbackLOD.indexCount == 0)
-                {
-                    // skip
-                    continue;
-                }
-                else
-                {
-                    // use fallback
-                    VkDeviceSize offsets[] = { 0 };
-                    vkCmdBindVertexBuffers(cmdBuf, 0, 1, &fallbackLOD.vertexBuffer, offsets);
-                    vkCmdBindIndexBuffer(cmdBuf, fallbackLOD.indexBuffer, 0, VK_INDEX_TYPE_UINT32);
-                    vkCmdDrawIndexed(cmdBuf, fallbackLOD.indexCount, 1, 0, 0, 0);
-
-                    totalVertices += fallbackLOD.vertexCount;
-                    drawCallCount++;
-                }
-            }
-            else
-            {
-                // LOD data is valid
-                // Optional frustum cull
-                if (m_enableFrustumCulling)
-                {
-                    glm::vec3 minB, maxB;
-                    chunk->getBoundingBox(minB, maxB);
-                    if (!frustum.intersectsAABB(minB, maxB))
-                    {
-                        continue;
-                    }
-                }
-
-                // Bind & draw
-                VkDeviceSize offsets[] = { 0 };
-                vkCmdBindVertexBuffers(cmdBuf, 0, 1, &lodData.vertexBuffer, offsets);
-                vkCmdBindIndexBuffer(cmdBuf, lodData.indexBuffer, 0, VK_INDEX_TYPE_UINT32);
-                vkCmdDrawIndexed(cmdBuf, lodData.indexCount, 1, 0, 0, 0);
-
-                totalVertices += lodData.vertexCount;
-                drawCallCount++;
-            }
+    // Draw chunks: opaque first, then the translucent ranges blended on
+    // top (wireframe mode draws both with the wireframe pipeline)
+    collectVisibleChunks(frustum);
+    m_trianglesSkipped = 0;
+    m_meshletsDrawn = 0;
+    m_meshletsCulled = 0;
+    recordChunkDraws(cmdBuf, false, pipelineInfo.pipelineLayout, frustum, totalVertices, drawCallCount);
 
-            // Now draw seam geometry for each face (if valid).
-            // We'll do it unconditionally or you might check "if neighbor LOD != lodLevel".
-            for (int faceDir = 0; faceDir < 6; faceDir++)
-            {
-                const auto& seamData = chunk->getSeamData(static_cast<Chunk::SeamDirection>(faceDir));
-                if (!seamData.valid
-                    || seamData.seamVertexBuffer == VK_NULL_HANDLE
-                    || seamData.seamIndexBuffer == VK_NULL_HANDLE
-                    || seamData.indexCount == 0)
-                {
-                    continue;
-                }
-
-                // Optionally also frustum-cull the seam 
-                // (though youd need a bounding shape for it).
-                // For now, well just draw it.
-
-                VkDeviceSize offsets2[] = { 0 };
-                vkCmdBindVertexBuffers(cmdBuf, 0, 1, &seamData.seamVertexBuffer, offsets2);
-                vkCmdBindIndexBuffer(cmdBuf, seamData.seamIndexBuffer, 0, VK_INDEX_TYPE_UINT32);
-                vkCmdDrawIndexed(cmdBuf, seamData.indexCount, 1, 0, 0, 0);
-
-                totalVertices += seamData.vertexCount;
-                drawCallCount++;
-            }
-        }
+    if (!m_wireframeOn)
+    {
+        PipelineInfo translucentInfo = m_pipelineMgr->getPipeline(pulled ? "voxel_pull_translucent" : "voxel_translucent");
+        vkCmdBindPipeline(cmdBuf, VK_PIPELINE_BIND_POINT_GRAPHICS, translucentInfo.pipeline);
+        vkCmdBindDescriptorSets(cmdBuf,
+            VK_PIPELINE_BIND_POINT_GRAPHICS,
+            translucentInfo.pipelineLayout,
+            0, 1, &m_mvpDescriptorSet,
+            0, nullptr);
+        pipelineInfo = translucentInfo;
     }
+    recordChunkDraws(cmdBuf, true, pipelineInfo.pipelineLayout, frustum, totalVertices, drawCallCount);
 
-    // ImGui overlay
+    // ImGui overlay (spans several blocks, so no scoped zone)
+    Profiler::beginZone("ImGui");
     ImGui_ImplVulkan_NewFrame();
     ImGui_ImplGlfw_NewFrame();
     ImGui::NewFrame();
@@ -576,15 +881,35 @@ void Renderer::renderFrame()
     ImGui::Begin("Debug");
     ImGui::Text("Wireframe: %s", m_wireframeOn ? "ON" : "OFF");
     ImGui::Checkbox("Frustum Culling", &m_enableFrustumCulling);
+    ImGui::SliderFloat("View Distance", &m_viewDistance, 64.f, 1000.f, "%.0f");
+    {
+        // Runtime log filter (LOG_COMPILE_LEVEL still strips the rest at build time)
+        static const char* s_logLevels[] = { "Trace", "Debug", "Info", "Warn", "Error", "Off" };
+        int logLevel = (int)Logger::getLevel();
+        if (ImGui::Combo("Log Level", &logLevel, s_logLevels, IM_ARRAYSIZE(s_logLevels))) {
+            Logger::setLevel((LogLevel)logLevel);
+        }
+    }
     ImGui::Separator();
     ImGui::Text("Delta Time:  %.3f s", dt);
     ImGui::Text("FPS (Instant):  %.2f", fps);
-    ImGui::Text("FPS (Average):  %.2f", avgFps);
+    ImGui::Text("FPS (Median):   %.2f", medianFps);
     ImGui::Text("CPU Usage (Instant):  %.1f%%", cpuUsage);
     ImGui::Text("CPU Usage (Average):  %.1f%%", avgCpu);
+    drawFrameTimingPanel();
     ImGui::Separator();
     ImGui::Text("Vertex Count:  %u", totalVertices);
     ImGui::Text("Draw Calls:    %u", drawCallCount);
+    ImGui::Checkbox("Cave Culling", &m_enableCaveCulling);
+    ImGui::Checkbox("Facing Culling", &m_enableFacingCulling);
+    ImGui::Checkbox("Meshlet Culling", &m_enableMeshletCulling);
+    ImGui::Text("Chunks Drawn:      %zu", m_visibleChunks.size());
+    ImGui::Text("Superchunks Drawn: %zu (%u chunks)", m_visibleSuperChunks.size(), m_chunksInSuperChunks);
+    ImGui::Text("Culled (Frustum):  %u (%u / %u tree nodes)", m_chunksCulledFrustum,
+        m_quadtreeNodesCulled, m_quadtreeNodesVisited);
+    ImGui::Text("Culled (Cave):     %u", m_chunksCulledVisibility);
+    ImGui::Text("Meshlets Drawn:    %u (%u culled)", m_meshletsDrawn, m_meshletsCulled);
+    ImGui::Text("Tris Skipped In Meshes: %u", m_trianglesSkipped);
 
     if (m_voxelWorld) {
         auto& chunkMgr = m_voxelWorld->getChunkManager();
@@ -592,20 +917,163 @@ void Renderer::renderFrame()
         auto usage = chunkMgr.getTotalVoxelUsage();
         ImGui::Text("Active Voxels: %zu", usage.first);
         ImGui::Text("Empty Voxels:  %zu", usage.second);
+        if (ImGui::TreeNode("LOD"))
+        {
+            LODPolicy& policy = m_voxelWorld->getLODPolicy();
+            float maxPx = policy.getMaxPixelError();
+            if (ImGui::SliderFloat("Max Pixel Error", &maxPx, 1.f, 64.f, "%.1f px")) {
+                policy.setMaxPixelError(maxPx);
+            }
+            float hyst = policy.getHysteresis();
+            if (ImGui::SliderFloat("Hysteresis", &hyst, 0.f, 0.5f, "%.2f")) {
+                policy.setHysteresis(hyst);
+            }
+            for (int L = 1; L < LODPolicy::LOD_COUNT; L++) {
+                ImGui::Text("LOD%d from %.1f m", L, policy.getSwitchDistance(L));
+            }
+            const char* reductions[] = { "Majority", "Most Solid", "Surface" };
+            int reduction = (int)m_voxelWorld->getMipReduction();
+            if (ImGui::Combo("Mip Reduction", &reduction, reductions, 3)) {
+                m_voxelWorld->setMipReduction((MipReduction)reduction);
+            }
+            ImGui::Text("Mesh Builds: %d (avg %.3f ms)", VoxelWorld::getMeshCount(),
+                VoxelWorld::getAvgMeshTime() * 1000.0);
+            const MeshBufferPool& meshBuffers = m_voxelWorld->getMeshBuffers();
+            ImGui::Text("Mesh Buffers: %zu pooled, %llu reused, %llu new", meshBuffers.getPooledCount(),
+                (unsigned long long)meshBuffers.getReuseCount(), (unsigned long long)meshBuffers.getMissCount());
+            const MeshCache& meshCache = m_voxelWorld->getMeshCache();
+            const uint64_t cacheLookups = meshCache.getLookupCount();
+            const uint64_t cacheHits = meshCache.getHitCount();
+            ImGui::Text("Mesh Cache: %llu/%llu hits (%.1f%%), %zu meshes, %.2f MB",
+                (unsigned long long)cacheHits, (unsigned long long)cacheLookups,
+                cacheLookups ? 100.0 * cacheHits / cacheLookups : 0.0,
+                meshCache.getEntryCount(), meshCache.getBytes() / (1024.0 * 1024.0));
+            if (usesPulledQuads())
+            {
+                const uint64_t uploads = m_meshSink->getPackedUploadCount();
+                const uint64_t shared = m_meshSink->getSharedUploadCount();
+                ImGui::Text("Shared Quad Buffers: %llu/%llu uploads (%.1f%%), %.2f MB saved",
+                    (unsigned long long)shared, (unsigned long long)uploads,
+                    uploads ? 100.0 * shared / uploads : 0.0,
+                    m_meshSink->getSharedBytes() / (1024.0 * 1024.0));
+            }
+            ImGui::Text("LOD Changes (last update): %d", m_voxelWorld->getLODChangeCount());
+            const LODBalancer& balancer = m_voxelWorld->getLODBalancer();
+            ImGui::Text("2:1 Balance: %.3f ms, %d reassigned", balancer.getLastTimeMs(), balancer.getReassignCount());
+            ImGui::Text("Seam Jobs (last update): %d", m_voxelWorld->getSeamBuildCount());
+            ImGui::Text("Seam Memory: %.2f MB", m_voxelWorld->getSeamResidentBytes() / (1024.0 * 1024.0));
+            ImGui::TreePop();
+        }
+        if (ImGui::TreeNode("Superchunks"))
+        {
+            SuperChunkManager& superChunks = m_voxelWorld->getSuperChunks();
+            bool enabled = superChunks.isEnabled();
+            if (ImGui::Checkbox("Enabled", &enabled)) {
+                superChunks.setEnabled(enabled);
+            }
+            int groupChoice = (superChunks.getGroupSize() == 8) ? 1 : 0;
+            const char* groupSizes[] = { "4x4", "8x8" };
+            if (ImGui::Combo("Group", &groupChoice, groupSizes, 2)) {
+                superChunks.setGroupSize(groupChoice == 1 ? 8 : 4);
+            }
+            ImGui::Text("Active: %d  Loaded: %zu  %.2f MB", superChunks.getActiveCount(),
+                superChunks.getAll().size(),
+                m_voxelWorld->getMeshResidency().getSuperChunkBytes() / (1024.0 * 1024.0));
+            ImGui::TreePop();
+        }
+        if (ImGui::TreeNode("Mesh Residency"))
+        {
+            MeshResidency& residency = m_voxelWorld->getMeshResidency();
+            int budgetMB = (int)(residency.getBudgetBytes() / (1024 * 1024));
+            if (ImGui::SliderInt("Budget (MB, 0 = off)", &budgetMB, 0, 2048)) {
+                residency.setBudgetBytes((size_t)budgetMB * 1024 * 1024);
+            }
+            for (int L = 0; L < MeshResidency::LOD_COUNT; L++) {
+                ImGui::Text("LOD%d: %u meshes, %.2f MB", L, residency.getResidentMeshes(L),
+                    residency.getResidentBytes(L) / (1024.0 * 1024.0));
+            }
+            ImGui::Text("Superchunks: %u meshes, %.2f MB", residency.getSuperChunkMeshes(),
+                residency.getSuperChunkBytes() / (1024.0 * 1024.0));
+            ImGui::Text("Total: %.2f MB%s", residency.getTotalResidentBytes() / (1024.0 * 1024.0),
+                residency.isOverBudget() ? " (over budget)" : "");
+            ImGui::Text("Evictions: %llu", (unsigned long long)residency.getEvictionCount());
+            ImGui::TreePop();
+        }
+        if (ImGui::TreeNode("Voxels By Type"))
+        {
+            const VoxelStats& stats = chunkMgr.getVoxelStats();
+            const VoxelTypeRegistry& registry = VoxelTypeRegistry::get();
+            for (int id = 0; id < registry.getVoxelCount() && id < Chunk::MAX_VOXEL_TYPES; id++) {
+                ImGui::Text("%-8s %lld", registry.getVoxel(id).name.c_str(), (long long)stats.getTypeCount(id));
+            }
+            ImGui::TreePop();
+        }
+
+        // Block picking straight out of the camera
+        ImGui::Separator();
+        RaycastHit pick = m_voxelWorld->raycast(m_camera.position, m_camera.getForward(), 64.f);
+        if (pick.hit) {
+            const VoxelType& vt = VoxelTypeRegistry::get().getVoxel(pick.blockID);
+            ImGui::Text("Looking At: %s (%d, %d, %d)", vt.name.c_str(),
+                pick.voxel.x, pick.voxel.y, pick.voxel.z);
+            ImGui::Text("  Face: (%d, %d, %d)  Dist: %.2f",
+                pick.normal.x, pick.normal.y, pick.normal.z, pick.distance);
+            if (ImGui::Button("Dig")) {
+                m_voxelWorld->setVoxel(pick.voxel.x, pick.voxel.y, pick.voxel.z, 0);
+            }
+            ImGui::SameLine();
+            if (ImGui::Button("Place")) {
+                glm::ivec3 p = pick.voxel + pick.normal;
+                m_voxelWorld->setVoxel(p.x, p.y, p.z, pick.blockID);
+            }
+            ImGui::SameLine();
+            if (ImGui::Button("Place Water")) {
+                glm::ivec3 p = pick.voxel + pick.normal;
+                m_voxelWorld->setVoxel(p.x, p.y, p.z, BuiltinVoxels::WATER);
+            }
+        }
+        else {
+            ImGui::Text("Looking At: -");
+        }
+        ImGui::Text("Slice Patches: %llu  Full Rebuilds: %llu",
+            (unsigned long long)m_voxelWorld->getSlicePatchCount(),
+            (unsigned long long)m_voxelWorld->getSlicePatchFallbacks());
+
+        if (ImGui::Button("Raycast Benchmark (100k rays)")) {
+            m_raycastBench = benchmarkRaycasts(chunkMgr, m_camera.position, 100000, 128.f);
+            m_hasRaycastBench = true;
+        }
+        if (m_hasRaycastBench) {
+            ImGui::Text("Rays/sec (single): %.0f", m_raycastBench.singleRaysPerSec);
+            ImGui::Text("Rays/sec (batch):  %.0f", m_raycastBench.batchRaysPerSec);
+            ImGui::Text("Hits: %d / %d", m_raycastBench.hitCount, m_raycastBench.rayCount);
+            ImGui::Text("Voxel Steps: %llu  Chunk Skips: %llu",
+                (unsigned long long)m_raycastBench.stats.voxelSteps,
+                (unsigned long long)m_raycastBench.stats.chunkSkips);
+        }
     }
     ImGui::End();
 
+    drawProfilerWindow();
+
     ImGui::Render();
     ImGui_ImplVulkan_RenderDrawData(ImGui::GetDrawData(), cmdBuf);
+    Profiler::endZone();
 
     vkCmdEndRenderPass(cmdBuf);
 
+    if (m_timestampPool) {
+        vkCmdWriteTimestamp(cmdBuf, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+            m_timestampPool, uint32_t(m_currentFrame) * 2 + 1);
+    }
+
     if (vkEndCommandBuffer(cmdBuf) != VK_SUCCESS)
     {
         throw std::runtime_error("Failed to record command buffer!");
     }
 
     // Submit
+    PROFILE_ZONE("Submit & Present");
     VkSemaphore waitSemaphores[] = { m_frames[m_currentFrame].imageAvailableSemaphore };
     VkPipelineStageFlags waitStages[] = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
     VkSemaphore signalSemaphores[] = { m_frames[m_currentFrame].renderFinishedSemaphore };
@@ -625,6 +1093,9 @@ void Renderer::renderFrame()
     {
         throw std::runtime_error("Failed to submit draw command buffer!");
     }
+    if (m_timestampPool) {
+        m_frames[m_currentFrame].timedFrame = m_frameTiming.getFrameIndex();
+    }
 
     // Present
     VkPresentInfoKHR presentInfo{};
@@ -636,7 +1107,12 @@ void Renderer::renderFrame()
     presentInfo.pSwapchains = swapchains;
     presentInfo.pImageIndices = &imageIndex;
 
+    auto presentStart = std::chrono::steady_clock::now();
     result = vkQueuePresentKHR(m_context->getPresentQueue(), &presentInfo);
+    m_frameTiming.addWaitTime(std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - presentStart).count());
+    m_frameTiming.markPresent();
+
     if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR)
     {
         recreateSwapChain();
@@ -678,6 +1154,13 @@ void Renderer::recreateSwapChain()
     m_mvpLayout = m_pipelineMgr->createMVPDescriptorSetLayout();
     m_pipelineMgr->createVoxelPipelineFill("voxel_fill", renderPass, extent, m_mvpLayout);
     m_pipelineMgr->createVoxelPipelineWireframe("voxel_wireframe", renderPass, extent, m_mvpLayout);
+    m_pipelineMgr->createVoxelPipelineTranslucent("voxel_translucent", renderPass, extent, m_mvpLayout);
+    createPulledPipelines();
+
+    // LOD switch distances depend on the viewport height
+    if (m_voxelWorld) {
+        m_voxelWorld->getLODPolicy().setProjection(glm::radians(45.f), float(extent.height));
+    }
 
     // Recreate the MVP uniform + descriptor
     if (m_mvpBuffer) {
@@ -747,6 +1230,231 @@ uint32_t Renderer::findMemoryType(uint32_t filter, VkMemoryPropertyFlags props)
     throw std::runtime_error("Failed to find suitable memory type!");
 }
 
+// ------------------------------------------------
+// drawProfilerWindow
+//  Zone tree from Profiler + per-thread CPU usage.
+// ------------------------------------------------
+void Renderer::drawProfilerWindow()
+{
+    if (!ImGui::Begin("Profiler")) {
+        ImGui::End();
+        return;
+    }
+
+    // Re-aggregating every frame makes the numbers unreadable; twice a second is plenty
+    m_profilerRefreshTimer -= (m_time ? m_time->getDeltaTime() : 0.f);
+    if (m_profilerRefreshTimer <= 0.f) {
+        Profiler::collectStats(m_profilerRows);
+        m_profilerRefreshTimer = 0.5f;
+    }
+
+    if (ImGui::Button("Reset Stats")) {
+        Profiler::resetStats();
+        m_profilerRefreshTimer = 0.f;
+    }
+    ImGui::SameLine();
+    if (ImGui::Button("Dump Chrome Trace")) {
+        size_t eventCount = 0;
+        if (Profiler::dumpChromeTrace("profile_trace.json", &eventCount)) {
+            m_profilerStatus = "Wrote profile_trace.json (" + std::to_string(eventCount) + " zones)";
+        }
+        else {
+            m_profilerStatus = "Failed to write profile_trace.json";
+        }
+        LOG_INFO("{}", m_profilerStatus);
+    }
+    if (!m_profilerStatus.empty()) {
+        ImGui::TextUnformatted(m_profilerStatus.c_str());
+    }
+
+    ImGui::Text("Process CPU: %.1f%%", g_cpuProfiler.GetProcessCpuUsage());
+    if (ImGui::CollapsingHeader("Threads"))
+    {
+        for (const ThreadCpuUsage& t : g_cpuProfiler.GetThreadCpuUsage()) {
+            ImGui::Text("%-16s %6.1f%%", t.name.c_str(), t.percent);
+        }
+    }
+
+    ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg
+        | ImGuiTableFlags_Resizable | ImGuiTableFlags_ScrollY;
+    if (ImGui::BeginTable("zones", 6, flags))
+    {
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableSetupColumn("Zone", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableSetupColumn("Calls");
+        ImGui::TableSetupColumn("Total ms");
+        ImGui::TableSetupColumn("Self ms");
+        ImGui::TableSetupColumn("Avg ms");
+        ImGui::TableSetupColumn("Max ms");
+        ImGui::TableHeadersRow();
+
+        const std::string* lastThread = nullptr;
+        for (const ProfileStatRow& row : m_profilerRows)
+        {
+            // Thread heading whenever the group changes
+            if (!lastThread || *lastThread != row.threadName) {
+                ImGui::TableNextRow();
+                ImGui::TableSetColumnIndex(0);
+                ImGui::TextDisabled("[%s]", row.threadName.c_str());
+                lastThread = &row.threadName;
+            }
+
+            ImGui::TableNextRow();
+            ImGui::TableSetColumnIndex(0);
+            ImGui::Indent(12.f * (row.depth + 1));
+            ImGui::TextUnformatted(row.zoneName);
+            ImGui::Unindent(12.f * (row.depth + 1));
+            ImGui::TableSetColumnIndex(1);
+            ImGui::Text("%llu", (unsigned long long)row.calls);
+            ImGui::TableSetColumnIndex(2);
+            ImGui::Text("%.2f", row.totalMs);
+            ImGui::TableSetColumnIndex(3);
+            ImGui::Text("%.2f", row.selfMs);
+            ImGui::TableSetColumnIndex(4);
+            ImGui::Text("%.3f", row.avgMs);
+            ImGui::TableSetColumnIndex(5);
+            ImGui::Text("%.3f", row.maxMs);
+        }
+        ImGui::EndTable();
+    }
+
+    ImGui::End();
+}
+
+// ------------------------------------------------
+// Frame timing
+// ------------------------------------------------
+void Renderer::createTimestampQueries()
+{
+    VkPhysicalDeviceProperties props;
+    vkGetPhysicalDeviceProperties(m_context->getPhysicalDevice(), &props);
+
+    uint32_t familyCount = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(m_context->getPhysicalDevice(), &familyCount, nullptr);
+    std::vector<VkQueueFamilyProperties> families(familyCount);
+    vkGetPhysicalDeviceQueueFamilyProperties(m_context->getPhysicalDevice(), &familyCount, families.data());
+
+    uint32_t validBits = families[m_context->getGraphicsQueueFamilyIndex()].timestampValidBits;
+    if (validBits == 0 || props.limits.timestampPeriod <= 0.f) {
+        LOG_WARN("GPU timestamps not supported on the graphics queue; GPU frame time disabled");
+        return;
+    }
+    m_timestampPeriodNs = props.limits.timestampPeriod;
+    m_timestampMask = (validBits >= 64) ? ~0ull : ((1ull << validBits) - 1);
+
+    VkQueryPoolCreateInfo poolInfo{};
+    poolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    poolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    poolInfo.queryCount = MAX_FRAMES_IN_FLIGHT * 2;
+
+    if (vkCreateQueryPool(m_context->getDevice(), &poolInfo, nullptr, &m_timestampPool) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create timestamp query pool!");
+    }
+}
+
+void Renderer::readGpuTimestamps(FrameData& frame, int frameSlot)
+{
+    if (!m_timestampPool || frame.timedFrame == 0) {
+        return;
+    }
+
+    // The slot's fence has signalled, so no WAIT flag is needed
+    uint64_t ticks[2] = { 0, 0 };
+    VkResult result = vkGetQueryPoolResults(m_context->getDevice(), m_timestampPool,
+        uint32_t(frameSlot) * 2, 2, sizeof(ticks), ticks, sizeof(uint64_t),
+        VK_QUERY_RESULT_64_BIT);
+
+    if (result == VK_SUCCESS)
+    {
+        uint64_t delta = (ticks[1] - ticks[0]) & m_timestampMask;
+        m_frameTiming.recordGpuFrame(frame.timedFrame, double(delta) * m_timestampPeriodNs / 1.0e6);
+    }
+    frame.timedFrame = 0;
+}
+
+void Renderer::drawFrameTimingPanel()
+{
+    if (!ImGui::CollapsingHeader("Frame Timing", ImGuiTreeNodeFlags_DefaultOpen)) {
+        return;
+    }
+
+    // Write the files as soon as a capture window closes
+    if (m_captureWasRunning && !m_frameTiming.isCapturing())
+    {
+        bool ok = m_frameTiming.exportCsv("frame_capture.csv")
+            && m_frameTiming.exportJson("frame_capture.json");
+        m_frameTimingStatus = ok ? "Wrote frame_capture.csv / .json" : "Failed to write frame capture";
+        LOG_INFO("{}", m_frameTimingStatus);
+    }
+    m_captureWasRunning = m_frameTiming.isCapturing();
+
+    m_frameTiming.getRecentCpuFrames(m_frameTimePlot);
+    ImGui::PlotLines("CPU ms", m_frameTimePlot.data(), (int)m_frameTimePlot.size(),
+        0, nullptr, 0.f, 50.f, ImVec2(0.f, 60.f));
+
+    ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg;
+    if (ImGui::BeginTable("frametiming", 7, flags))
+    {
+        ImGui::TableSetupColumn("ms", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableSetupColumn("p50");
+        ImGui::TableSetupColumn("p95");
+        ImGui::TableSetupColumn("p99");
+        ImGui::TableSetupColumn("Max");
+        ImGui::TableSetupColumn("Mean");
+        ImGui::TableSetupColumn("Spikes");
+        ImGui::TableHeadersRow();
+
+        static const char* s_labels[FrameTiming::CHANNEL_COUNT] = { "CPU Frame", "GPU Frame", "Present" };
+        for (int c = 0; c < FrameTiming::CHANNEL_COUNT; c++)
+        {
+            FrameTimingStats st = m_frameTiming.getStats((FrameTiming::Channel)c);
+            ImGui::TableNextRow();
+            ImGui::TableSetColumnIndex(0);
+            ImGui::TextUnformatted(s_labels[c]);
+            if (c == FrameTiming::GPU_FRAME && !m_timestampPool) {
+                ImGui::TableSetColumnIndex(1);
+                ImGui::TextDisabled("n/a");
+                continue;
+            }
+            ImGui::TableSetColumnIndex(1);
+            ImGui::Text("%.2f", st.p50Ms);
+            ImGui::TableSetColumnIndex(2);
+            ImGui::Text("%.2f", st.p95Ms);
+            ImGui::TableSetColumnIndex(3);
+            ImGui::Text("%.2f", st.p99Ms);
+            ImGui::TableSetColumnIndex(4);
+            ImGui::Text("%.2f", st.maxMs);
+            ImGui::TableSetColumnIndex(5);
+            ImGui::Text("%.2f", st.meanMs);
+            ImGui::TableSetColumnIndex(6);
+            ImGui::Text("%llu", (unsigned long long)st.spikes);
+        }
+        ImGui::EndTable();
+    }
+
+    float spikeFactor = m_frameTiming.getSpikeFactor();
+    if (ImGui::SliderFloat("Spike Factor", &spikeFactor, 1.25f, 5.f, "%.2fx median")) {
+        m_frameTiming.setSpikeFactor(spikeFactor);
+    }
+    if (ImGui::Button("Reset Timing")) {
+        m_frameTiming.reset();
+    }
+
+    ImGui::SliderFloat("Capture (s)", &m_captureSeconds, 1.f, 120.f, "%.0f");
+    ImGui::SameLine();
+    if (m_frameTiming.isCapturing()) {
+        ImGui::Text("Capturing %.1f / %.0f s", m_frameTiming.getCaptureElapsed(), m_frameTiming.getCaptureDuration());
+    }
+    else if (ImGui::Button("Start Capture")) {
+        m_frameTiming.startCapture(m_captureSeconds);
+        m_captureWasRunning = true;
+        m_frameTimingStatus.clear();
+    }
+    if (!m_frameTimingStatus.empty()) {
+        ImGui::TextUnformatted(m_frameTimingStatus.c_str());
+    }
+}
+
 void Renderer::addSample(std::deque<float>& buffer, float value)
 {
     if (buffer.size() >= ROLLING_AVG_SAMPLES)
@@ -8,6 +8,10 @@
 
 #include "Engine/Scene/Camera.h"
 #include "Engine/Voxels/VoxelWorld.h"
+#include "VisibilityCuller.h"
+#include "Frustum.h"
+#include "Engine/Utils/Profiler.h"
+#include "Engine/Utils/FrameTiming.h"
 
 class VulkanContext;
 class Window;
@@ -15,6 +19,8 @@ class ResourceManager;
 class PipelineManager;
 class RenderPassManager;
 class Time;
+class Frustum;
+class VulkanMeshSink;
 
 /**
  * A small struct for the MVP uniform buffer block.
@@ -36,6 +42,16 @@ struct FrameData
     VkSemaphore     imageAvailableSemaphore = VK_NULL_HANDLE;
     VkSemaphore     renderFinishedSemaphore = VK_NULL_HANDLE;
     VkFence         inFlightFence = VK_NULL_HANDLE;
+    uint64_t        timedFrame = 0; // FrameTiming index whose GPU timestamps are pending (0 = none)
+};
+
+/**
+ * One chunk that survived culling this frame, plus the LOD to draw.
+ */
+struct VisibleChunk
+{
+    const Chunk* chunk = nullptr;
+    int          lodLevel = 0;
 };
 
 /**
@@ -55,6 +71,11 @@ public:
     ~Renderer();
 
     void setTime(Time* time) { m_time = time; }
+    /**
+     * The sink the world's meshes come from. Its format decides how they
+     * are drawn; packed quads get the vertex-pulling pipelines.
+     */
+    void setMeshSink(VulkanMeshSink* meshSink);
     void setCamera(const Camera& cam);
 
     /**
@@ -67,11 +88,44 @@ public:
      */
     void renderFrame();
 
+    /**
+     * Frame-time telemetry. The application calls beginFrame() at the top of
+     * its loop; the renderer adds fence/present waits, GPU timestamps and the
+     * present mark.
+     */
+    FrameTiming& getFrameTiming() { return m_frameTiming; }
+
 private:
     // Creates MVP uniform buffer & descriptor set
     void createMVPUniformBuffer();
     void updateMVP();
     void recreateSwapChain();
+    // "voxel_pull_*" pipelines, if the mesh sink stores packed quads
+    void createPulledPipelines();
+    bool usesPulledQuads() const;
+
+    // Culling + LOD selection => m_visibleChunks
+    void collectVisibleChunks(const Frustum& frustum);
+    // Records draws for m_visibleChunks into the frame's command buffer:
+    // the opaque index ranges, or (translucent == true) the translucent ones,
+    // with the bound pipeline's layout
+    void recordChunkDraws(VkCommandBuffer cmdBuf, bool translucent, VkPipelineLayout pipelineLayout,
+        const Frustum& frustum, uint32_t& totalVertices, uint32_t& drawCallCount);
+    // One pass of one mesh: the index ranges left after meshlet / facing
+    // culling => m_drawFirsts / m_drawCounts, then the draws for them
+    void selectDrawRanges(uint32_t indexCount, uint32_t opaqueIndexCount, bool translucent,
+        const MeshFaceRanges& faceRanges, const std::vector<Meshlet>* meshlets, uint8_t faceMask,
+        const Frustum& frustum, uint32_t& skippedIndices);
+    uint32_t drawRanges(VkCommandBuffer cmdBuf, const GpuMesh* gpuMesh, VkBuffer quadIndexBuffer,
+        VkPipelineLayout pipelineLayout) const;
+    // ImGui "Profiler" window (zone stats, per-thread CPU, trace dump)
+    void drawProfilerWindow();
+    // "Frame Timing" section of the debug window (percentiles, spikes, capture)
+    void drawFrameTimingPanel();
+
+    // GPU frame timestamps: two per frame in flight
+    void createTimestampQueries();
+    void readGpuTimestamps(FrameData& frame, int frameSlot);
 
     // Creates a generic GPU buffer + memory
     void createBuffer(
@@ -97,6 +151,7 @@ private:
     Window* m_window = nullptr;
     VoxelWorld* m_voxelWorld = nullptr;
     Time* m_time = nullptr;
+    VulkanMeshSink* m_meshSink = nullptr; // mesh format, shared quad index buffer
 
     class SwapChain* m_swapChain = nullptr;
     ResourceManager* m_resourceMgr = nullptr;
@@ -117,11 +172,56 @@ private:
     bool m_wireframeOn = false;
     // Are we culling with a frustum?
     bool m_enableFrustumCulling = false;
-
-    // Rolling average samples (for FPS, CPU usage)
-    std::deque<float> m_fpsSamples;
+    // Are we culling chunks the camera can't see through caves/air?
+    bool m_enableCaveCulling = true;
+    // Are we skipping mesh ranges whose faces all point away from the camera?
+    bool m_enableFacingCulling = true;
+    // Are we culling meshlets against the frustum (and facing) inside meshes?
+    bool m_enableMeshletCulling = true;
+    // Chunks with no point this close to the camera are culled
+    float m_viewDistance = 1000.0f;
+
+    // Visibility graph walk + this frame's draw list
+    ChunkVisibilityCuller     m_visibilityCuller;
+    std::vector<Chunk*>       m_treeChunks;       // ChunkQuadtree::cull, this frame
+    AABBList                  m_candidateBounds;  // chunks crossing a frustum plane
+    std::vector<Chunk*>       m_candidateChunks;
+    std::vector<uint32_t>     m_candidateVisible; // m_candidateBounds indices
+    std::vector<VisibleChunk> m_visibleChunks;
+    std::vector<const SuperChunk*> m_visibleSuperChunks; // far field, drawn instead of their members
+    uint32_t                  m_chunksInSuperChunks = 0; // inside the frustum
+    uint32_t                  m_chunksCulledFrustum = 0; // or beyond m_viewDistance
+    uint32_t                  m_quadtreeNodesVisited = 0;
+    uint32_t                  m_quadtreeNodesCulled = 0;
+    uint32_t                  m_chunksCulledVisibility = 0;
+    uint32_t                  m_trianglesSkipped = 0; // by facing / meshlet culling, both passes, this frame
+    uint32_t                  m_meshletsDrawn = 0;
+    uint32_t                  m_meshletsCulled = 0;
+    std::vector<uint32_t>     m_drawFirsts; // selectDrawRanges => drawRanges
+    std::vector<uint32_t>     m_drawCounts;
+
+    // Rolling average samples (CPU usage)
     std::deque<float> m_cpuSamples;
 
+    // Frame timing histograms + GPU timestamp queries
+    FrameTiming        m_frameTiming;
+    VkQueryPool        m_timestampPool = VK_NULL_HANDLE;
+    double             m_timestampPeriodNs = 1.0;
+    uint64_t           m_timestampMask = ~0ull;
+    float              m_captureSeconds = 10.f;
+    bool               m_captureWasRunning = false;
+    std::string        m_frameTimingStatus;
+    std::vector<float> m_frameTimePlot;
+
+    // Last result of the ImGui raycast benchmark button
+    RaycastBenchmarkResult m_raycastBench;
+    bool                   m_hasRaycastBench = false;
+
+    // Profiler window state
+    std::vector<ProfileStatRow> m_profilerRows;
+    float                       m_profilerRefreshTimer = 0.f;
+    std::string                 m_profilerStatus;
+
     // The current camera
     Camera m_camera;
 
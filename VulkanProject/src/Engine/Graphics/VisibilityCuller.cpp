@@ -0,0 +1,129 @@
+#include "VisibilityCuller.h"
+#include "Frustum.h"
+#include "Engine/Voxels/Chunk.h"
+#include "Engine/Voxels/ChunkManager.h"
+#include "Engine/Voxels/ChunkVisibility.h"
+
+#include <cmath>
+#include <algorithm>
+
+// Step per face, same order as Chunk::SeamDirection (+X,-X,+Y,-Y,+Z,-Z)
+static const int s_faceOffsets[6][3] = {
+    {1,0,0}, {-1,0,0},
+    {0,1,0}, {0,-1,0},
+    {0,0,1}, {0,0,-1}
+};
+
+void ChunkVisibilityCuller::update(const ChunkManager& manager, const glm::vec3& cameraPos, const Frustum* frustum)
+{
+    m_visitedCount = 0;
+
+    const auto& allChunks = manager.getAllChunks();
+
+    int camX = (int)std::floor(cameraPos.x / (float)Chunk::SIZE_X);
+    int camY = (int)std::floor(cameraPos.y / (float)Chunk::SIZE_Y);
+    int camZ = (int)std::floor(cameraPos.z / (float)Chunk::SIZE_Z);
+
+    // 1) Grid bounds = loaded chunks + the camera's chunk
+    int minX = camX, minY = camY, minZ = camZ;
+    int maxX = camX, maxY = camY, maxZ = camZ;
+    for (const auto& kv : allChunks)
+    {
+        const ChunkCoord& c = kv.first;
+        minX = std::min(minX, c.x); maxX = std::max(maxX, c.x);
+        minY = std::min(minY, c.y); maxY = std::max(maxY, c.y);
+        minZ = std::min(minZ, c.z); maxZ = std::max(maxZ, c.z);
+    }
+
+    m_minX = minX; m_minY = minY; m_minZ = minZ;
+    m_sizeX = maxX - minX + 1;
+    m_sizeY = maxY - minY + 1;
+    m_sizeZ = maxZ - minZ + 1;
+
+    size_t cellCount = size_t(m_sizeX) * size_t(m_sizeY) * size_t(m_sizeZ);
+    m_grid.assign(cellCount, nullptr);
+    m_state.assign(cellCount, CELL_UNSEEN);
+    m_queue.clear();
+
+    for (const auto& kv : allChunks)
+    {
+        const ChunkCoord& c = kv.first;
+        m_grid[cellIndex(c.x - m_minX, c.y - m_minY, c.z - m_minZ)] = kv.second.get();
+    }
+
+    // 2) Breadth-first walk from the camera chunk
+    Node start;
+    start.x = camX - m_minX;
+    start.y = camY - m_minY;
+    start.z = camZ - m_minZ;
+    start.entryFace = -1;
+    start.dirMask = 0;
+    m_state[cellIndex(start.x, start.y, start.z)] = CELL_VISIBLE;
+    m_visitedCount++;
+    m_queue.push_back(start);
+
+    for (size_t head = 0; head < m_queue.size(); head++)
+    {
+        Node node = m_queue[head];
+        const Chunk* chunk = m_grid[cellIndex(node.x, node.y, node.z)];
+        uint64_t connectivity = chunk ? chunk->getFaceConnectivity() : ChunkVisibility::ALL_CONNECTED;
+
+        for (int face = 0; face < ChunkVisibility::FACE_COUNT; face++)
+        {
+            // Never walk back against a direction we already went
+            if (node.dirMask & (1u << ChunkVisibility::oppositeFace(face))) continue;
+
+            // Can we get from the entry face to this face through air?
+            if (node.entryFace >= 0
+                && !ChunkVisibility::facesConnected(connectivity, node.entryFace, face))
+            {
+                continue;
+            }
+
+            int nx = node.x + s_faceOffsets[face][0];
+            int ny = node.y + s_faceOffsets[face][1];
+            int nz = node.z + s_faceOffsets[face][2];
+            if (nx < 0 || ny < 0 || nz < 0 || nx >= m_sizeX || ny >= m_sizeY || nz >= m_sizeZ) {
+                continue;
+            }
+
+            int idx = cellIndex(nx, ny, nz);
+            if (m_state[idx] != CELL_UNSEEN) continue;
+
+            if (frustum)
+            {
+                glm::vec3 minB(
+                    float((nx + m_minX) * Chunk::SIZE_X),
+                    float((ny + m_minY) * Chunk::SIZE_Y),
+                    float((nz + m_minZ) * Chunk::SIZE_Z));
+                glm::vec3 maxB = minB + glm::vec3(Chunk::SIZE_X, Chunk::SIZE_Y, Chunk::SIZE_Z);
+                if (!frustum->intersectsAABB(minB, maxB)) {
+                    m_state[idx] = CELL_REJECTED;
+                    continue;
+                }
+            }
+
+            m_state[idx] = CELL_VISIBLE;
+            m_visitedCount++;
+
+            Node next;
+            next.x = nx;
+            next.y = ny;
+            next.z = nz;
+            next.entryFace = (int8_t)ChunkVisibility::oppositeFace(face);
+            next.dirMask = (uint8_t)(node.dirMask | (1u << face));
+            m_queue.push_back(next);
+        }
+    }
+}
+
+bool ChunkVisibilityCuller::isVisible(int cx, int cy, int cz) const
+{
+    int x = cx - m_minX;
+    int y = cy - m_minY;
+    int z = cz - m_minZ;
+    if (x < 0 || y < 0 || z < 0 || x >= m_sizeX || y >= m_sizeY || z >= m_sizeZ) {
+        return false;
+    }
+    return m_state[cellIndex(x, y, z)] == CELL_VISIBLE;
+}
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+class Chunk;
+class ChunkManager;
+class Frustum;
+
+///
+/// Visibility-graph ("cave") culling over the loaded chunk grid.
+///
+/// Starting at the camera's chunk, a breadth-first walk moves into a
+/// neighbor only if the current chunk connects the face we came in through
+/// to the face we leave through (Chunk::getFaceConnectivity), and never in
+/// the opposite direction of a step already taken. Chunks the walk never
+/// reaches are enclosed (underground, behind hills) and can be skipped.
+///
+/// Missing chunks inside the loaded bounds count as open air.
+///
+class ChunkVisibilityCuller
+{
+public:
+    /// Rebuilds the reachable set. 'frustum' is optional and prunes the walk.
+    void update(const ChunkManager& manager, const glm::vec3& cameraPos, const Frustum* frustum);
+
+    /// True if the last update() reached chunk (cx,cy,cz).
+    bool isVisible(int cx, int cy, int cz) const;
+
+    /// Number of grid cells (loaded or not) reached by the last walk.
+    int getVisitedCount() const { return m_visitedCount; }
+
+private:
+    struct Node
+    {
+        int     x, y, z;   // grid-local coordinates
+        int8_t  entryFace; // face we entered through, -1 for the start chunk
+        uint8_t dirMask;   // directions travelled so far
+    };
+
+    enum CellState : uint8_t
+    {
+        CELL_UNSEEN = 0,
+        CELL_VISIBLE = 1,
+        CELL_REJECTED = 2 // outside the frustum
+    };
+
+    int cellIndex(int x, int y, int z) const { return x + m_sizeX * (y + m_sizeY * z); }
+
+    int m_minX = 0, m_minY = 0, m_minZ = 0;
+    int m_sizeX = 0, m_sizeY = 0, m_sizeZ = 0;
+    int m_visitedCount = 0;
+
+    std::vector<const Chunk*> m_grid;   // chunk per cell (nullptr => not loaded)
+    std::vector<uint8_t>      m_state;  // CellState per cell
+    std::vector<Node>         m_queue;
+};
@@ -0,0 +1,621 @@
+#include "VulkanMeshSink.h"
+#include "VulkanContext.h"
+#include "Engine/Voxels/ChunkMesher.h"
+#include "Engine/Voxels/PackedQuad.h"
+#include "Engine/Utils/Profiler.h"
+
+#include <cstring>
+#include <stdexcept>
+
+namespace
+{
+    // Content key of a packed mesh (splitmix64 steps over the records)
+    uint64_t hashQuads(const std::vector<PackedQuad>& quads)
+    {
+        auto mix = [](uint64_t x) {
+            x += 0x9E3779B97F4A7C15ull;
+            x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+            x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+            return x ^ (x >> 31);
+        };
+        uint64_t h = mix((uint64_t)quads.size());
+        for (const PackedQuad& q : quads) {
+            h = mix(h ^ (((uint64_t)q.hi << 32) | q.lo));
+        }
+        return h;
+    }
+}
+
+// ------------------------------------------------
+// Constructor / Destructor
+// ------------------------------------------------
+VulkanMeshSink::VulkanMeshSink(VulkanContext* context, Format format)
+    : m_context(context)
+    , m_format(format)
+{
+    if (m_format == Format::SharedQuadIndices) {
+        createQuadIndexBuffer();
+    }
+    else if (m_format == Format::PackedQuads) {
+        createQuadSetLayout();
+    }
+}
+
+VulkanMeshSink::~VulkanMeshSink()
+{
+    VkDevice device = m_context->getDevice();
+    vkDeviceWaitIdle(device);
+
+    // A batch that was never submitted only needs its resources freed
+    if (m_isRecording)
+    {
+        vkEndCommandBuffer(m_recording.cmdBuf);
+        for (auto& s : m_recording.staging) {
+            vkDestroyBuffer(device, s.buffer, nullptr);
+            vkFreeMemory(device, s.memory, nullptr);
+        }
+        vkFreeCommandBuffers(device, m_context->getCommandPool(), 1, &m_recording.cmdBuf);
+        m_isRecording = false;
+    }
+
+    retireBatches(true);
+
+    for (auto& pd : m_pendingDestroys) {
+        releaseMesh(pd.mesh);
+    }
+    m_pendingDestroys.clear();
+
+    if (m_quadIndexBuffer != VK_NULL_HANDLE) vkDestroyBuffer(device, m_quadIndexBuffer, nullptr);
+    if (m_quadIndexMemory != VK_NULL_HANDLE) vkFreeMemory(device, m_quadIndexMemory, nullptr);
+
+    for (VkDescriptorPool pool : m_quadPools) {
+        vkDestroyDescriptorPool(device, pool, nullptr);
+    }
+    if (m_quadSetLayout != VK_NULL_HANDLE) vkDestroyDescriptorSetLayout(device, m_quadSetLayout, nullptr);
+}
+
+// ------------------------------------------------
+// uploadMesh
+//  Device-local VB/IB + one staging buffer holding both,
+//  copies recorded into this frame's batch. No IB with
+//  shared quad indices; packed quads replace the VB,
+//  or reuse a live buffer holding the same records.
+// ------------------------------------------------
+GpuMesh* VulkanMeshSink::uploadMesh(const std::vector<Vertex>& verts, const std::vector<uint32_t>& inds)
+{
+    const bool quadsOnly = (m_format != Format::Indexed);
+    if (verts.empty() || (inds.empty() && !quadsOnly)) {
+        return nullptr;
+    }
+
+    VulkanGpuMesh* mesh = new VulkanGpuMesh();
+    const void* vertexData = verts.data();
+    VkDeviceSize vbSize = sizeof(Vertex) * verts.size();
+    VkBufferUsageFlags vbUsage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+
+    std::vector<PackedQuad> quads;
+    if (m_format == Format::PackedQuads)
+    {
+        PackedQuads::meshOrigin(verts, mesh->origin);
+        if (!PackedQuads::packMesh(verts, mesh->origin, quads)) {
+            delete mesh;
+            throw std::runtime_error("Mesh doesn't fit the packed quad format!");
+        }
+        vertexData = quads.data();
+        vbSize = sizeof(PackedQuad) * quads.size();
+        vbUsage = VK_BUFFER_USAGE_STORAGE_BUFFER_BIT;
+    }
+
+    VkDevice device = m_context->getDevice();
+    VkDeviceSize ibSize = quadsOnly ? 0 : sizeof(uint32_t) * inds.size();
+
+    mesh->vertexCount = (uint32_t)verts.size();
+    mesh->indexCount = quadsOnly ? (uint32_t)(verts.size() / 4 * 6) : (uint32_t)inds.size();
+    mesh->byteSize = (size_t)(vbSize + ibSize);
+
+    // 1) Device-local buffers (packed quads: a new or a shared quad buffer)
+    if (m_format == Format::PackedQuads)
+    {
+        m_packedUploads++;
+        const uint64_t key = hashQuads(quads);
+        auto it = m_quadBuffers.find(key);
+        if (it != m_quadBuffers.end() && it->second->size == vbSize)
+        {
+            // Same records as a live buffer: nothing to copy
+            mesh->quads = it->second;
+            mesh->quads->refs++;
+            m_sharedUploads++;
+            m_sharedBytes += (size_t)vbSize;
+        }
+        else
+        {
+            mesh->quads = new VulkanQuadBuffer();
+            mesh->quads->size = vbSize;
+            mesh->quads->key = key;
+            mesh->quads->refs = 1;
+            createBuffer(vbSize,
+                VK_BUFFER_USAGE_TRANSFER_DST_BIT | vbUsage,
+                VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                mesh->quads->buffer, mesh->quads->memory);
+            allocateQuadSet(mesh->quads);
+            if (it == m_quadBuffers.end())
+            {
+                m_quadBuffers[key] = mesh->quads;
+                mesh->quads->listed = true;
+            }
+        }
+        mesh->vertexBuffer = mesh->quads->buffer;
+        mesh->quadSet = mesh->quads->set;
+        if (mesh->quads->refs > 1) {
+            return mesh;
+        }
+    }
+    else
+    {
+        createBuffer(vbSize,
+            VK_BUFFER_USAGE_TRANSFER_DST_BIT | vbUsage,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            mesh->vertexBuffer, mesh->vertexMemory);
+    }
+
+    if (ibSize > 0) {
+        createBuffer(ibSize,
+            VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+            VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+            mesh->indexBuffer, mesh->indexMemory);
+    }
+
+    // 2) One staging buffer: vertices, then indices
+    StagingBuffer staging;
+    createBuffer(vbSize + ibSize,
+        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+        (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT),
+        staging.buffer, staging.memory);
+
+    {
+        void* dataPtr = nullptr;
+        vkMapMemory(device, staging.memory, 0, vbSize + ibSize, 0, &dataPtr);
+        std::memcpy(dataPtr, vertexData, (size_t)vbSize);
+        if (ibSize > 0) {
+            std::memcpy(static_cast<char*>(dataPtr) + vbSize, inds.data(), (size_t)ibSize);
+        }
+        vkUnmapMemory(device, staging.memory);
+    }
+
+    // 3) Record the copies; submitted in endFrame()
+    beginBatchIfNeeded();
+
+    VkBufferCopy vbCopy{};
+    vbCopy.srcOffset = 0;
+    vbCopy.size = vbSize;
+    vkCmdCopyBuffer(m_recording.cmdBuf, staging.buffer, mesh->vertexBuffer, 1, &vbCopy);
+
+    if (ibSize > 0)
+    {
+        VkBufferCopy ibCopy{};
+        ibCopy.srcOffset = vbSize;
+        ibCopy.size = ibSize;
+        vkCmdCopyBuffer(m_recording.cmdBuf, staging.buffer, mesh->indexBuffer, 1, &ibCopy);
+    }
+
+    m_recording.staging.push_back(staging);
+    return mesh;
+}
+
+// ------------------------------------------------
+// patchMesh
+//  All ranges share one staging buffer and one copy
+//  command into the mesh's vertex buffer. Packed quads
+//  are packed first, so a patch that doesn't fit the
+//  mesh's origin is refused before anything is recorded,
+//  and so is any patch of a buffer other meshes share.
+// ------------------------------------------------
+bool VulkanMeshSink::patchMesh(GpuMesh* mesh, const std::vector<MeshPatch>& patches)
+{
+    if (!mesh) return false;
+
+    VulkanGpuMesh* vkMesh = static_cast<VulkanGpuMesh*>(mesh);
+    if (vkMesh->quads && vkMesh->quads->refs > 1) {
+        return false;
+    }
+    const bool packed = (m_format == Format::PackedQuads);
+    std::vector<std::vector<PackedQuad>> packedPatches(packed ? patches.size() : 0);
+
+    VkDeviceSize totalSize = 0;
+    for (size_t i = 0; i < patches.size(); i++)
+    {
+        const MeshPatch& p = patches[i];
+        if ((size_t)p.firstVertex + p.verts.size() > mesh->vertexCount) {
+            return false;
+        }
+        if (packed)
+        {
+            if (p.firstVertex % 4 != 0 || !PackedQuads::packMesh(p.verts, vkMesh->origin, packedPatches[i])) {
+                return false;
+            }
+            totalSize += sizeof(PackedQuad) * packedPatches[i].size();
+        }
+        else {
+            totalSize += sizeof(Vertex) * p.verts.size();
+        }
+    }
+    if (totalSize == 0) return true;
+
+    // Its records no longer match the key
+    if (vkMesh->quads && vkMesh->quads->listed)
+    {
+        m_quadBuffers.erase(vkMesh->quads->key);
+        vkMesh->quads->listed = false;
+    }
+
+    VkDevice device = m_context->getDevice();
+
+    StagingBuffer staging;
+    createBuffer(totalSize,
+        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+        (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT),
+        staging.buffer, staging.memory);
+
+    std::vector<VkBufferCopy> regions;
+    regions.reserve(patches.size());
+    {
+        void* dataPtr = nullptr;
+        vkMapMemory(device, staging.memory, 0, totalSize, 0, &dataPtr);
+        VkDeviceSize offset = 0;
+        for (size_t i = 0; i < patches.size(); i++)
+        {
+            const MeshPatch& p = patches[i];
+            if (p.verts.empty()) continue;
+            VkDeviceSize size = packed ? sizeof(PackedQuad) * packedPatches[i].size() : sizeof(Vertex) * p.verts.size();
+            const void* src = packed ? (const void*)packedPatches[i].data() : (const void*)p.verts.data();
+            std::memcpy(static_cast<char*>(dataPtr) + offset, src, (size_t)size);
+
+            VkBufferCopy region{};
+            region.srcOffset = offset;
+            region.dstOffset = packed ? sizeof(PackedQuad) * (VkDeviceSize)(p.firstVertex / 4)
+                                      : sizeof(Vertex) * (VkDeviceSize)p.firstVertex;
+            region.size = size;
+            regions.push_back(region);
+            offset += size;
+        }
+        vkUnmapMemory(device, staging.memory);
+    }
+
+    beginBatchIfNeeded();
+
+    if (!m_recording.patchBarrier)
+    {
+        // Frames submitted earlier may still read these vertices, and an
+        // earlier batch may still be writing them
+        VkMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        vkCmdPipelineBarrier(m_recording.cmdBuf,
+            VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            0, 1, &barrier, 0, nullptr, 0, nullptr);
+        m_recording.patchBarrier = true;
+    }
+
+    vkCmdCopyBuffer(m_recording.cmdBuf, staging.buffer, vkMesh->vertexBuffer,
+        (uint32_t)regions.size(), regions.data());
+
+    m_recording.staging.push_back(staging);
+    return true;
+}
+
+// ------------------------------------------------
+// destroyMesh (deferred)
+// ------------------------------------------------
+void VulkanMeshSink::destroyMesh(GpuMesh* mesh)
+{
+    if (!mesh) return;
+
+    PendingDestroy pd;
+    pd.mesh = static_cast<VulkanGpuMesh*>(mesh);
+    pd.frame = m_frame;
+    // The batch being recorded (or the last one submitted) may still write to it
+    pd.batchSerial = m_isRecording ? m_nextSerial : m_nextSerial - 1;
+    m_pendingDestroys.push_back(pd);
+}
+
+// ------------------------------------------------
+// endFrame
+//  Submit this frame's copies, retire finished batches,
+//  release meshes nobody can be drawing anymore.
+// ------------------------------------------------
+void VulkanMeshSink::endFrame()
+{
+    PROFILE_ZONE("Mesh Sink Flush");
+
+    if (m_isRecording)
+    {
+        // Make the copies visible to vertex input (or, for packed quads, the
+        // vertex shader) of later submissions on this queue
+        VkMemoryBarrier barrier{};
+        barrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+        barrier.dstAccessMask = VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT | VK_ACCESS_INDEX_READ_BIT | VK_ACCESS_SHADER_READ_BIT;
+        vkCmdPipelineBarrier(m_recording.cmdBuf,
+            VK_PIPELINE_STAGE_TRANSFER_BIT,
+            VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT,
+            0, 1, &barrier, 0, nullptr, 0, nullptr);
+
+        vkEndCommandBuffer(m_recording.cmdBuf);
+
+        VkFenceCreateInfo fenceInfo{};
+        fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        if (vkCreateFence(m_context->getDevice(), &fenceInfo, nullptr, &m_recording.fence) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create upload fence!");
+        }
+
+        VkSubmitInfo submitInfo{};
+        submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submitInfo.commandBufferCount = 1;
+        submitInfo.pCommandBuffers = &m_recording.cmdBuf;
+
+        if (vkQueueSubmit(m_context->getGraphicsQueue(), 1, &submitInfo, m_recording.fence) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to submit mesh upload batch!");
+        }
+
+        m_inFlight.push_back(m_recording);
+        m_recording = UploadBatch();
+        m_isRecording = false;
+        m_nextSerial++;
+    }
+
+    retireBatches(false);
+
+    m_frame++;
+    while (!m_pendingDestroys.empty())
+    {
+        const PendingDestroy& pd = m_pendingDestroys.front();
+        if (pd.frame + DESTROY_DELAY_FRAMES > m_frame || pd.batchSerial > m_completedSerial) {
+            break;
+        }
+        releaseMesh(pd.mesh);
+        m_pendingDestroys.pop_front();
+    }
+}
+
+// ------------------------------------------------
+// Helpers
+// ------------------------------------------------
+void VulkanMeshSink::beginBatchIfNeeded()
+{
+    if (m_isRecording) return;
+
+    VkCommandBufferAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+    allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    allocInfo.commandPool = m_context->getCommandPool();
+    allocInfo.commandBufferCount = 1;
+
+    if (vkAllocateCommandBuffers(m_context->getDevice(), &allocInfo, &m_recording.cmdBuf) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to allocate upload command buffer!");
+    }
+
+    VkCommandBufferBeginInfo beginInfo{};
+    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    vkBeginCommandBuffer(m_recording.cmdBuf, &beginInfo);
+
+    m_recording.serial = m_nextSerial;
+    m_isRecording = true;
+}
+
+// The shared quad pattern goes out with the first batch, like any mesh
+void VulkanMeshSink::createQuadIndexBuffer()
+{
+    std::vector<uint16_t> pattern;
+    ChunkMesher::buildQuadIndexPattern(ChunkMesher::SHARED_INDEX_QUADS, pattern);
+    VkDeviceSize size = sizeof(uint16_t) * pattern.size();
+
+    createBuffer(size,
+        VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
+        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+        m_quadIndexBuffer, m_quadIndexMemory);
+
+    StagingBuffer staging;
+    createBuffer(size,
+        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+        (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT),
+        staging.buffer, staging.memory);
+    {
+        void* dataPtr = nullptr;
+        vkMapMemory(m_context->getDevice(), staging.memory, 0, size, 0, &dataPtr);
+        std::memcpy(dataPtr, pattern.data(), (size_t)size);
+        vkUnmapMemory(m_context->getDevice(), staging.memory);
+    }
+
+    beginBatchIfNeeded();
+    VkBufferCopy copy{};
+    copy.size = size;
+    vkCmdCopyBuffer(m_recording.cmdBuf, staging.buffer, m_quadIndexBuffer, 1, &copy);
+    m_recording.staging.push_back(staging);
+}
+
+void VulkanMeshSink::createQuadSetLayout()
+{
+    VkDescriptorSetLayoutBinding binding{};
+    binding.binding = 0;
+    binding.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    binding.descriptorCount = 1;
+    binding.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+
+    VkDescriptorSetLayoutCreateInfo layoutInfo{};
+    layoutInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    layoutInfo.bindingCount = 1;
+    layoutInfo.pBindings = &binding;
+
+    if (vkCreateDescriptorSetLayout(m_context->getDevice(), &layoutInfo, nullptr, &m_quadSetLayout) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create descriptor set layout for packed quads!");
+    }
+}
+
+// One set per quad buffer; a new pool when the last is full
+void VulkanMeshSink::allocateQuadSet(VulkanQuadBuffer* quads)
+{
+    VkDevice device = m_context->getDevice();
+
+    VkDescriptorSetAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    allocInfo.descriptorSetCount = 1;
+    allocInfo.pSetLayouts = &m_quadSetLayout;
+
+    VkResult result = VK_ERROR_OUT_OF_POOL_MEMORY;
+    if (!m_quadPools.empty())
+    {
+        allocInfo.descriptorPool = m_quadPools.back();
+        result = vkAllocateDescriptorSets(device, &allocInfo, &quads->set);
+    }
+    if (result != VK_SUCCESS)
+    {
+        VkDescriptorPoolSize poolSize{};
+        poolSize.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+        poolSize.descriptorCount = QUAD_SETS_PER_POOL;
+
+        VkDescriptorPoolCreateInfo poolInfo{};
+        poolInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+        poolInfo.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+        poolInfo.maxSets = QUAD_SETS_PER_POOL;
+        poolInfo.poolSizeCount = 1;
+        poolInfo.pPoolSizes = &poolSize;
+
+        VkDescriptorPool pool;
+        if (vkCreateDescriptorPool(device, &poolInfo, nullptr, &pool) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to create descriptor pool for packed quads!");
+        }
+        m_quadPools.push_back(pool);
+
+        allocInfo.descriptorPool = pool;
+        if (vkAllocateDescriptorSets(device, &allocInfo, &quads->set) != VK_SUCCESS) {
+            throw std::runtime_error("Failed to allocate descriptor set for packed quads!");
+        }
+    }
+    quads->pool = allocInfo.descriptorPool;
+
+    VkDescriptorBufferInfo bufferInfo{};
+    bufferInfo.buffer = quads->buffer;
+    bufferInfo.offset = 0;
+    bufferInfo.range = quads->size;
+
+    VkWriteDescriptorSet write{};
+    write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    write.dstSet = quads->set;
+    write.dstBinding = 0;
+    write.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER;
+    write.descriptorCount = 1;
+    write.pBufferInfo = &bufferInfo;
+    vkUpdateDescriptorSets(device, 1, &write, 0, nullptr);
+}
+
+void VulkanMeshSink::retireBatches(bool waitAll)
+{
+    VkDevice device = m_context->getDevice();
+
+    while (!m_inFlight.empty())
+    {
+        UploadBatch& batch = m_inFlight.front();
+        if (waitAll) {
+            vkWaitForFences(device, 1, &batch.fence, VK_TRUE, UINT64_MAX);
+        }
+        else if (vkGetFenceStatus(device, batch.fence) != VK_SUCCESS) {
+            break; // batches complete in order
+        }
+
+        for (auto& s : batch.staging) {
+            vkDestroyBuffer(device, s.buffer, nullptr);
+            vkFreeMemory(device, s.memory, nullptr);
+        }
+        vkDestroyFence(device, batch.fence, nullptr);
+        vkFreeCommandBuffers(device, m_context->getCommandPool(), 1, &batch.cmdBuf);
+
+        m_completedSerial = batch.serial;
+        m_inFlight.pop_front();
+    }
+}
+
+void VulkanMeshSink::releaseMesh(VulkanGpuMesh* mesh)
+{
+    if (mesh->quads)
+    {
+        releaseQuads(mesh->quads);
+        delete mesh;
+        return;
+    }
+
+    VkDevice device = m_context->getDevice();
+    if (mesh->vertexBuffer != VK_NULL_HANDLE) vkDestroyBuffer(device, mesh->vertexBuffer, nullptr);
+    if (mesh->vertexMemory != VK_NULL_HANDLE) vkFreeMemory(device, mesh->vertexMemory, nullptr);
+    if (mesh->indexBuffer != VK_NULL_HANDLE)  vkDestroyBuffer(device, mesh->indexBuffer, nullptr);
+    if (mesh->indexMemory != VK_NULL_HANDLE)  vkFreeMemory(device, mesh->indexMemory, nullptr);
+    delete mesh;
+}
+
+// Drops one reference; the last one frees the buffer and its set
+void VulkanMeshSink::releaseQuads(VulkanQuadBuffer* quads)
+{
+    if (--quads->refs > 0)
+    {
+        m_sharedBytes -= (size_t)quads->size;
+        return;
+    }
+    if (quads->listed) {
+        m_quadBuffers.erase(quads->key);
+    }
+
+    VkDevice device = m_context->getDevice();
+    vkDestroyBuffer(device, quads->buffer, nullptr);
+    vkFreeMemory(device, quads->memory, nullptr);
+    vkFreeDescriptorSets(device, quads->pool, 1, &quads->set);
+    delete quads;
+}
+
+void VulkanMeshSink::createBuffer(VkDeviceSize size,
+    VkBufferUsageFlags usage,
+    VkMemoryPropertyFlags properties,
+    VkBuffer& buffer,
+    VkDeviceMemory& memory)
+{
+    VkBufferCreateInfo bufInfo{};
+    bufInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    bufInfo.size = size;
+    bufInfo.usage = usage;
+    bufInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+
+    if (vkCreateBuffer(m_context->getDevice(), &bufInfo, nullptr, &buffer) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to create buffer!");
+    }
+
+    VkMemoryRequirements memReq;
+    vkGetBufferMemoryRequirements(m_context->getDevice(), buffer, &memReq);
+
+    VkMemoryAllocateInfo allocInfo{};
+    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    allocInfo.allocationSize = memReq.size;
+    allocInfo.memoryTypeIndex = findMemoryType(memReq.memoryTypeBits, properties);
+
+    if (vkAllocateMemory(m_context->getDevice(), &allocInfo, nullptr, &memory) != VK_SUCCESS) {
+        throw std::runtime_error("Failed to allocate buffer memory!");
+    }
+
+    vkBindBufferMemory(m_context->getDevice(), buffer, memory, 0);
+}
+
+uint32_t VulkanMeshSink::findMemoryType(uint32_t filter, VkMemoryPropertyFlags props)
+{
+    VkPhysicalDeviceMemoryProperties memProps;
+    vkGetPhysicalDeviceMemoryProperties(m_context->getPhysicalDevice(), &memProps);
+
+    for (uint32_t i = 0; i < memProps.memoryTypeCount; i++)
+    {
+        if ((filter & (1 << i)) &&
+            (memProps.memoryTypes[i].propertyFlags & props) == props)
+        {
+            return i;
+        }
+    }
+    throw std::runtime_error("Failed to find suitable memory type!");
+}
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <vulkan/vulkan.h>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <cstdint>
+
+#include "Engine/Voxels/MeshSink.h"
+
+class VulkanContext;
+
+/**
+ * Storage buffer of PackedQuad records and its descriptor set. Meshes
+ * whose records are identical (same voxels, different place) share one,
+ * counted by `refs`; `key` is the records' content hash.
+ */
+struct VulkanQuadBuffer
+{
+    VkBuffer         buffer = VK_NULL_HANDLE;
+    VkDeviceMemory   memory = VK_NULL_HANDLE;
+    VkDescriptorSet  set = VK_NULL_HANDLE;
+    VkDescriptorPool pool = VK_NULL_HANDLE; // set's pool
+    VkDeviceSize     size = 0;
+    uint64_t         key = 0;
+    uint32_t         refs = 0;
+    bool             listed = false; // findable by key (not patched since)
+};
+
+/**
+ * A chunk mesh living in device-local vertex/index buffers. With shared
+ * quad indices there is no index buffer (VK_NULL_HANDLE). With packed
+ * quads vertexBuffer is a storage buffer of PackedQuad records, bound
+ * through quadSet, and `origin` is what they are relative to; both
+ * handles belong to `quads`, which other meshes may share.
+ */
+struct VulkanGpuMesh : public GpuMesh
+{
+    VkBuffer         vertexBuffer = VK_NULL_HANDLE;
+    VkDeviceMemory   vertexMemory = VK_NULL_HANDLE;
+    VkBuffer         indexBuffer = VK_NULL_HANDLE;
+    VkDeviceMemory   indexMemory = VK_NULL_HANDLE;
+    VkDescriptorSet  quadSet = VK_NULL_HANDLE;
+    int32_t          origin[4] = { 0, 0, 0, 0 }; // push constant (ivec4)
+    VulkanQuadBuffer* quads = nullptr;
+};
+
+/**
+ * MeshSink that uploads into device-local Vulkan buffers.
+ *
+ * Uploads are batched: each uploadMesh() fills one host-visible staging
+ * buffer and records its copies into a shared command buffer, which
+ * endFrame() submits once with a fence (instead of a queue wait per copy).
+ * Staging memory is freed when that fence signals.
+ *
+ * patchMesh() stages the new vertex ranges the same way and copies them
+ * into the live vertex buffer, after a barrier against earlier
+ * submissions still drawing from it.
+ *
+ * destroyMesh() is deferred too: a mesh is only released once the frames
+ * that may still draw it have finished and any pending copy into it is done,
+ * so unloading chunks no longer needs vkDeviceWaitIdle.
+ *
+ * Meshes are stored in one of three formats:
+ *  - Indexed:           vertex buffer + 32-bit index buffer
+ *  - SharedQuadIndices: vertex buffer only, drawn with one 16-bit quad
+ *                       index buffer (getQuadIndexBuffer) built at startup
+ *  - PackedQuads:       one 8-byte PackedQuad per quad in a storage buffer,
+ *                       expanded by shaders/quad_pull.vert (vertex pulling);
+ *                       each buffer gets a descriptor set for set 1
+ *                       (getQuadSetLayout), each mesh an origin push constant
+ *
+ * Packed records are relative to the mesh origin, so chunks with the same
+ * voxels pack to the same records. Those are uploaded once: a mesh whose
+ * records hash to a live buffer's key references that buffer (and its
+ * set) instead of getting its own, and only its origin differs. A shared
+ * buffer can't be patched in place; patchMesh() refuses, and the caller's
+ * full rebuild gets a buffer of its own. Every mesh still reports the
+ * full byteSize, so MeshResidency's budget stays on the safe side.
+ */
+class VulkanMeshSink : public MeshSink
+{
+public:
+    enum class Format
+    {
+        Indexed,
+        SharedQuadIndices,
+        PackedQuads
+    };
+
+    VulkanMeshSink(VulkanContext* context, Format format);
+    ~VulkanMeshSink() override;
+
+    GpuMesh* uploadMesh(const std::vector<Vertex>& verts, const std::vector<uint32_t>& inds) override;
+    void     destroyMesh(GpuMesh* mesh) override;
+    bool     patchMesh(GpuMesh* mesh, const std::vector<MeshPatch>& patches) override;
+    void     endFrame() override;
+    bool     usesSharedQuadIndices() const override { return m_format != Format::Indexed; }
+
+    Format getFormat() const { return m_format; }
+
+    /// Packed-quad uploads, those that reused a live buffer, and the bytes that saved now
+    uint64_t getPackedUploadCount() const { return m_packedUploads; }
+    uint64_t getSharedUploadCount() const { return m_sharedUploads; }
+    size_t   getSharedBytes() const { return m_sharedBytes; }
+
+    /// ChunkMesher::SHARED_INDEX_QUADS quads of uint16 indices; null unless Format::SharedQuadIndices
+    VkBuffer getQuadIndexBuffer() const { return m_quadIndexBuffer; }
+
+    /// Set 1 of the vertex-pulling pipelines (one storage buffer); null unless Format::PackedQuads
+    VkDescriptorSetLayout getQuadSetLayout() const { return m_quadSetLayout; }
+
+    /// Meshes on chunks come from this sink, so the downcast is safe.
+    static const VulkanGpuMesh* cast(const GpuMesh* mesh) { return static_cast<const VulkanGpuMesh*>(mesh); }
+
+private:
+    // Frames a destroyed mesh is kept alive (Renderer::MAX_FRAMES_IN_FLIGHT + 1)
+    static const uint64_t DESTROY_DELAY_FRAMES = 3;
+    // Descriptor sets per pool for packed-quad meshes; pools are added as needed
+    static const uint32_t QUAD_SETS_PER_POOL = 1024;
+
+    struct StagingBuffer
+    {
+        VkBuffer       buffer = VK_NULL_HANDLE;
+        VkDeviceMemory memory = VK_NULL_HANDLE;
+    };
+
+    struct UploadBatch
+    {
+        VkCommandBuffer            cmdBuf = VK_NULL_HANDLE;
+        VkFence                    fence = VK_NULL_HANDLE;
+        std::vector<StagingBuffer> staging;
+        uint64_t                   serial = 0;
+        bool                       patchBarrier = false; // WAR barrier recorded for patches
+    };
+
+    struct PendingDestroy
+    {
+        VulkanGpuMesh* mesh = nullptr;
+        uint64_t       frame = 0;       // m_frame when destroyMesh was called
+        uint64_t       batchSerial = 0; // batch that may still copy into it
+    };
+
+    void beginBatchIfNeeded();
+    void createQuadIndexBuffer();
+    void createQuadSetLayout();
+    void allocateQuadSet(VulkanQuadBuffer* quads);
+    void releaseQuads(VulkanQuadBuffer* quads);
+    void retireBatches(bool waitAll);
+    void releaseMesh(VulkanGpuMesh* mesh);
+
+    void createBuffer(VkDeviceSize size,
+        VkBufferUsageFlags usage,
+        VkMemoryPropertyFlags properties,
+        VkBuffer& buffer,
+        VkDeviceMemory& memory);
+    uint32_t findMemoryType(uint32_t filter, VkMemoryPropertyFlags props);
+
+private:
+    VulkanContext* m_context = nullptr;
+
+    Format         m_format = Format::Indexed;
+    VkBuffer       m_quadIndexBuffer = VK_NULL_HANDLE;
+    VkDeviceMemory m_quadIndexMemory = VK_NULL_HANDLE;
+
+    VkDescriptorSetLayout         m_quadSetLayout = VK_NULL_HANDLE;
+    std::vector<VkDescriptorPool> m_quadPools; // the last one has room, maybe
+
+    // Live, unpatched packed-quad buffers by content hash
+    std::unordered_map<uint64_t, VulkanQuadBuffer*> m_quadBuffers;
+    uint64_t m_packedUploads = 0;
+    uint64_t m_sharedUploads = 0;
+    size_t   m_sharedBytes = 0; // sum of size * (refs - 1)
+
+    // Batch being recorded this frame
+    UploadBatch m_recording;
+    bool        m_isRecording = false;
+
+    std::deque<UploadBatch>    m_inFlight;
+    std::deque<PendingDestroy> m_pendingDestroys;
+
+    uint64_t m_nextSerial = 1;      // serial of the batch being recorded / next to record
+    uint64_t m_completedSerial = 0; // all batches <= this have finished
+    uint64_t m_frame = 0;
+};
@@ -18,15 +18,21 @@ public:
         : position(startPos)
     {}
 
-    // Generate the view matrix from position/yaw/pitch
-    glm::mat4 getViewMatrix() const
+    // Unit "forward" vector from yaw/pitch (also used for picking)
+    glm::vec3 getForward() const
     {
-        // 1) compute "forward" from yaw/pitch
         glm::vec3 direction;
         direction.x = cos(glm::radians(yaw)) * cos(glm::radians(pitch));
         direction.y = sin(glm::radians(pitch));
         direction.z = sin(glm::radians(yaw)) * cos(glm::radians(pitch));
-        glm::vec3 forward = glm::normalize(direction);
+        return glm::normalize(direction);
+    }
+
+    // Generate the view matrix from position/yaw/pitch
+    glm::mat4 getViewMatrix() const
+    {
+        // 1) compute "forward" from yaw/pitch
+        glm::vec3 forward = getForward();
 
         // 2) cross to get a real up vector
         glm::vec3 right = glm::normalize(glm::cross(forward, glm::vec3(0, 1, 0)));
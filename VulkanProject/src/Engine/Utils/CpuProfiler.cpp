@@ -1,11 +1,155 @@
 #include "CpuProfiler.h"
 #include <stdexcept>
+#include <thread>
 
+#ifdef _WIN32
+#include <windows.h>
+#include <tlhelp32.h>
 // Link with pdh.lib (for Visual Studio)
 #pragma comment(lib, "pdh.lib")
+#else
+#include <cstdio>
+#include <cstring>
+#include <cstdlib>
+#include <dirent.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#endif
 
+// -----------------------------------------------------------------------------
+// Platform helpers
+// -----------------------------------------------------------------------------
+namespace
+{
+    struct ThreadTimes
+    {
+        uint64_t    id;
+        uint64_t    cpuUs;
+        std::string name;
+    };
+
+#ifdef _WIN32
+    uint64_t fileTimeToUs(const FILETIME& ft)
+    {
+        ULARGE_INTEGER v;
+        v.LowPart = ft.dwLowDateTime;
+        v.HighPart = ft.dwHighDateTime;
+        return v.QuadPart / 10; // 100 ns units
+    }
+
+    uint64_t readProcessCpuUs()
+    {
+        FILETIME creation, exitTime, kernel, user;
+        if (!GetProcessTimes(GetCurrentProcess(), &creation, &exitTime, &kernel, &user)) {
+            return 0;
+        }
+        return fileTimeToUs(kernel) + fileTimeToUs(user);
+    }
+
+    void readThreadTimes(std::vector<ThreadTimes>& out)
+    {
+        out.clear();
+        HANDLE snapshot = CreateToolhelp32Snapshot(TH32CS_SNAPTHREAD, 0);
+        if (snapshot == INVALID_HANDLE_VALUE) return;
+
+        DWORD pid = GetCurrentProcessId();
+        THREADENTRY32 entry;
+        entry.dwSize = sizeof(entry);
+        for (BOOL ok = Thread32First(snapshot, &entry); ok; ok = Thread32Next(snapshot, &entry))
+        {
+            if (entry.th32OwnerProcessID != pid) continue;
+
+            HANDLE thread = OpenThread(THREAD_QUERY_LIMITED_INFORMATION, FALSE, entry.th32ThreadID);
+            if (!thread) continue;
+
+            FILETIME creation, exitTime, kernel, user;
+            if (GetThreadTimes(thread, &creation, &exitTime, &kernel, &user))
+            {
+                ThreadTimes t;
+                t.id = entry.th32ThreadID;
+                t.cpuUs = fileTimeToUs(kernel) + fileTimeToUs(user);
+                t.name = "TID " + std::to_string(entry.th32ThreadID);
+                out.push_back(t);
+            }
+            CloseHandle(thread);
+        }
+        CloseHandle(snapshot);
+    }
+#else
+    // First line of /proc/stat: "cpu user nice system idle iowait irq softirq steal ..."
+    bool readSystemTicks(uint64_t& total, uint64_t& idle)
+    {
+        FILE* f = std::fopen("/proc/stat", "r");
+        if (!f) return false;
+
+        unsigned long long v[8] = { 0 };
+        int n = std::fscanf(f, "cpu %llu %llu %llu %llu %llu %llu %llu %llu",
+            &v[0], &v[1], &v[2], &v[3], &v[4], &v[5], &v[6], &v[7]);
+        std::fclose(f);
+        if (n < 4) return false;
+
+        total = 0;
+        for (int i = 0; i < n; i++) total += v[i];
+        idle = v[3] + (n > 4 ? v[4] : 0); // idle + iowait
+        return true;
+    }
+
+    uint64_t readProcessCpuUs()
+    {
+        struct rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+        return uint64_t(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec) * 1000000ull
+            + uint64_t(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec);
+    }
+
+    void readThreadTimes(std::vector<ThreadTimes>& out)
+    {
+        out.clear();
+        DIR* dir = opendir("/proc/self/task");
+        if (!dir) return;
+
+        static const long s_ticksPerSec = sysconf(_SC_CLK_TCK);
+        char path[300];
+        char buf[512];
+
+        while (dirent* entry = readdir(dir))
+        {
+            if (entry->d_name[0] < '0' || entry->d_name[0] > '9') continue;
+
+            std::snprintf(path, sizeof(path), "/proc/self/task/%s/stat", entry->d_name);
+            FILE* f = std::fopen(path, "r");
+            if (!f) continue; // thread exited meanwhile
+            size_t len = std::fread(buf, 1, sizeof(buf) - 1, f);
+            std::fclose(f);
+            buf[len] = '\0';
+
+            // "tid (comm) state f4 ... f13 utime stime ..." - comm may contain spaces
+            char* open = std::strchr(buf, '(');
+            char* close = std::strrchr(buf, ')');
+            if (!open || !close || close < open) continue;
+
+            unsigned long long utime = 0, stime = 0;
+            int n = std::sscanf(close + 2,
+                "%*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %llu %llu", &utime, &stime);
+            if (n != 2) continue;
+
+            ThreadTimes t;
+            t.id = std::strtoull(entry->d_name, nullptr, 10);
+            t.cpuUs = (utime + stime) * 1000000ull / (uint64_t)(s_ticksPerSec > 0 ? s_ticksPerSec : 100);
+            t.name.assign(open + 1, close);
+            out.push_back(t);
+        }
+        closedir(dir);
+    }
+#endif
+}
+
+// -----------------------------------------------------------------------------
+// CpuProfiler
+// -----------------------------------------------------------------------------
 CpuProfiler::CpuProfiler()
 {
+#ifdef _WIN32
     // Open a PDH query
     if (PdhOpenQuery(NULL, NULL, &m_cpuQuery) != ERROR_SUCCESS) {
         throw std::runtime_error("Failed to open PDH query for CPU usage.");
@@ -19,15 +163,43 @@ CpuProfiler::CpuProfiler()
 
     // Do an initial collection
     PdhCollectQueryData(m_cpuQuery);
+#else
+    readSystemTicks(m_lastTotalTicks, m_lastIdleTicks);
+#endif
+
+    unsigned int hc = std::thread::hardware_concurrency();
+    m_coreCount = hc > 0 ? hc : 1;
+
+    // Prime the deltas so the first Get* call reports something sensible
+    Clock::time_point now = Clock::now();
+    m_lastTotalSample = now;
+    m_lastProcessSample = now;
+    m_lastThreadSample = now;
+    m_lastProcessCpuUs = readProcessCpuUs();
+
+    std::vector<ThreadTimes> threads;
+    readThreadTimes(threads);
+    for (const ThreadTimes& t : threads) {
+        m_lastThreadCpuUs[t.id] = t.cpuUs;
+    }
 }
 
 CpuProfiler::~CpuProfiler()
 {
+#ifdef _WIN32
     PdhCloseQuery(m_cpuQuery);
+#endif
 }
 
 float CpuProfiler::GetCpuUsage()
 {
+    Clock::time_point now = Clock::now();
+    if (now - m_lastTotalSample < std::chrono::milliseconds(kMinSampleIntervalMs)) {
+        return m_totalUsage;
+    }
+    m_lastTotalSample = now;
+
+#ifdef _WIN32
     // Collect data for the query
     if (PdhCollectQueryData(m_cpuQuery) != ERROR_SUCCESS) {
         return 0.0f;
@@ -37,7 +209,71 @@ float CpuProfiler::GetCpuUsage()
     if (PdhGetFormattedCounterValue(m_cpuTotal, PDH_FMT_DOUBLE, NULL, &counterVal) != ERROR_SUCCESS) {
         return 0.0f;
     }
-    return static_cast<float>(counterVal.doubleValue);
+    m_totalUsage = static_cast<float>(counterVal.doubleValue);
+#else
+    uint64_t total = 0, idle = 0;
+    if (!readSystemTicks(total, idle)) {
+        return 0.0f;
+    }
+
+    uint64_t dTotal = total - m_lastTotalTicks;
+    uint64_t dIdle = idle - m_lastIdleTicks;
+    m_lastTotalTicks = total;
+    m_lastIdleTicks = idle;
+    if (dTotal > 0) {
+        m_totalUsage = 100.0f * float(dTotal - dIdle) / float(dTotal);
+    }
+#endif
+    return m_totalUsage;
+}
+
+float CpuProfiler::GetProcessCpuUsage()
+{
+    Clock::time_point now = Clock::now();
+    if (now - m_lastProcessSample < std::chrono::milliseconds(kMinSampleIntervalMs)) {
+        return m_processUsage;
+    }
+
+    double wallUs = (double)std::chrono::duration_cast<std::chrono::microseconds>(now - m_lastProcessSample).count();
+    uint64_t cpuUs = readProcessCpuUs();
+
+    m_processUsage = float(100.0 * double(cpuUs - m_lastProcessCpuUs) / (wallUs * m_coreCount));
+    m_lastProcessCpuUs = cpuUs;
+    m_lastProcessSample = now;
+    return m_processUsage;
+}
+
+const std::vector<ThreadCpuUsage>& CpuProfiler::GetThreadCpuUsage()
+{
+    Clock::time_point now = Clock::now();
+    if (now - m_lastThreadSample < std::chrono::milliseconds(kMinSampleIntervalMs)) {
+        return m_threadUsage;
+    }
+
+    double wallUs = (double)std::chrono::duration_cast<std::chrono::microseconds>(now - m_lastThreadSample).count();
+    m_lastThreadSample = now;
+
+    std::vector<ThreadTimes> threads;
+    readThreadTimes(threads);
+
+    // Threads seen for the first time count from zero; dead ones drop out
+    std::unordered_map<uint64_t, uint64_t> current;
+    m_threadUsage.clear();
+    for (const ThreadTimes& t : threads)
+    {
+        auto it = m_lastThreadCpuUs.find(t.id);
+        uint64_t prev = (it != m_lastThreadCpuUs.end() && it->second <= t.cpuUs) ? it->second : t.cpuUs;
+
+        ThreadCpuUsage usage;
+        usage.threadId = t.id;
+        usage.name = t.name;
+        usage.percent = float(100.0 * double(t.cpuUs - prev) / wallUs);
+        m_threadUsage.push_back(usage);
+
+        current[t.id] = t.cpuUs;
+    }
+    m_lastThreadCpuUs.swap(current);
+    return m_threadUsage;
 }
 
 // --- New rolling average FPS implementation ---
@@ -1,7 +1,32 @@
 #pragma once
+#ifdef _WIN32
 #include <pdh.h>
+#endif
 #include <vector>
+#include <string>
+#include <cstdint>
+#include <chrono>
+#include <unordered_map>
 
+/**
+ * CPU time used by one thread of this process since the previous sample.
+ */
+struct ThreadCpuUsage
+{
+    uint64_t    threadId = 0;
+    std::string name;           // OS thread name if available
+    float       percent = 0.0f; // of ONE core (0 - 100)
+};
+
+/**
+ * System / process / per-thread CPU usage.
+ *
+ * Windows reads the total from PDH and process/thread times from the Win32
+ * API; Linux uses /proc/stat, getrusage and /proc/self/task. Each Get*
+ * call reports usage since the previous sample of the same kind; samples
+ * closer together than kMinSampleInterval return the cached value (the
+ * kernel's accounting is too coarse for per-frame deltas).
+ */
 class CpuProfiler
 {
 public:
@@ -11,6 +36,12 @@ public:
     // Returns the total CPU usage in percentage (0.0 - 100.0)
     float GetCpuUsage();
 
+    // CPU used by this process, normalised over all cores (0.0 - 100.0)
+    float GetProcessCpuUsage();
+
+    // CPU used by each live thread of this process
+    const std::vector<ThreadCpuUsage>& GetThreadCpuUsage();
+
     // --- New methods for rolling average FPS ---
     // Call this once per frame with the current FPS value.
     void UpdateFPS(float fps);
@@ -19,8 +50,30 @@ public:
     float GetRollingAverageFPS() const;
 
 private:
+    typedef std::chrono::steady_clock Clock;
+    static const int kMinSampleIntervalMs = 250;
+
+#ifdef _WIN32
     PDH_HQUERY m_cpuQuery;
     PDH_HCOUNTER m_cpuTotal;
+#else
+    uint64_t m_lastTotalTicks = 0;
+    uint64_t m_lastIdleTicks = 0;
+#endif
+
+    unsigned int m_coreCount = 1;
+
+    // Last samples (cached between intervals)
+    Clock::time_point m_lastTotalSample;
+    float             m_totalUsage = 0.0f;
+
+    Clock::time_point m_lastProcessSample;
+    uint64_t          m_lastProcessCpuUs = 0;
+    float             m_processUsage = 0.0f;
+
+    Clock::time_point                      m_lastThreadSample;
+    std::unordered_map<uint64_t, uint64_t> m_lastThreadCpuUs; // thread id -> CPU time
+    std::vector<ThreadCpuUsage>            m_threadUsage;
 
     // Rolling average FPS variables:
     static const size_t kMaxFPSamples = 60; // Number of frames to average over
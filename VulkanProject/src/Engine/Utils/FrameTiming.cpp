@@ -0,0 +1,308 @@
+#include "FrameTiming.h"
+
+#include <algorithm>
+#include <cstdio>
+
+namespace
+{
+    // Sub-ms jitter on a tiny median isn't a spike
+    const double SPIKE_MIN_MS = 1.0;
+}
+
+// -----------------------------------------------------------------------------
+// LatencyHistogram
+// -----------------------------------------------------------------------------
+LatencyHistogram::LatencyHistogram()
+    : m_buckets(BUCKET_COUNT, 0)
+{
+}
+
+int LatencyHistogram::bucketIndex(uint64_t us)
+{
+    if (us < 2 * SUB_BUCKET_COUNT) {
+        return (int)us;
+    }
+
+    int msb = 63;
+    while (!(us >> msb)) msb--;
+
+    int shift = msb - SUB_BUCKET_BITS;
+    if (shift > MAX_SHIFT) {
+        return BUCKET_COUNT - 1; // clamp absurd values into the last bucket
+    }
+    // (us >> shift) is in [32, 64): the linear sub-bucket within this power of two
+    return (shift + 1) * SUB_BUCKET_COUNT + (int)(us >> shift) - SUB_BUCKET_COUNT;
+}
+
+uint64_t LatencyHistogram::bucketMidpoint(int index)
+{
+    if (index < 2 * SUB_BUCKET_COUNT) {
+        return (uint64_t)index;
+    }
+    int      shift = index / SUB_BUCKET_COUNT - 1;
+    uint64_t sub = (uint64_t)(index % SUB_BUCKET_COUNT + SUB_BUCKET_COUNT);
+    uint64_t low = sub << shift;
+    return low + ((1ull << shift) >> 1);
+}
+
+void LatencyHistogram::record(uint64_t us)
+{
+    m_buckets[bucketIndex(us)]++;
+    m_count++;
+    m_sumUs += us;
+    m_maxUs = std::max(m_maxUs, us);
+}
+
+void LatencyHistogram::reset()
+{
+    std::fill(m_buckets.begin(), m_buckets.end(), 0);
+    m_count = 0;
+    m_sumUs = 0;
+    m_maxUs = 0;
+}
+
+double LatencyHistogram::getMeanMs() const
+{
+    return m_count ? (double)m_sumUs / (double)m_count / 1000.0 : 0.0;
+}
+
+double LatencyHistogram::getPercentileMs(double p) const
+{
+    if (m_count == 0) return 0.0;
+
+    // Nearest rank
+    uint64_t rank = (uint64_t)(p * (double)m_count + 0.5);
+    rank = std::max<uint64_t>(1, std::min(rank, m_count));
+
+    uint64_t seen = 0;
+    for (int i = 0; i < BUCKET_COUNT; i++)
+    {
+        seen += m_buckets[i];
+        if (seen >= rank) {
+            // Never report past the true maximum
+            return std::min(bucketMidpoint(i), m_maxUs) / 1000.0;
+        }
+    }
+    return m_maxUs / 1000.0;
+}
+
+// -----------------------------------------------------------------------------
+// FrameTiming
+// -----------------------------------------------------------------------------
+const char* FrameTiming::channelName(Channel channel)
+{
+    switch (channel)
+    {
+    case CPU_FRAME:        return "cpuFrame";
+    case GPU_FRAME:        return "gpuFrame";
+    case PRESENT_INTERVAL: return "presentInterval";
+    default:               return "unknown";
+    }
+}
+
+FrameTiming::FrameTiming()
+    : m_recentCpu(RECENT_FRAMES, 0.f)
+{
+    std::fill(m_liveSpikes, m_liveSpikes + CHANNEL_COUNT, 0);
+    std::fill(m_captureSpikes, m_captureSpikes + CHANNEL_COUNT, 0);
+    m_frameStart = Clock::now();
+}
+
+uint64_t FrameTiming::beginFrame()
+{
+    m_frameStart = Clock::now();
+    m_waitMs = 0.0;
+    return ++m_frameIndex;
+}
+
+void FrameTiming::markPresent()
+{
+    Clock::time_point now = Clock::now();
+
+    double cpuMs = std::chrono::duration<double, std::milli>(now - m_frameStart).count() - m_waitMs;
+    cpuMs = std::max(cpuMs, 0.0);
+    record(CPU_FRAME, cpuMs);
+
+    m_recentCpu[m_recentNext] = (float)cpuMs;
+    m_recentNext = (m_recentNext + 1) % RECENT_FRAMES;
+
+    double presentMs = 0.0;
+    if (m_hasLastPresent) {
+        presentMs = std::chrono::duration<double, std::milli>(now - m_lastPresent).count();
+        record(PRESENT_INTERVAL, presentMs);
+    }
+    m_lastPresent = now;
+    m_hasLastPresent = true;
+
+    if (m_capturing && m_frameIndex >= m_captureFirstFrame)
+    {
+        CaptureRow row;
+        row.frame = m_frameIndex;
+        row.cpuMs = (float)cpuMs;
+        row.presentMs = (float)presentMs;
+        m_captureRows.push_back(row);
+
+        if (now >= m_captureEnd) {
+            m_capturing = false;
+        }
+    }
+}
+
+void FrameTiming::recordGpuFrame(uint64_t frameIndex, double ms)
+{
+    // Live stats take it regardless; the capture only for frames inside its
+    // window (the last ones arrive after the window has closed)
+    bool inCapture = false;
+    if (!m_captureRows.empty() && frameIndex >= m_captureRows.front().frame)
+    {
+        auto it = std::lower_bound(m_captureRows.begin(), m_captureRows.end(), frameIndex,
+            [](const CaptureRow& row, uint64_t frame) { return row.frame < frame; });
+        if (it != m_captureRows.end() && it->frame == frameIndex) {
+            it->gpuMs = (float)ms;
+            inCapture = true;
+        }
+    }
+
+    bool spike = isSpike(m_live[GPU_FRAME], ms);
+
+    m_live[GPU_FRAME].record((uint64_t)(ms * 1000.0));
+    if (spike) m_liveSpikes[GPU_FRAME]++;
+    if (inCapture) {
+        m_capture[GPU_FRAME].record((uint64_t)(ms * 1000.0));
+        if (spike) m_captureSpikes[GPU_FRAME]++;
+    }
+}
+
+void FrameTiming::record(Channel channel, double ms)
+{
+    LatencyHistogram& live = m_live[channel];
+    bool spike = isSpike(live, ms);
+
+    uint64_t us = (uint64_t)(ms * 1000.0);
+    live.record(us);
+    if (spike) m_liveSpikes[channel]++;
+
+    if (m_capturing && m_frameIndex >= m_captureFirstFrame) {
+        m_capture[channel].record(us);
+        if (spike) m_captureSpikes[channel]++;
+    }
+}
+
+bool FrameTiming::isSpike(const LatencyHistogram& live, double ms) const
+{
+    if (live.getCount() < SPIKE_MIN_SAMPLES) return false;
+    double threshold = std::max(m_spikeFactor * live.getPercentileMs(0.5), SPIKE_MIN_MS);
+    return ms > threshold;
+}
+
+FrameTimingStats FrameTiming::makeStats(const LatencyHistogram& hist, uint64_t spikes)
+{
+    FrameTimingStats s;
+    s.count = hist.getCount();
+    s.meanMs = hist.getMeanMs();
+    s.p50Ms = hist.getPercentileMs(0.50);
+    s.p95Ms = hist.getPercentileMs(0.95);
+    s.p99Ms = hist.getPercentileMs(0.99);
+    s.maxMs = hist.getMaxMs();
+    s.spikes = spikes;
+    return s;
+}
+
+FrameTimingStats FrameTiming::getStats(Channel channel) const
+{
+    return makeStats(m_live[channel], m_liveSpikes[channel]);
+}
+
+FrameTimingStats FrameTiming::getCaptureStats(Channel channel) const
+{
+    return makeStats(m_capture[channel], m_captureSpikes[channel]);
+}
+
+void FrameTiming::reset()
+{
+    for (int c = 0; c < CHANNEL_COUNT; c++) {
+        m_live[c].reset();
+        m_liveSpikes[c] = 0;
+    }
+}
+
+// ------------------------------------------------
+// Capture window
+// ------------------------------------------------
+void FrameTiming::startCapture(double seconds)
+{
+    for (int c = 0; c < CHANNEL_COUNT; c++) {
+        m_capture[c].reset();
+        m_captureSpikes[c] = 0;
+    }
+    m_captureRows.clear();
+
+    m_capturing = true;
+    m_captureDuration = seconds;
+    m_captureStart = Clock::now();
+    m_captureEnd = m_captureStart + std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double>(seconds));
+    // Starts with the next full frame (this may be called mid-frame from the UI)
+    m_captureFirstFrame = m_frameIndex + 1;
+}
+
+double FrameTiming::getCaptureElapsed() const
+{
+    if (!m_capturing) {
+        return m_captureRows.empty() ? 0.0 : m_captureDuration;
+    }
+    return std::chrono::duration<double>(Clock::now() - m_captureStart).count();
+}
+
+bool FrameTiming::exportCsv(const std::string& path) const
+{
+    FILE* f = std::fopen(path.c_str(), "w");
+    if (!f) return false;
+
+    std::fprintf(f, "frame,cpu_ms,gpu_ms,present_ms\n");
+    for (const CaptureRow& row : m_captureRows)
+    {
+        if (row.gpuMs >= 0.f) {
+            std::fprintf(f, "%llu,%.3f,%.3f,%.3f\n", (unsigned long long)row.frame,
+                row.cpuMs, row.gpuMs, row.presentMs);
+        }
+        else {
+            std::fprintf(f, "%llu,%.3f,,%.3f\n", (unsigned long long)row.frame,
+                row.cpuMs, row.presentMs);
+        }
+    }
+
+    bool ok = !std::ferror(f);
+    std::fclose(f);
+    return ok;
+}
+
+bool FrameTiming::exportJson(const std::string& path) const
+{
+    FILE* f = std::fopen(path.c_str(), "w");
+    if (!f) return false;
+
+    std::fprintf(f, "{\n  \"windowSec\": %.3f,\n  \"frames\": %zu,\n  \"spikeFactor\": %.2f,\n",
+        m_captureDuration, m_captureRows.size(), m_spikeFactor);
+    for (int c = 0; c < CHANNEL_COUNT; c++)
+    {
+        FrameTimingStats s = getCaptureStats((Channel)c);
+        std::fprintf(f, "  \"%s\": {\"count\":%llu,\"mean\":%.3f,\"p50\":%.3f,\"p95\":%.3f,"
+            "\"p99\":%.3f,\"max\":%.3f,\"spikes\":%llu}%s\n",
+            channelName((Channel)c), (unsigned long long)s.count, s.meanMs, s.p50Ms, s.p95Ms,
+            s.p99Ms, s.maxMs, (unsigned long long)s.spikes, c + 1 < CHANNEL_COUNT ? "," : "");
+    }
+    std::fprintf(f, "}\n");
+
+    bool ok = !std::ferror(f);
+    std::fclose(f);
+    return ok;
+}
+
+void FrameTiming::getRecentCpuFrames(std::vector<float>& out) const
+{
+    out.resize(RECENT_FRAMES);
+    for (int i = 0; i < RECENT_FRAMES; i++) {
+        out[i] = m_recentCpu[(m_recentNext + i) % RECENT_FRAMES];
+    }
+}
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * Log-linear latency histogram (HDR histogram style) over microseconds.
+ *
+ * Values below 64 us get one bucket each; above that every power of two is
+ * split into 32 linear sub-buckets, so any recorded value is known to within
+ * ~3% up to ~67 s. Recording is a couple of bit operations and memory is
+ * fixed, so it can take every frame for hours without dropping outliers the
+ * way a rolling average does.
+ */
+class LatencyHistogram
+{
+public:
+    LatencyHistogram();
+
+    void record(uint64_t us);
+    void reset();
+
+    uint64_t getCount() const { return m_count; }
+    double   getMeanMs() const;
+    double   getMaxMs() const { return m_maxUs / 1000.0; }
+
+    /// Value at percentile p (0..1), in ms. Reports the middle of the bucket.
+    double getPercentileMs(double p) const;
+
+private:
+    static const int SUB_BUCKET_BITS = 5;
+    static const int SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;   // 32
+    static const int MAX_SHIFT = 21;                            // 2^26 us ~ 67 s
+    static const int BUCKET_COUNT = (MAX_SHIFT + 2) * SUB_BUCKET_COUNT;
+
+    static int      bucketIndex(uint64_t us);
+    static uint64_t bucketMidpoint(int index);
+
+    std::vector<uint64_t> m_buckets;
+    uint64_t              m_count = 0;
+    uint64_t              m_sumUs = 0;
+    uint64_t              m_maxUs = 0;
+};
+
+/**
+ * Summary of one timing channel.
+ */
+struct FrameTimingStats
+{
+    uint64_t count = 0;
+    double   meanMs = 0.0;
+    double   p50Ms = 0.0;
+    double   p95Ms = 0.0;
+    double   p99Ms = 0.0;
+    double   maxMs = 0.0;
+    uint64_t spikes = 0;   // samples > spikeFactor * median at the time (and > 1 ms)
+};
+
+/**
+ * Per-frame timing telemetry for the main loop.
+ *
+ * Three channels:
+ *  - CPU frame:   main-thread work from beginFrame() to present, minus the
+ *                 time spent blocked on fences / image acquire (addWaitTime)
+ *  - GPU frame:   timestamp-query duration of the frame's command buffer,
+ *                 reported late (once its fence signals) via recordGpuFrame
+ *  - Present:     wall time between consecutive presents
+ *
+ * Each channel feeds a "live" histogram (since the last reset()) and, while a
+ * capture runs, a capture histogram plus one CSV row per frame. A capture
+ * stops by itself after its window; exportCsv/exportJson write the result.
+ *
+ * Main thread only.
+ */
+class FrameTiming
+{
+public:
+    enum Channel
+    {
+        CPU_FRAME = 0,
+        GPU_FRAME,
+        PRESENT_INTERVAL,
+        CHANNEL_COUNT
+    };
+
+    static const char* channelName(Channel channel);
+
+    FrameTiming();
+
+    /// Start of a main-loop iteration. Returns the frame's index.
+    uint64_t beginFrame();
+    /// Time the main thread spent blocked this frame (excluded from CPU time).
+    void addWaitTime(double ms) { m_waitMs += ms; }
+    /// After present: closes the CPU frame and records the present interval.
+    void markPresent();
+    /// GPU duration of an earlier frame, once its results are available.
+    void recordGpuFrame(uint64_t frameIndex, double ms);
+
+    uint64_t getFrameIndex() const { return m_frameIndex; }
+
+    FrameTimingStats getStats(Channel channel) const;
+    FrameTimingStats getCaptureStats(Channel channel) const;
+    void reset();
+
+    /// A sample counts as a spike when above factor * current median.
+    void  setSpikeFactor(float factor) { m_spikeFactor = factor; }
+    float getSpikeFactor() const { return m_spikeFactor; }
+
+    // ------------------------------------------------
+    // Capture window
+    // ------------------------------------------------
+    void   startCapture(double seconds);
+    bool   isCapturing() const { return m_capturing; }
+    bool   hasCapture() const { return !m_captureRows.empty(); }
+    double getCaptureElapsed() const;
+    double getCaptureDuration() const { return m_captureDuration; }
+
+    /// One row per captured frame: frame, cpu_ms, gpu_ms, present_ms.
+    bool exportCsv(const std::string& path) const;
+    /// Capture window summary (percentiles + spikes per channel).
+    bool exportJson(const std::string& path) const;
+
+    /// Recent CPU frame times (ms), oldest first, for a plot.
+    void getRecentCpuFrames(std::vector<float>& out) const;
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    static const int      RECENT_FRAMES = 240;
+    static const uint64_t SPIKE_MIN_SAMPLES = 30; // median is noise before that
+
+    struct CaptureRow
+    {
+        uint64_t frame = 0;
+        float    cpuMs = 0.f;
+        float    gpuMs = -1.f;     // -1: not (yet) known
+        float    presentMs = 0.f;
+    };
+
+    void record(Channel channel, double ms);
+    bool isSpike(const LatencyHistogram& live, double ms) const;
+    static FrameTimingStats makeStats(const LatencyHistogram& hist, uint64_t spikes);
+
+    LatencyHistogram m_live[CHANNEL_COUNT];
+    LatencyHistogram m_capture[CHANNEL_COUNT];
+    uint64_t         m_liveSpikes[CHANNEL_COUNT];
+    uint64_t         m_captureSpikes[CHANNEL_COUNT];
+    float            m_spikeFactor = 2.0f;
+
+    uint64_t          m_frameIndex = 0;
+    Clock::time_point m_frameStart;
+    Clock::time_point m_lastPresent;
+    bool              m_hasLastPresent = false;
+    double            m_waitMs = 0.0;
+
+    bool                    m_capturing = false;
+    double                  m_captureDuration = 0.0;
+    Clock::time_point       m_captureStart;
+    Clock::time_point       m_captureEnd;
+    uint64_t                m_captureFirstFrame = 0;
+    std::vector<CaptureRow> m_captureRows;
+
+    std::vector<float> m_recentCpu; // ring of RECENT_FRAMES
+    size_t             m_recentNext = 0;
+};
@@ -1,12 +1,415 @@
 #include "Logger.h"
-#include <iostream>
+
+#include <cstdio>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <algorithm>
+
+using namespace LogDetail;
+
+std::atomic<int> Logger::s_runtimeLevel{ (int)LogLevel::Info };
+
+// -----------------------------------------------------------------------------
+// Encoder (out-of-line bits)
+// -----------------------------------------------------------------------------
+void LogDetail::Encoder::writeStr(const char* s, size_t len)
+{
+    // tag + u16 length + bytes; long strings are cut to what's left
+    if (m_full || m_size + 3 > m_cap) { m_full = true; return; }
+
+    size_t room = m_cap - m_size - 3;
+    bool truncated = (len > room);
+    if (truncated) len = room;
+
+    uint16_t len16 = (uint16_t)len;
+    m_buf[m_size++] = ARG_STR;
+    std::memcpy(m_buf + m_size, &len16, sizeof(len16));
+    m_size += sizeof(len16);
+    std::memcpy(m_buf + m_size, s, len);
+    m_size += len;
+    m_count++;
+
+    if (truncated) m_full = true;
+}
+
+namespace
+{
+    // Records per thread ring (power of two). 1024 * 256 B = 256 KB per thread.
+    const uint32_t RING_CAPACITY = 1024;
+    const uint32_t RING_MASK = RING_CAPACITY - 1;
+
+    // How often the flusher wakes up on its own
+    const std::chrono::milliseconds FLUSH_INTERVAL(10);
+
+    inline uint64_t nowNs()
+    {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    /**
+     * Single-producer / single-consumer ring owned by one logging thread.
+     * head is only written by the owner, tail only by the (drain-locked) consumer.
+     */
+    struct ThreadRing
+    {
+        LogRecord             slots[RING_CAPACITY];
+        std::atomic<uint32_t> head{ 0 };
+        std::atomic<uint32_t> tail{ 0 };
+        std::atomic<bool>     orphaned{ false }; // owner thread has exited
+        uint32_t              threadIndex = 0;
+    };
+
+    // Marks the ring orphaned when its thread exits so the flusher can free it
+    struct ThreadRingHandle
+    {
+        ThreadRing* ring = nullptr;
+        ~ThreadRingHandle()
+        {
+            if (ring) ring->orphaned.store(true, std::memory_order_release);
+        }
+    };
+
+    thread_local ThreadRingHandle t_ring;
+    thread_local LogRecord        t_syncRecord; // used once the flusher is gone
+
+    const char* levelName(int level)
+    {
+        switch (level) {
+        case (int)LogLevel::Trace: return "TRACE";
+        case (int)LogLevel::Debug: return "DEBUG";
+        case (int)LogLevel::Info:  return "INFO";
+        case (int)LogLevel::Warn:  return "WARN";
+        case (int)LogLevel::Error: return "ERROR";
+        default:                   return "?";
+        }
+    }
+
+    // Decodes one argument at 'p' and appends it; returns the next position
+    const uint8_t* appendArg(const uint8_t* p, const uint8_t* end, std::string& out)
+    {
+        char tmp[64];
+        ArgType type = (ArgType)*p++;
+        switch (type)
+        {
+        case ARG_I64: {
+            int64_t v; std::memcpy(&v, p, sizeof(v)); p += sizeof(v);
+            std::snprintf(tmp, sizeof(tmp), "%lld", (long long)v);
+            out += tmp;
+            break;
+        }
+        case ARG_U64: {
+            uint64_t v; std::memcpy(&v, p, sizeof(v)); p += sizeof(v);
+            std::snprintf(tmp, sizeof(tmp), "%llu", (unsigned long long)v);
+            out += tmp;
+            break;
+        }
+        case ARG_F64: {
+            double v; std::memcpy(&v, p, sizeof(v)); p += sizeof(v);
+            std::snprintf(tmp, sizeof(tmp), "%g", v);
+            out += tmp;
+            break;
+        }
+        case ARG_BOOL:
+            out += (*p++ ? "true" : "false");
+            break;
+        case ARG_CHAR:
+            out += (char)*p++;
+            break;
+        case ARG_STR: {
+            uint16_t len; std::memcpy(&len, p, sizeof(len)); p += sizeof(len);
+            out.append((const char*)p, len);
+            p += len;
+            break;
+        }
+        case ARG_PTR: {
+            uint64_t v; std::memcpy(&v, p, sizeof(v)); p += sizeof(v);
+            std::snprintf(tmp, sizeof(tmp), "0x%llx", (unsigned long long)v);
+            out += tmp;
+            break;
+        }
+        default:
+            return end; // corrupt => stop decoding
+        }
+        return p;
+    }
+
+    void formatRecord(const LogRecord& rec, uint64_t startNs, std::string& out)
+    {
+        char prefix[64];
+        double seconds = (rec.timestampNs >= startNs) ? double(rec.timestampNs - startNs) * 1e-9 : 0.0;
+        std::snprintf(prefix, sizeof(prefix), "[%9.4f][T%u][%s] ",
+            seconds, rec.threadIndex, levelName(rec.level));
+        out += prefix;
+
+        const uint8_t* p = rec.payload;
+        const uint8_t* end = rec.payload + rec.payloadSize;
+        int argsLeft = rec.argCount;
+
+        for (const char* f = rec.fmt; f && *f; ++f)
+        {
+            if (f[0] == '{' && f[1] == '}')
+            {
+                if (argsLeft > 0 && p < end) {
+                    p = appendArg(p, end, out);
+                    argsLeft--;
+                }
+                else {
+                    out += "{}";
+                }
+                ++f;
+                continue;
+            }
+            out += *f;
+        }
+        out += '\n';
+    }
+
+    /**
+     * Owns all thread rings and the flusher thread. Intentionally leaked so
+     * late log calls from other static destructors never touch a dead object.
+     */
+    class LogBackend
+    {
+    public:
+        static LogBackend& get()
+        {
+            static LogBackend* s_instance = new LogBackend();
+            return *s_instance;
+        }
+
+        bool isAsync() const { return m_async.load(std::memory_order_acquire); }
+
+        ThreadRing* registerThread()
+        {
+            ThreadRing* ring = new ThreadRing();
+            std::lock_guard<std::mutex> lock(m_ringsMutex);
+            ring->threadIndex = m_nextThreadIndex++;
+            m_rings.push_back(ring);
+            return ring;
+        }
+
+        void wake() { m_wakeCondition.notify_one(); }
+        void countDrop() { m_dropped.fetch_add(1, std::memory_order_relaxed); }
+        uint64_t getDropped() const { return m_dropped.load(std::memory_order_relaxed); }
+
+        /**
+         * Moves everything queued so far to the output. Safe from any thread.
+         */
+        void drain()
+        {
+            std::lock_guard<std::mutex> drainLock(m_drainMutex);
+
+            std::vector<ThreadRing*> rings;
+            {
+                std::lock_guard<std::mutex> lock(m_ringsMutex);
+                rings = m_rings;
+            }
+
+            m_batch.clear();
+            std::vector<ThreadRing*> finished;
+            for (ThreadRing* ring : rings)
+            {
+                // Read 'orphaned' before head: once set, no more writes follow
+                bool orphaned = ring->orphaned.load(std::memory_order_acquire);
+                uint32_t t = ring->tail.load(std::memory_order_relaxed);
+                uint32_t h = ring->head.load(std::memory_order_acquire);
+                for (; t != h; t++) {
+                    m_batch.push_back(ring->slots[t & RING_MASK]);
+                }
+                ring->tail.store(h, std::memory_order_release);
+                if (orphaned) finished.push_back(ring);
+            }
+
+            if (!m_batch.empty())
+            {
+                // Merge all threads in time order
+                std::stable_sort(m_batch.begin(), m_batch.end(),
+                    [](const LogRecord& a, const LogRecord& b) { return a.timestampNs < b.timestampNs; });
+
+                m_outText.clear();
+                m_errText.clear();
+                for (const LogRecord& rec : m_batch)
+                {
+                    std::string& dst = (rec.level >= (uint8_t)LogLevel::Warn) ? m_errText : m_outText;
+                    formatRecord(rec, m_startNs, dst);
+                }
+                writeOut();
+            }
+
+            if (!finished.empty())
+            {
+                std::lock_guard<std::mutex> lock(m_ringsMutex);
+                for (ThreadRing* ring : finished) {
+                    m_rings.erase(std::remove(m_rings.begin(), m_rings.end(), ring), m_rings.end());
+                    delete ring;
+                }
+            }
+        }
+
+        /**
+         * Synchronous path after shutdown(): format + write on the caller.
+         */
+        void writeNow(const LogRecord& rec)
+        {
+            std::lock_guard<std::mutex> drainLock(m_drainMutex);
+            m_outText.clear();
+            m_errText.clear();
+            std::string& dst = (rec.level >= (uint8_t)LogLevel::Warn) ? m_errText : m_outText;
+            formatRecord(rec, m_startNs, dst);
+            writeOut();
+        }
+
+        void shutdown()
+        {
+            // New records go synchronous from here on...
+            m_async.store(false, std::memory_order_release);
+
+            // ...and the flusher drains whatever was already queued
+            {
+                std::lock_guard<std::mutex> lock(m_wakeMutex);
+                m_stop = true;
+            }
+            m_wakeCondition.notify_one();
+            if (m_thread.joinable()) {
+                m_thread.join();
+            }
+            drain();
+        }
+
+    private:
+        LogBackend()
+            : m_startNs(nowNs())
+        {
+            m_async.store(true, std::memory_order_release);
+            m_thread = std::thread(&LogBackend::flusherLoop, this);
+        }
+
+        void flusherLoop()
+        {
+            for (;;)
+            {
+                bool stop = false;
+                {
+                    std::unique_lock<std::mutex> lock(m_wakeMutex);
+                    m_wakeCondition.wait_for(lock, FLUSH_INTERVAL, [this] { return m_stop; });
+                    stop = m_stop;
+                }
+                drain();
+                if (stop) break;
+            }
+        }
+
+        void writeOut()
+        {
+            if (!m_outText.empty()) {
+                std::fwrite(m_outText.data(), 1, m_outText.size(), stdout);
+                std::fflush(stdout);
+            }
+            if (!m_errText.empty()) {
+                std::fwrite(m_errText.data(), 1, m_errText.size(), stderr);
+                std::fflush(stderr);
+            }
+        }
+
+        uint64_t                 m_startNs = 0;
+        std::atomic<bool>        m_async{ false };
+        std::atomic<uint64_t>    m_dropped{ 0 };
+
+        std::mutex               m_ringsMutex;
+        std::vector<ThreadRing*> m_rings;
+        uint32_t                 m_nextThreadIndex = 0;
+
+        std::mutex               m_drainMutex; // one consumer at a time
+        std::vector<LogRecord>   m_batch;
+        std::string              m_outText;
+        std::string              m_errText;
+
+        std::thread              m_thread;
+        std::mutex               m_wakeMutex;
+        std::condition_variable  m_wakeCondition;
+        bool                     m_stop = false;
+    };
+}
+
+// -----------------------------------------------------------------------------
+// Logger
+// -----------------------------------------------------------------------------
+LogRecord* Logger::beginRecord(LogLevel level, const char* fmt)
+{
+    LogBackend& backend = LogBackend::get();
+
+    LogRecord* rec = nullptr;
+    if (backend.isAsync())
+    {
+        ThreadRing* ring = t_ring.ring;
+        if (!ring) {
+            ring = t_ring.ring = backend.registerThread();
+        }
+
+        uint32_t h = ring->head.load(std::memory_order_relaxed);
+        if (h - ring->tail.load(std::memory_order_acquire) >= RING_CAPACITY) {
+            backend.countDrop(); // never block the caller
+            return nullptr;
+        }
+        rec = &ring->slots[h & RING_MASK];
+        rec->threadIndex = ring->threadIndex;
+    }
+    else
+    {
+        rec = &t_syncRecord;
+        rec->threadIndex = t_ring.ring ? t_ring.ring->threadIndex : 0;
+    }
+
+    rec->timestampNs = nowNs();
+    rec->fmt = fmt;
+    rec->level = (uint8_t)level;
+    rec->argCount = 0;
+    rec->payloadSize = 0;
+    return rec;
+}
+
+void Logger::commitRecord(LogRecord* rec)
+{
+    LogBackend& backend = LogBackend::get();
+    if (rec == &t_syncRecord) {
+        backend.writeNow(*rec);
+        return;
+    }
+
+    ThreadRing* ring = t_ring.ring;
+    ring->head.store(ring->head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+
+    // Errors shouldn't sit in the queue waiting for the next tick
+    if (rec->level >= (uint8_t)LogLevel::Error) {
+        backend.wake();
+    }
+}
 
 void Logger::Info(const std::string& msg)
 {
-    std::cout << "[INFO] " << msg << std::endl;
+    if (isEnabled(LogLevel::Info)) log(LogLevel::Info, "{}", msg);
 }
 
 void Logger::Error(const std::string& msg)
 {
-    std::cerr << "[ERROR] " << msg << std::endl;
+    if (isEnabled(LogLevel::Error)) log(LogLevel::Error, "{}", msg);
+}
+
+void Logger::flush()
+{
+    LogBackend::get().drain();
+}
+
+void Logger::shutdown()
+{
+    LogBackend::get().shutdown();
+}
+
+uint64_t Logger::getDroppedCount()
+{
+    return LogBackend::get().getDropped();
 }
@@ -1,11 +1,250 @@
 #pragma once
 
 #include <string>
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <type_traits>
 
+/**
+ * Log levels, lowest to highest. Off disables everything.
+ */
+enum class LogLevel : int
+{
+    Trace = 0,
+    Debug = 1,
+    Info = 2,
+    Warn = 3,
+    Error = 4,
+    Off = 5
+};
+
+// Numeric versions for the preprocessor (keep in sync with LogLevel)
+#define LOG_LEVEL_TRACE 0
+#define LOG_LEVEL_DEBUG 1
+#define LOG_LEVEL_INFO  2
+#define LOG_LEVEL_WARN  3
+#define LOG_LEVEL_ERROR 4
+#define LOG_LEVEL_OFF   5
+
+/**
+ * Compile-time filter: anything below this level compiles to nothing
+ * (arguments aren't even evaluated). Override per project if needed.
+ */
+#ifndef LOG_COMPILE_LEVEL
+#  ifdef NDEBUG
+#    define LOG_COMPILE_LEVEL LOG_LEVEL_INFO
+#  else
+#    define LOG_COMPILE_LEVEL LOG_LEVEL_DEBUG
+#  endif
+#endif
+
+namespace LogDetail
+{
+    // Size of one queued record. Arguments that don't fit are truncated.
+    static const size_t RECORD_SIZE = 256;
+    static const size_t PAYLOAD_SIZE = RECORD_SIZE - 24;
+
+    enum ArgType : uint8_t
+    {
+        ARG_I64 = 0,
+        ARG_U64,
+        ARG_F64,
+        ARG_BOOL,
+        ARG_CHAR,
+        ARG_STR,  // u16 length + bytes, copied
+        ARG_PTR
+    };
+
+    /**
+     * One log call, binary encoded. The format string is NOT copied,
+     * so it must be a string literal (or otherwise outlive the flush).
+     */
+    struct LogRecord
+    {
+        uint64_t    timestampNs = 0;
+        const char* fmt = nullptr;
+        uint32_t    threadIndex = 0;
+        uint8_t     level = 0;
+        uint8_t     argCount = 0;
+        uint16_t    payloadSize = 0;
+        uint8_t     payload[PAYLOAD_SIZE];
+    };
+
+    /**
+     * Appends type-tagged arguments to a record's payload.
+     * Once an argument doesn't fit, the rest are dropped.
+     */
+    class Encoder
+    {
+    public:
+        Encoder(uint8_t* buf, size_t cap) : m_buf(buf), m_cap(cap) {}
+
+        void writeI64(int64_t v) { writeRaw(ARG_I64, &v, sizeof(v)); }
+        void writeU64(uint64_t v) { writeRaw(ARG_U64, &v, sizeof(v)); }
+        void writeF64(double v) { writeRaw(ARG_F64, &v, sizeof(v)); }
+        void writeBool(bool v) { uint8_t b = v ? 1 : 0; writeRaw(ARG_BOOL, &b, 1); }
+        void writeChar(char c) { writeRaw(ARG_CHAR, &c, 1); }
+        void writePtr(const void* p) { uint64_t v = (uint64_t)(uintptr_t)p; writeRaw(ARG_PTR, &v, sizeof(v)); }
+        void writeStr(const char* s, size_t len);
+
+        size_t  size() const { return m_size; }
+        uint8_t count() const { return m_count; }
+
+    private:
+        void writeRaw(ArgType type, const void* data, size_t len)
+        {
+            if (m_full || m_size + 1 + len > m_cap) { m_full = true; return; }
+            m_buf[m_size++] = type;
+            std::memcpy(m_buf + m_size, data, len);
+            m_size += len;
+            m_count++;
+        }
+
+        uint8_t* m_buf;
+        size_t   m_cap;
+        size_t   m_size = 0;
+        uint8_t  m_count = 0;
+        bool     m_full = false;
+    };
+
+    // --- Argument encoding overloads ---
+    template<class T>
+    typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value
+        && !std::is_same<T, char>::value>::type
+        encodeArg(Encoder& e, T v) { e.writeI64((int64_t)v); }
+
+    template<class T>
+    typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value
+        && !std::is_same<T, bool>::value>::type
+        encodeArg(Encoder& e, T v) { e.writeU64((uint64_t)v); }
+
+    template<class T>
+    typename std::enable_if<std::is_floating_point<T>::value>::type
+        encodeArg(Encoder& e, T v) { e.writeF64((double)v); }
+
+    template<class T>
+    typename std::enable_if<std::is_enum<T>::value>::type
+        encodeArg(Encoder& e, T v) { e.writeI64((int64_t)v); }
+
+    inline void encodeArg(Encoder& e, bool v) { e.writeBool(v); }
+    inline void encodeArg(Encoder& e, char v) { e.writeChar(v); }
+    inline void encodeArg(Encoder& e, const char* s) { e.writeStr(s ? s : "(null)", s ? std::strlen(s) : 6); }
+    inline void encodeArg(Encoder& e, const std::string& s) { e.writeStr(s.data(), s.size()); }
+    inline void encodeArg(Encoder& e, const void* p) { e.writePtr(p); }
+
+    inline void encodeAll(Encoder&) {}
+
+    template<class T, class... Rest>
+    void encodeAll(Encoder& e, const T& first, const Rest&... rest)
+    {
+        encodeArg(e, first);
+        encodeAll(e, rest...);
+    }
+}
+
+/**
+ * Asynchronous logger.
+ *
+ * Each thread writes into its own lock-free single-producer ring of
+ * fixed-size records. Arguments are stored binary encoded and only turned
+ * into text by a background flusher thread, which merges all rings in
+ * timestamp order and writes them in batches. A log call on a hot path is
+ * a timestamp, a few memcpys and one atomic store; if a ring is full the
+ * record is dropped (and counted) rather than blocking the caller.
+ *
+ * Format strings use "{}" placeholders:
+ *     LOG_DEBUG("Creating chunk at ({}, {}, {})", cx, cy, cz);
+ *
+ * Prefer the LOG_* macros: they add compile-time filtering (LOG_COMPILE_LEVEL)
+ * on top of the runtime level (setLevel).
+ */
 class Logger
 {
 public:
+    // Legacy string API (formats on the caller, still queued asynchronously)
     static void Info(const std::string& msg);
     static void Error(const std::string& msg);
-    // etc.
+
+    /**
+     * Queues one record. 'fmt' must outlive the flush (use string literals).
+     */
+    template<class... Args>
+    static void log(LogLevel level, const char* fmt, const Args&... args)
+    {
+        LogDetail::LogRecord* rec = beginRecord(level, fmt);
+        if (!rec) return;
+        LogDetail::Encoder enc(rec->payload, LogDetail::PAYLOAD_SIZE);
+        LogDetail::encodeAll(enc, args...);
+        rec->argCount = enc.count();
+        rec->payloadSize = (uint16_t)enc.size();
+        commitRecord(rec);
+    }
+
+    static bool isEnabled(LogLevel level)
+    {
+        return (int)level >= s_runtimeLevel.load(std::memory_order_relaxed);
+    }
+
+    static void     setLevel(LogLevel level) { s_runtimeLevel.store((int)level, std::memory_order_relaxed); }
+    static LogLevel getLevel() { return (LogLevel)s_runtimeLevel.load(std::memory_order_relaxed); }
+
+    /**
+     * Blocks until everything queued so far has been written out.
+     */
+    static void flush();
+
+    /**
+     * Flushes, stops the background thread and switches to synchronous
+     * output for any stragglers. Call once at application exit.
+     */
+    static void shutdown();
+
+    /**
+     * Records dropped because a thread's ring was full.
+     */
+    static uint64_t getDroppedCount();
+
+private:
+    static LogDetail::LogRecord* beginRecord(LogLevel level, const char* fmt);
+    static void                  commitRecord(LogDetail::LogRecord* rec);
+
+    static std::atomic<int> s_runtimeLevel;
 };
+
+// -----------------------------------------------------------------------------
+// Macros
+// -----------------------------------------------------------------------------
+#define LOG_AT(level, ...) \
+    do { if (Logger::isEnabled(level)) Logger::log(level, __VA_ARGS__); } while (0)
+
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_TRACE
+#  define LOG_TRACE(...) LOG_AT(LogLevel::Trace, __VA_ARGS__)
+#else
+#  define LOG_TRACE(...) ((void)0)
+#endif
+
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_DEBUG
+#  define LOG_DEBUG(...) LOG_AT(LogLevel::Debug, __VA_ARGS__)
+#else
+#  define LOG_DEBUG(...) ((void)0)
+#endif
+
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_INFO
+#  define LOG_INFO(...) LOG_AT(LogLevel::Info, __VA_ARGS__)
+#else
+#  define LOG_INFO(...) ((void)0)
+#endif
+
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_WARN
+#  define LOG_WARN(...) LOG_AT(LogLevel::Warn, __VA_ARGS__)
+#else
+#  define LOG_WARN(...) ((void)0)
+#endif
+
+#if LOG_COMPILE_LEVEL <= LOG_LEVEL_ERROR
+#  define LOG_ERROR(...) LOG_AT(LogLevel::Error, __VA_ARGS__)
+#else
+#  define LOG_ERROR(...) ((void)0)
+#endif
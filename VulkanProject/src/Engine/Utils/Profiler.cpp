@@ -0,0 +1,431 @@
+#include "Profiler.h"
+
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <chrono>
+#include <algorithm>
+
+#ifdef __linux__
+#include <pthread.h>
+#endif
+
+// -----------------------------------------------------------------------------
+// Per-thread buffers
+//  Only the owning thread writes its buffer, without locking. Readers
+//  (collectStats, dumpChromeTrace) see it through atomics: nodes are
+//  published by linking them into their parent, trace slots are guarded by
+//  the writeHead / head sequence pair, and resetStats asks each owner to
+//  clear its own counters (statsEpoch).
+// -----------------------------------------------------------------------------
+namespace
+{
+    // Zone nodes per thread; zones past this count only as trace events
+    const int MAX_ZONE_NODES = 1024;
+
+    struct ZoneNode
+    {
+        const char*           name = nullptr; // set before the node is linked
+        std::atomic<int>      firstChild{ -1 };
+        std::atomic<int>      nextSibling{ -1 };
+        std::atomic<uint64_t> calls{ 0 };
+        std::atomic<uint64_t> totalNs{ 0 };
+        std::atomic<uint64_t> maxNs{ 0 };
+    };
+
+    struct OpenZone
+    {
+        const char* name;
+        int         node;
+        uint64_t    startNs;
+    };
+
+    struct TraceEvent
+    {
+        const char* name;
+        uint64_t    startNs;
+        uint32_t    durNs;   // clamped to ~4.29 s
+        uint16_t    depth;
+    };
+
+    struct TraceSlot
+    {
+        std::atomic<const char*> name{ nullptr };
+        std::atomic<uint64_t>    startNs{ 0 };
+        std::atomic<uint32_t>    durNs{ 0 };
+        std::atomic<uint16_t>    depth{ 0 };
+    };
+
+    struct ThreadProfile
+    {
+        std::mutex            nameMutex; // setThreadName vs. readers
+        std::string           name;
+        uint32_t              index = 0;
+
+        std::unique_ptr<ZoneNode[]> nodes; // [0] is the root (no zone)
+        int                   nodeCount = 1;
+        std::vector<OpenZone> stack;
+        std::atomic<uint32_t> statsEpoch{ 0 };
+
+        // Event i lives in ring[i % TRACE_RING_SIZE]. writeHead is bumped
+        // before a slot is overwritten, head once it holds the new event.
+        std::unique_ptr<TraceSlot[]> ring;
+        std::atomic<uint64_t> writeHead{ 0 };
+        std::atomic<uint64_t> head{ 0 };
+    };
+
+    struct Registry
+    {
+        std::mutex                  mutex;
+        std::vector<ThreadProfile*> threads; // never freed: stats outlive their threads
+        std::atomic<uint32_t>       statsEpoch{ 0 };
+    };
+
+    Registry& registry()
+    {
+        static Registry* s_registry = new Registry();
+        return *s_registry;
+    }
+
+    void snapshotThreads(std::vector<ThreadProfile*>& out)
+    {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        out.reserve(reg.threads.size());
+        out.assign(reg.threads.begin(), reg.threads.end());
+    }
+
+    uint64_t nowNs()
+    {
+        typedef std::chrono::steady_clock Clock;
+        static const Clock::time_point s_epoch = Clock::now();
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - s_epoch).count();
+    }
+
+    thread_local ThreadProfile* t_profile = nullptr;
+
+    ThreadProfile& threadProfile()
+    {
+        if (t_profile) return *t_profile;
+
+        ThreadProfile* tp = new ThreadProfile();
+        tp->nodes.reset(new ZoneNode[MAX_ZONE_NODES]);
+        tp->ring.reset(new TraceSlot[Profiler::TRACE_RING_SIZE]);
+        tp->stack.reserve(64);
+
+        Registry& reg = registry();
+        {
+            std::lock_guard<std::mutex> lock(reg.mutex);
+            tp->index = (uint32_t)reg.threads.size();
+            tp->statsEpoch.store(reg.statsEpoch.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            reg.threads.push_back(tp);
+        }
+        {
+            std::lock_guard<std::mutex> lock(tp->nameMutex);
+            tp->name = "Thread " + std::to_string(tp->index);
+        }
+
+        t_profile = tp;
+        return *tp;
+    }
+
+    // Owner only: single writer, so plain load + store is enough
+    void addRelaxed(std::atomic<uint64_t>& a, uint64_t v)
+    {
+        a.store(a.load(std::memory_order_relaxed) + v, std::memory_order_relaxed);
+    }
+
+    // ---- Merged view used by collectStats ----
+    struct MergedNode
+    {
+        const char*             name = nullptr;
+        uint64_t                calls = 0;
+        uint64_t                totalNs = 0;
+        uint64_t                maxNs = 0;
+        std::vector<MergedNode> children;
+    };
+
+    void mergeInto(MergedNode& dst, const ThreadProfile& tp, int nodeIndex)
+    {
+        for (int childIndex = tp.nodes[nodeIndex].firstChild.load(std::memory_order_acquire);
+            childIndex >= 0;
+            childIndex = tp.nodes[childIndex].nextSibling.load(std::memory_order_relaxed))
+        {
+            const ZoneNode& src = tp.nodes[childIndex];
+
+            MergedNode* target = nullptr;
+            for (MergedNode& m : dst.children) {
+                if (m.name == src.name || std::strcmp(m.name, src.name) == 0) { target = &m; break; }
+            }
+            if (!target) {
+                dst.children.push_back(MergedNode());
+                target = &dst.children.back();
+                target->name = src.name;
+            }
+
+            target->calls += src.calls.load(std::memory_order_relaxed);
+            target->totalNs += src.totalNs.load(std::memory_order_relaxed);
+            target->maxNs = std::max(target->maxNs, src.maxNs.load(std::memory_order_relaxed));
+            mergeInto(*target, tp, childIndex);
+        }
+    }
+
+    void flatten(MergedNode& node, const std::string& threadName, int depth, std::vector<ProfileStatRow>& out)
+    {
+        std::sort(node.children.begin(), node.children.end(),
+            [](const MergedNode& a, const MergedNode& b) { return a.totalNs > b.totalNs; });
+
+        for (MergedNode& child : node.children)
+        {
+            if (child.calls == 0 && child.children.empty()) continue;
+
+            uint64_t childrenNs = 0;
+            for (const MergedNode& grandChild : child.children) {
+                childrenNs += grandChild.totalNs;
+            }
+
+            ProfileStatRow row;
+            row.threadName = threadName;
+            row.zoneName = child.name;
+            row.depth = depth;
+            row.calls = child.calls;
+            row.totalMs = child.totalNs / 1.0e6;
+            row.avgMs = child.calls ? row.totalMs / (double)child.calls : 0.0;
+            row.maxMs = child.maxNs / 1.0e6;
+            row.selfMs = (child.totalNs > childrenNs ? child.totalNs - childrenNs : 0) / 1.0e6;
+            out.push_back(row);
+
+            flatten(child, threadName, depth + 1, out);
+        }
+    }
+
+    void writeJsonString(FILE* f, const char* s)
+    {
+        std::fputc('"', f);
+        for (; *s; ++s)
+        {
+            unsigned char c = (unsigned char)*s;
+            if (c == '"' || c == '\\') { std::fputc('\\', f); std::fputc(c, f); }
+            else if (c < 0x20) { std::fprintf(f, "\\u%04x", c); }
+            else { std::fputc(c, f); }
+        }
+        std::fputc('"', f);
+    }
+}
+
+// -----------------------------------------------------------------------------
+// Recording
+// -----------------------------------------------------------------------------
+void Profiler::setThreadName(const char* name)
+{
+    ThreadProfile& tp = threadProfile();
+    {
+        std::lock_guard<std::mutex> lock(tp.nameMutex);
+        tp.name = name;
+    }
+
+#ifdef __linux__
+    // Shows up in /proc (CpuProfiler's per-thread view) and debuggers; 15 chars max
+    char shortName[16];
+    std::snprintf(shortName, sizeof(shortName), "%s", name);
+    pthread_setname_np(pthread_self(), shortName);
+#endif
+}
+
+void Profiler::beginZone(const char* name)
+{
+    ThreadProfile& tp = threadProfile();
+
+    int parent = tp.stack.empty() ? 0 : tp.stack.back().node;
+
+    // Same zone under the same parent => same node (pointer compare is enough
+    // for a given call site; different literals just make sibling nodes)
+    int node = -1;
+    for (int child = tp.nodes[parent].firstChild.load(std::memory_order_relaxed); child >= 0;
+        child = tp.nodes[child].nextSibling.load(std::memory_order_relaxed))
+    {
+        if (tp.nodes[child].name == name) { node = child; break; }
+    }
+    if (node < 0)
+    {
+        if (tp.nodeCount < MAX_ZONE_NODES)
+        {
+            // Fill in, then link: readers find it through the parent
+            node = tp.nodeCount++;
+            ZoneNode& zn = tp.nodes[node];
+            zn.name = name;
+            zn.nextSibling.store(tp.nodes[parent].firstChild.load(std::memory_order_relaxed),
+                std::memory_order_relaxed);
+            tp.nodes[parent].firstChild.store(node, std::memory_order_release);
+        }
+        else {
+            node = 0; // full: traced, but not in the stats
+        }
+    }
+
+    OpenZone open;
+    open.name = name;
+    open.node = node;
+    open.startNs = nowNs();
+    tp.stack.push_back(open);
+}
+
+void Profiler::endZone()
+{
+    uint64_t endNs = nowNs();
+
+    ThreadProfile& tp = threadProfile();
+    if (tp.stack.empty()) return;
+
+    OpenZone open = tp.stack.back();
+    tp.stack.pop_back();
+
+    // resetStats happened: clear our counters before adding to them
+    const uint32_t epoch = registry().statsEpoch.load(std::memory_order_acquire);
+    if (tp.statsEpoch.load(std::memory_order_relaxed) != epoch)
+    {
+        for (int i = 0; i < tp.nodeCount; i++)
+        {
+            tp.nodes[i].calls.store(0, std::memory_order_relaxed);
+            tp.nodes[i].totalNs.store(0, std::memory_order_relaxed);
+            tp.nodes[i].maxNs.store(0, std::memory_order_relaxed);
+        }
+        tp.statsEpoch.store(epoch, std::memory_order_release);
+    }
+
+    uint64_t dur = endNs - open.startNs;
+    ZoneNode& zn = tp.nodes[open.node];
+    addRelaxed(zn.calls, 1);
+    addRelaxed(zn.totalNs, dur);
+    if (dur > zn.maxNs.load(std::memory_order_relaxed)) {
+        zn.maxNs.store(dur, std::memory_order_relaxed);
+    }
+
+    // Claim the slot, write it, publish it
+    const uint64_t h = tp.head.load(std::memory_order_relaxed);
+    tp.writeHead.store(h + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    TraceSlot& slot = tp.ring[h % TRACE_RING_SIZE];
+    slot.name.store(open.name, std::memory_order_relaxed);
+    slot.startNs.store(open.startNs, std::memory_order_relaxed);
+    slot.durNs.store((uint32_t)std::min<uint64_t>(dur, 0xFFFFFFFFull), std::memory_order_relaxed);
+    slot.depth.store((uint16_t)tp.stack.size(), std::memory_order_relaxed);
+    tp.head.store(h + 1, std::memory_order_release);
+}
+
+// -----------------------------------------------------------------------------
+// Reporting
+// -----------------------------------------------------------------------------
+void Profiler::collectStats(std::vector<ProfileStatRow>& outRows)
+{
+    outRows.clear();
+
+    std::vector<ThreadProfile*> threads;
+    snapshotThreads(threads);
+    const uint32_t epoch = registry().statsEpoch.load(std::memory_order_acquire);
+
+    // One merged tree per thread name, in registration order
+    std::vector<std::string> groupNames;
+    std::vector<MergedNode>  groupRoots;
+    for (ThreadProfile* tp : threads)
+    {
+        std::string name;
+        {
+            std::lock_guard<std::mutex> lock(tp->nameMutex);
+            name = tp->name;
+        }
+
+        size_t g = 0;
+        while (g < groupNames.size() && groupNames[g] != name) g++;
+        if (g == groupNames.size()) {
+            groupNames.push_back(name);
+            groupRoots.push_back(MergedNode());
+        }
+
+        // Counters from before the last reset that the owner hasn't cleared yet
+        if (tp->statsEpoch.load(std::memory_order_acquire) != epoch) continue;
+        mergeInto(groupRoots[g], *tp, 0);
+    }
+
+    for (size_t g = 0; g < groupNames.size(); g++) {
+        flatten(groupRoots[g], groupNames[g], 0, outRows);
+    }
+}
+
+void Profiler::resetStats()
+{
+    // Each thread clears its own counters at its next endZone; until then
+    // collectStats leaves it out. The tree shape stays, open zones still
+    // point at their nodes.
+    registry().statsEpoch.fetch_add(1, std::memory_order_acq_rel);
+}
+
+bool Profiler::dumpChromeTrace(const std::string& path, size_t* outEventCount)
+{
+    std::vector<ThreadProfile*> threads;
+    snapshotThreads(threads);
+
+    FILE* f = std::fopen(path.c_str(), "w");
+    if (!f) return false;
+
+    size_t eventCount = 0;
+    bool first = true;
+    std::vector<TraceEvent> events;
+
+    std::fputs("{\"traceEvents\":[\n", f);
+    for (ThreadProfile* tp : threads)
+    {
+        std::string threadName;
+        {
+            std::lock_guard<std::mutex> lock(tp->nameMutex);
+            threadName = tp->name;
+        }
+
+        // Copy the ring, then drop whatever the owner may have started
+        // overwriting meanwhile (seqlock-style check on writeHead)
+        const uint64_t head = tp->head.load(std::memory_order_acquire);
+        const uint64_t begin = (head > TRACE_RING_SIZE) ? head - TRACE_RING_SIZE : 0;
+        events.clear();
+        for (uint64_t i = begin; i < head; i++)
+        {
+            const TraceSlot& slot = tp->ring[i % TRACE_RING_SIZE];
+            TraceEvent ev;
+            ev.name = slot.name.load(std::memory_order_relaxed);
+            ev.startNs = slot.startNs.load(std::memory_order_relaxed);
+            ev.durNs = slot.durNs.load(std::memory_order_relaxed);
+            ev.depth = slot.depth.load(std::memory_order_relaxed);
+            events.push_back(ev);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const uint64_t writeHead = tp->writeHead.load(std::memory_order_relaxed);
+        const uint64_t firstValid = (writeHead > TRACE_RING_SIZE) ? writeHead - TRACE_RING_SIZE : 0;
+        const size_t skip = (size_t)std::min<uint64_t>(firstValid > begin ? firstValid - begin : 0, events.size());
+
+        // Thread name metadata so the viewer labels the tracks
+        std::fprintf(f, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":",
+            first ? "" : ",\n", tp->index);
+        writeJsonString(f, threadName.c_str());
+        std::fputs("}}", f);
+        first = false;
+
+        for (size_t i = skip; i < events.size(); i++)
+        {
+            const TraceEvent& ev = events[i];
+            std::fputs(",\n{\"name\":", f);
+            writeJsonString(f, ev.name);
+            std::fprintf(f, ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+                ev.startNs / 1000.0, ev.durNs / 1000.0, tp->index);
+            eventCount++;
+        }
+    }
+    std::fputs("\n],\"displayTimeUnit\":\"ms\"}\n", f);
+
+    bool ok = (std::ferror(f) == 0);
+    std::fclose(f);
+
+    if (outEventCount) *outEventCount = eventCount;
+    return ok;
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+/**
+ * Compile-time switch. With ENABLE_PROFILER 0, PROFILE_ZONE expands to
+ * nothing and the profiler costs nothing.
+ */
+#ifndef ENABLE_PROFILER
+#  define ENABLE_PROFILER 1
+#endif
+
+/**
+ * One row of the aggregated zone tree, flattened depth-first.
+ * Threads with the same name (e.g. all pool workers) are merged.
+ */
+struct ProfileStatRow
+{
+    std::string threadName;
+    const char* zoneName = nullptr;
+    int         depth = 0;       // 0 = top-level zone on that thread
+    uint64_t    calls = 0;
+    double      totalMs = 0.0;
+    double      avgMs = 0.0;
+    double      maxMs = 0.0;
+    double      selfMs = 0.0;    // total minus time spent in child zones
+};
+
+/**
+ * Hierarchical scoped-zone CPU profiler.
+ *
+ * Every thread records into its own buffer: a call tree of zone statistics
+ * (keyed by the path of enclosing zones) and a ring of the most recent
+ * completed zones for trace export. Only the owning thread writes its
+ * buffer, without taking a lock; readers synchronize through atomics when
+ * collecting stats or dumping a trace. resetStats() is applied by each
+ * thread at its next zone end.
+ *
+ * Zone names are stored by pointer: use string literals.
+ *
+ *     void TerrainGenerator::generateChunk(...)
+ *     {
+ *         PROFILE_ZONE("Generate Chunk");
+ *         ...
+ *     }
+ */
+class Profiler
+{
+public:
+    /// Names the calling thread in stats and traces (default "Thread N").
+    static void setThreadName(const char* name);
+
+    static void beginZone(const char* name);
+    static void endZone();
+
+    /// Snapshot of the zone tree of every thread, merged by thread name.
+    static void collectStats(std::vector<ProfileStatRow>& outRows);
+
+    /// Clears accumulated statistics (trace rings are kept).
+    static void resetStats();
+
+    /**
+     * Writes the recent zones of every thread as Chrome trace JSON
+     * (chrome://tracing, Perfetto). Returns false if the file can't be opened.
+     */
+    static bool dumpChromeTrace(const std::string& path, size_t* outEventCount = nullptr);
+
+    /// Completed zones kept per thread for dumpChromeTrace.
+    static const size_t TRACE_RING_SIZE = 16384;
+};
+
+/**
+ * RAII helper behind PROFILE_ZONE.
+ */
+class ProfileZone
+{
+public:
+    explicit ProfileZone(const char* name) { Profiler::beginZone(name); }
+    ~ProfileZone() { Profiler::endZone(); }
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+};
+
+// -----------------------------------------------------------------------------
+// Macros
+// -----------------------------------------------------------------------------
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#if ENABLE_PROFILER
+#  define PROFILE_ZONE(name) ProfileZone PROFILE_CONCAT(profileZone_, __LINE__)(name)
+#else
+#  define PROFILE_ZONE(name) ((void)0)
+#endif
@@ -1,5 +1,6 @@
 #include "ThreadPool.h"
 #include <iostream> // optional, for debug logs if needed
+#include "Profiler.h"
 
 ThreadPool::ThreadPool(size_t threadCount)
 {
@@ -66,6 +67,9 @@ void ThreadPool::shutdown()
 
 void ThreadPool::workerThreadFunc()
 {
+    // All workers share one name so the profiler merges their zone trees
+    Profiler::setThreadName("Worker");
+
     while (true)
     {
         std::function<void()> task;
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "VoxelPropertyTable.h"
+
+/**
+ * The built-in voxel types, known at compile time. registerAllVoxels()
+ * registers them first and in this order, so these constants are their
+ * IDs. Code that only deals with built-ins (terrain generation, culling
+ * rules) can use the constexpr queries and have them folded; anything
+ * that must also handle registered types goes through VoxelPropertyTable.
+ */
+namespace BuiltinVoxels
+{
+    enum : int
+    {
+        AIR = 0,
+        STONE,
+        GRASS,
+        DIRT,
+        WATER,
+        COUNT
+    };
+
+    struct Definition
+    {
+        const char* name;
+        bool        solid;
+        bool        liquid;
+        float       r, g, b;
+    };
+
+    constexpr Definition TYPES[COUNT] = {
+        { "Air",   false, false, 0.0f, 0.0f, 0.0f }, // color unused
+        { "Stone", true,  false, 0.5f, 0.5f, 0.5f },
+        { "Grass", true,  false, 0.1f, 1.0f, 0.1f },
+        { "Dirt",  true,  false, 0.6f, 0.4f, 0.2f },
+        { "Water", false, true,  0.0f, 0.3f, 0.8f },
+    };
+
+    constexpr bool isSolid(int id) { return TYPES[id].solid; }
+    constexpr bool isLiquid(int id) { return TYPES[id].liquid; }
+
+    /// Same rule as VoxelPropertyTable::build
+    constexpr VoxelCullClass cullClass(int id)
+    {
+        return TYPES[id].solid ? VoxelCullClass::Opaque
+            : (id == AIR ? VoxelCullClass::Empty : VoxelCullClass::Translucent);
+    }
+
+    static_assert(cullClass(AIR) == VoxelCullClass::Empty, "Air must not produce faces");
+    static_assert(cullClass(STONE) == VoxelCullClass::Opaque, "Terrain must occlude");
+    static_assert(cullClass(WATER) == VoxelCullClass::Translucent, "Water is see-through");
+}
@@ -1,5 +1,8 @@
 #include "Chunk.h"
+#include "VoxelStats.h"
 #include <stdexcept>
+#include <string>
+#include <algorithm>
 #include <cstddef>       // for size_t
 #include <glm/vec3.hpp>
 #include <utility>       // for std::pair
@@ -14,6 +17,7 @@ Chunk::Chunk(int worldX, int worldY, int worldZ)
         * static_cast<size_t>(SIZE_Y)
         * static_cast<size_t>(SIZE_Z);
     m_blocks.resize(total, 0); // 0 => "Air"
+    m_typeCounts[0] = VOLUME;
 
     // By default, LOD dirty flags are set to true in the initializer list.
     // Seam data is also defaulted to invalid. No special code needed here.
@@ -21,6 +25,8 @@ Chunk::Chunk(int worldX, int worldY, int worldZ)
 
 Chunk::~Chunk()
 {
+    setStats(nullptr);
+
     // Typically, GPU buffer destruction is done externally (e.g. VoxelWorld).
     // If you wanted to unify that destruction here, you could do it, but 
     // its more common to let the manager or VoxelWorld handle it.
@@ -54,6 +60,9 @@ void Chunk::setBlock(int x, int y, int z, int voxelID)
     {
         return;
     }
+    if (voxelID < 0 || voxelID >= MAX_VOXEL_TYPES) {
+        throw std::runtime_error("Voxel ID out of range: " + std::to_string(voxelID));
+    }
 
     // Flatten index
     size_t idx = static_cast<size_t>(x)
@@ -66,11 +75,133 @@ void Chunk::setBlock(int x, int y, int z, int voxelID)
     if (oldVal != voxelID)
     {
         m_blocks[idx] = voxelID;
-        // Mark all LOD levels dirty
-        markAllLODsDirty();
-        // Potentially mark all seams dirty as well, since block changes
-        // might affect boundary transitions. Thats optional:
-        // markAllSeamsDirty();
+        m_version.fetch_add(1, std::memory_order_release);
+        m_typeCounts[oldVal]--;
+        m_typeCounts[voxelID]++;
+        if (m_stats) {
+            m_stats->onBlockChanged(oldVal, voxelID);
+        }
+        // LOD0 re-meshes the slices around the voxel, coarser LODs rebuild
+        markSlicesDirty(x, y, z);
+        for (int level = 1; level < MAX_LOD_LEVELS; level++) {
+            m_lodDirty[level] = true;
+        }
+        // Seams pick the change up through the version (VoxelWorld::scheduleSeamBuilds)
+    }
+}
+
+void Chunk::assignBlocks(const int* blocks)
+{
+    uint16_t newCounts[MAX_VOXEL_TYPES] = {};
+    for (int i = 0; i < VOLUME; i++)
+    {
+        int id = blocks[i];
+        if (id < 0 || id >= MAX_VOXEL_TYPES) {
+            throw std::runtime_error("Voxel ID out of range: " + std::to_string(id));
+        }
+        newCounts[id]++;
+    }
+
+    // Copy into the existing storage; a mesh job may be reading it
+    std::copy(blocks, blocks + VOLUME, m_blocks.begin());
+    m_version.fetch_add(1, std::memory_order_release);
+
+    for (int id = 0; id < MAX_VOXEL_TYPES; id++)
+    {
+        int delta = int(newCounts[id]) - int(m_typeCounts[id]);
+        if (delta != 0 && m_stats) {
+            m_stats->addVoxels(id, delta);
+        }
+        m_typeCounts[id] = newCounts[id];
+    }
+    markAllLODsDirty();
+}
+
+int Chunk::getUniformBlock() const
+{
+    for (int id = 0; id < MAX_VOXEL_TYPES; id++)
+    {
+        if (m_typeCounts[id] == VOLUME) return id;
+        if (m_typeCounts[id] != 0) return -1;
+    }
+    return -1;
+}
+
+void Chunk::setStats(VoxelStats* stats)
+{
+    if (m_stats == stats) return;
+
+    if (m_stats)
+    {
+        for (int id = 0; id < MAX_VOXEL_TYPES; id++) {
+            if (m_typeCounts[id]) m_stats->addVoxels(id, -int64_t(m_typeCounts[id]));
+        }
+        m_stats->removeChunk(VOLUME);
+    }
+    m_stats = stats;
+    if (m_stats)
+    {
+        for (int id = 0; id < MAX_VOXEL_TYPES; id++) {
+            if (m_typeCounts[id]) m_stats->addVoxels(id, m_typeCounts[id]);
+        }
+        m_stats->addChunk(VOLUME);
+    }
+}
+
+void Chunk::copyMipLevel(int lod, MipReduction mode, const VoxelPropertyTable& props,
+    std::vector<int>& out) const
+{
+    static_assert(SIZE_X == SIZE_Y && SIZE_Y == SIZE_Z, "Mip chain needs cubic chunks");
+    static_assert(MAX_LOD_LEVELS <= 4, "VoxelMipChain holds at most 4 levels");
+
+    if (lod <= 0) {
+        out = m_blocks;
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mipMutex);
+    updateMipChain(mode, props);
+    const std::vector<uint8_t>& level = m_mips.levels[lod];
+    out.assign(level.begin(), level.end());
+}
+
+void Chunk::copyBoundaryLayer(int face, int lod, MipReduction mode, const VoxelPropertyTable& props,
+    std::vector<int>& out) const
+{
+    // In-plane axes per face axis, same as ChunkMesher's slices
+    static const int uAxes[3] = { 1, 0, 0 };
+    static const int vAxes[3] = { 2, 2, 1 };
+
+    const int n = SIZE_X >> lod;
+    const int axis = face / 2;
+    const int layer = (face % 2 == 0) ? n - 1 : 0;
+    out.resize((size_t)n * n);
+
+    std::unique_lock<std::mutex> lock(m_mipMutex, std::defer_lock);
+    const uint8_t* cells = nullptr;
+    if (lod > 0) {
+        lock.lock();
+        updateMipChain(mode, props);
+        cells = m_mips.levels[lod].data();
+    }
+
+    for (int v = 0; v < n; v++)
+    {
+        for (int u = 0; u < n; u++)
+        {
+            int p[3];
+            p[axis] = layer; p[uAxes[axis]] = u; p[vAxes[axis]] = v;
+            size_t idx = (size_t)p[0] + (size_t)n * ((size_t)p[1] + (size_t)n * p[2]);
+            out[(size_t)u + (size_t)n * v] = cells ? cells[idx] : m_blocks[idx];
+        }
+    }
+}
+
+void Chunk::updateMipChain(MipReduction mode, const VoxelPropertyTable& props) const
+{
+    uint32_t version = getVersion();
+    if (m_mips.version != version || m_mips.mode != mode) {
+        m_mips.build(m_blocks.data(), SIZE_X, MAX_LOD_LEVELS, mode, props, version);
     }
 }
 
@@ -81,6 +212,34 @@ void Chunk::markAllLODsDirty()
     }
 }
 
+// A +face on layer l looks at layer l + 1 and a -face at l - 1, so an
+// edit touches its own layer plus the one next to it in each direction.
+void Chunk::markSlicesDirty(int x, int y, int z)
+{
+    const int p[3] = { x, y, z };
+    for (int axis = 0; axis < 3; axis++)
+    {
+        uint32_t self = 1u << p[axis];
+        m_dirtySlices[axis * 2] |= uint16_t(self | (self >> 1));
+        m_dirtySlices[axis * 2 + 1] |= uint16_t(self | (self << 1));
+    }
+}
+
+bool Chunk::hasDirtySlices() const
+{
+    for (int face = 0; face < 6; face++) {
+        if (m_dirtySlices[face]) return true;
+    }
+    return false;
+}
+
+void Chunk::clearDirtySlices()
+{
+    for (int face = 0; face < 6; face++) {
+        m_dirtySlices[face] = 0;
+    }
+}
+
 void Chunk::getBoundingBox(glm::vec3& outMin, glm::vec3& outMax) const
 {
     float chunkOriginX = float(m_worldX * SIZE_X);
@@ -91,17 +250,56 @@ void Chunk::getBoundingBox(glm::vec3& outMin, glm::vec3& outMax) const
     outMax = outMin + glm::vec3(SIZE_X, SIZE_Y, SIZE_Z);
 }
 
-std::pair<size_t, size_t> Chunk::getVoxelUsage() const
+uint8_t MeshFaceRanges::facingMask(const glm::vec3& eye, const glm::vec3& minB, const glm::vec3& maxB)
+{
+    uint8_t mask = 0;
+    for (int axis = 0; axis < 3; axis++)
+    {
+        if (eye[axis] > minB[axis]) mask |= uint8_t(1u << (axis * 2));     // + faces
+        if (eye[axis] < maxB[axis]) mask |= uint8_t(1u << (axis * 2 + 1)); // - faces
+    }
+    return mask;
+}
+
+int MeshFaceRanges::visibleRanges(int pass, uint32_t passBegin, uint32_t passEnd, uint8_t faceMask,
+    uint32_t outFirst[MAX_RANGES], uint32_t outCount[MAX_RANGES]) const
 {
-    size_t activeCount = 0;
-    size_t emptyCount = 0;
+    int count = 0;
+    auto add = [&](uint32_t first, uint32_t end) {
+        if (first >= end) return;
+        if (count > 0 && outFirst[count - 1] + outCount[count - 1] == first) {
+            outCount[count - 1] += end - first;
+            return;
+        }
+        outFirst[count] = first;
+        outCount[count] = end - first;
+        count++;
+    };
 
-    for (int voxel : m_blocks)
+    if (!valid) {
+        add(passBegin, passEnd);
+        return count;
+    }
+    const uint32_t* s = start[pass];
+    for (int face = 0; face < FACE_COUNT; face++)
     {
-        if (voxel == 0)  // 0 => air
-            emptyCount++;
-        else
-            activeCount++;
+        if (faceMask & (1u << face)) {
+            add(s[face], s[face + 1]);
+        }
     }
-    return { activeCount, emptyCount };
+    add(s[FACE_COUNT], passEnd);
+    return count;
+}
+
+bool Meshlet::facesEye(const glm::vec3& eye) const
+{
+    if (face < 0) return true;
+    const int axis = face / 2;
+    return (face % 2 == 0) ? eye[axis] > minB[axis] : eye[axis] < maxB[axis];
+}
+
+std::pair<size_t, size_t> Chunk::getVoxelUsage() const
+{
+    size_t emptyCount = m_typeCounts[0]; // 0 => air
+    return { size_t(VOLUME) - emptyCount, emptyCount };
 }
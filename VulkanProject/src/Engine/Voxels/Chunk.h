@@ -1,22 +1,128 @@
 #pragma once
 
 #include <vector>
-#include <vulkan/vulkan.h>
 #include <glm/vec3.hpp>
 #include <utility> // for std::pair
+#include <cstdint>
+#include <cfloat>
+#include <atomic>
+#include <mutex>
+#include "ChunkVisibility.h"
+#include "LODDownsampler.h"
+
+struct GpuMesh; // owned by the world's MeshSink (see MeshSink.h)
+class VoxelStats;
+
+/**
+ * Where one slice's quads sit in a segmented LOD0 mesh (see
+ * ChunkMesher::buildSegmentedMesh): quad slots [first, first + capacity),
+ * the first `used` of them real, the rest degenerate.
+ */
+struct MeshSlice
+{
+    uint32_t first = 0;
+    uint16_t capacity = 0;
+    uint16_t used = 0;
+};
+
+/**
+ * Slice table of a segmented mesh. Slice (pass, face, layer) is
+ * slices[(pass * 6 + face) * Chunk::SIZE_X + layer], pass 0 holding the
+ * opaque quads and pass 1 the translucent ones. Each pass owns one slot
+ * range, opaque first: its slices' runs, then the spare slots
+ * [freeSlot[pass], passEnd[pass]) for slices that outgrow their own run.
+ */
+struct MeshSliceLayout
+{
+    static const int PASS_COUNT = 2;
+
+    std::vector<MeshSlice> slices;
+    uint32_t freeSlot[PASS_COUNT] = {};
+    uint32_t passEnd[PASS_COUNT] = {};
+
+    bool     empty() const { return slices.empty(); }
+    uint32_t slotCount() const { return passEnd[PASS_COUNT - 1]; }
+    void clear()
+    {
+        slices.clear();
+        for (int pass = 0; pass < PASS_COUNT; pass++) {
+            freeSlot[pass] = 0;
+            passEnd[pass] = 0;
+        }
+    }
+};
+
+/**
+ * Index ranges of a mesh by face direction (+X = 0 ... -Z = 5, as in
+ * Chunk::SeamDirection). Builders emit each pass face by face, so pass p's
+ * direction-f faces are indices [start[p][f], start[p][f + 1]). The rest
+ * of the pass, [start[p][FACE_COUNT], pass end), mixes all directions
+ * (the spare slots of a segmented mesh) and is drawn whenever the pass
+ * is. Without `valid` the ranges are unknown and the whole pass is drawn.
+ */
+struct MeshFaceRanges
+{
+    static const int FACE_COUNT = 6;
+    static const int MAX_RANGES = FACE_COUNT + 1; // per pass, see visibleRanges
+
+    uint32_t start[MeshSliceLayout::PASS_COUNT][FACE_COUNT + 1] = {};
+    bool     valid = false;
+
+    /**
+     * Face directions (bit f = direction f) that can face a viewer at `eye`
+     * for geometry inside [minB, maxB]. +X faces of the box all lie past
+     * minB.x, so with the eye at or below minB.x they are back faces;
+     * likewise for the other five.
+     */
+    static uint8_t facingMask(const glm::vec3& eye, const glm::vec3& minB, const glm::vec3& maxB);
+
+    /**
+     * Ranges of pass `pass` (indices [passBegin, passEnd)) to draw for the
+     * directions in `faceMask`, neighbouring ones merged into one. Writes
+     * at most MAX_RANGES (first, count) pairs and returns how many.
+     */
+    int visibleRanges(int pass, uint32_t passBegin, uint32_t passEnd, uint8_t faceMask,
+        uint32_t outFirst[MAX_RANGES], uint32_t outCount[MAX_RANGES]) const;
+};
+
+/**
+ * Up to MAX_QUADS consecutive quads of one pass and their bounding box,
+ * for culling parts of a mesh (see ChunkMesher::buildMeshlets). A meshlet
+ * stays inside one MeshFaceRanges range, so all its quads face `face`:
+ * the normal cone is that axis with no spread, and the backface test is
+ * a plane test against the box. Meshlets of the mixed tail have face -1
+ * (no cone). A box with minB > maxB holds only padding quads.
+ */
+struct Meshlet
+{
+    static const uint32_t MAX_QUADS = 128;
+
+    uint32_t  firstIndex = 0; // six indices per quad
+    uint32_t  indexCount = 0;
+    glm::vec3 minB = glm::vec3(FLT_MAX);
+    glm::vec3 maxB = glm::vec3(-FLT_MAX);
+    int       face = -1;
+
+    bool isEmpty() const { return minB.x > maxB.x; }
+
+    /// False if every quad is a back face for a viewer at `eye` (cf. MeshFaceRanges::facingMask)
+    bool facesEye(const glm::vec3& eye) const;
+};
 
 /**
- * Holds GPU buffer information for one LOD level.
- * Each LOD can have its own vertex/index buffers and counts.
+ * Holds GPU mesh information for one LOD level.
+ * Each LOD can have its own mesh and counts.
  */
 struct ChunkLODData {
-    VkBuffer       vertexBuffer = VK_NULL_HANDLE;
-    VkDeviceMemory vertexMemory = VK_NULL_HANDLE;
-    VkBuffer       indexBuffer = VK_NULL_HANDLE;
-    VkDeviceMemory indexMemory = VK_NULL_HANDLE;
+    GpuMesh*       mesh = nullptr;
     uint32_t       vertexCount = 0;
     uint32_t       indexCount = 0;
+    uint32_t       opaqueIndexCount = 0; // [0, this) opaque, the rest translucent
     bool           valid = false; // True if this LOD's mesh is uploaded
+    uint64_t       lastUsedFrame = 0; // Last frame it was drawn (MeshResidency LRU)
+    MeshSliceLayout slices;           // LOD0 only; empty unless the mesh is segmented
+    MeshFaceRanges faceRanges;        // per-direction ranges, for skipping back faces
+    std::vector<Meshlet> meshlets;    // both passes in index order, for culling inside the mesh
 };
 
 /**
@@ -27,14 +133,18 @@ struct ChunkLODData {
  * We'll keep one for each face (+X, -X, +Y, -Y, +Z, -Z).
  */
 struct ChunkSeamData {
-    VkBuffer       seamVertexBuffer = VK_NULL_HANDLE;
-    VkDeviceMemory seamVertexMemory = VK_NULL_HANDLE;
-    VkBuffer       seamIndexBuffer = VK_NULL_HANDLE;
-    VkDeviceMemory seamIndexMemory = VK_NULL_HANDLE;
+    GpuMesh*       mesh = nullptr;
     uint32_t       vertexCount = 0;
     uint32_t       indexCount = 0;
+    uint32_t       opaqueIndexCount = 0; // as in ChunkLODData
     bool           valid = false;
-    // Could also store neighbor info, LOD difference, etc.
+
+    // Seams are keyed on both sides' LOD and version (see VoxelWorld::scheduleSeamBuilds)
+    int            lod = -1;       // This chunk's LOD the mesh belongs to
+    uint64_t       builtKey = 0;   // Key of the current mesh
+    uint64_t       pendingKey = 0; // Key of the build in flight
+    bool           built = false;  // Has a mesh (possibly empty) for builtKey
+    bool           building = false;
 };
 
 /**
@@ -47,6 +157,10 @@ public:
     static const int SIZE_X = 16;
     static const int SIZE_Y = 16;
     static const int SIZE_Z = 16;
+    static const int VOLUME = SIZE_X * SIZE_Y * SIZE_Z;
+
+    // Voxel IDs must be below this (per-type counts are a fixed array)
+    static const int MAX_VOXEL_TYPES = 64;
 
     // Example: 3 LOD levels => LOD0 = full, LOD1/LOD2 = downsampled, etc.
     static const int MAX_LOD_LEVELS = 3;
@@ -77,15 +191,76 @@ public:
     int  getBlock(int x, int y, int z) const;
 
     /**
-     * Sets a voxel at (x,y,z). If the value changed, mark all LODs dirty.
+     * Sets a voxel at (x,y,z). If the value changed, LOD1+ are marked dirty
+     * and LOD0 only gets the slices around the voxel marked (see
+     * getDirtySlices), so its mesh can be patched instead of rebuilt.
      */
     void setBlock(int x, int y, int z, int voxelID);
 
+    /**
+     * Replaces all VOLUME voxels at once (x fastest, then y, then z), e.g.
+     * from terrain generation. Type counts are rebuilt in one pass and the
+     * LODs are marked dirty once instead of per voxel.
+     */
+    void assignBlocks(const int* blocks);
+
     /**
      * Provide read-only access to the entire voxel data array.
      */
     const std::vector<int>& getBlocks() const { return m_blocks; }
 
+    /**
+     * Per-type voxel counts, kept up to date by setBlock()/assignBlocks().
+     * Lets queries (raycasts, meshing, LOD) skip or special-case chunks
+     * without a scan.
+     */
+    int  getTypeCount(int voxelID) const { return m_typeCounts[voxelID]; }
+    int  getNonAirCount() const { return VOLUME - m_typeCounts[0]; }
+    bool isEmpty() const { return m_typeCounts[0] == VOLUME; }
+
+    /// The voxel ID filling the whole chunk, or -1 if it holds several types.
+    int  getUniformBlock() const;
+
+    /**
+     * World-wide counters this chunk reports its changes to (the owning
+     * ChunkManager's). Attaching adds the chunk's current counts, detaching
+     * (nullptr) removes them.
+     */
+    void setStats(VoxelStats* stats);
+
+    /**
+     * 6x6 face connectivity through air (see ChunkVisibility.h).
+     * Computed by the meshing job and applied on the main thread;
+     * until then the chunk counts as fully open so nothing is culled early.
+     */
+    uint64_t getFaceConnectivity() const { return m_faceConnectivity; }
+    void     setFaceConnectivity(uint64_t c) { m_faceConnectivity = c; }
+
+    /**
+     * Bumped on every voxel change (setBlock/assignBlocks). Caches derived
+     * from the voxels compare against it.
+     */
+    uint32_t getVersion() const { return m_version.load(std::memory_order_acquire); }
+
+    /**
+     * Copies mip level `lod` of the voxels ((SIZE_X >> lod)^3 IDs) into
+     * `out`. The chain is built on first use and then reused until the
+     * voxels or the reduction mode change, so LOD switches don't
+     * downsample again. `props` must be the same table on every call (the
+     * mesher's). Safe to call from meshing jobs.
+     */
+    void copyMipLevel(int lod, MipReduction mode, const VoxelPropertyTable& props,
+        std::vector<int>& out) const;
+
+    /**
+     * Copies the outermost layer of mip level `lod` on one face
+     * (SeamDirection) as an n x n slice, n = SIZE_X >> lod, indexed
+     * [u + n * v] with (u, v) = (y, z) for X faces, (x, z) for Y faces
+     * and (x, y) for Z faces. Input for the seam meshes.
+     */
+    void copyBoundaryLayer(int face, int lod, MipReduction mode, const VoxelPropertyTable& props,
+        std::vector<int>& out) const;
+
     // ---------------------------------------------------
     // LOD Dirty Flags
     // ---------------------------------------------------
@@ -95,6 +270,26 @@ public:
 
     void markAllLODsDirty(); // Called if chunk data changes
 
+    // ---------------------------------------------------
+    // Dirty LOD0 Slices (edits)
+    // ---------------------------------------------------
+    /**
+     * Per face direction (SeamDirection), one bit per voxel layer whose
+     * LOD0 faces an edit may have changed: the voxel's own layer and the
+     * one facing it. Main thread only; VoxelWorld re-meshes those slices
+     * and patches them into the resident mesh.
+     */
+    uint16_t getDirtySlices(int face) const { return m_dirtySlices[face]; }
+    bool     hasDirtySlices() const;
+    void     clearDirtySlices();
+
+    /**
+     * LOD the world wants this chunk at (see LODPolicy), -1 until the
+     * scheduler first sees it. The renderer draws this one once it is built.
+     */
+    int  getTargetLOD() const { return m_targetLOD; }
+    void setTargetLOD(int level) { m_targetLOD = level; }
+
     // (Legacy synonyms for LOD0)
     bool isDirty() const { return m_lodDirty[0]; }
     void clearDirty() { m_lodDirty[0] = false; }
@@ -152,17 +347,11 @@ public:
     // ---------------------------------------------------
     // Single-LOD Access (backward-compatible)
     // ---------------------------------------------------
-    VkBuffer       getVertexBuffer() const { return m_lods[0].vertexBuffer; }
-    VkDeviceMemory getVertexMemory() const { return m_lods[0].vertexMemory; }
-    VkBuffer       getIndexBuffer()  const { return m_lods[0].indexBuffer; }
-    VkDeviceMemory getIndexMemory()  const { return m_lods[0].indexMemory; }
+    GpuMesh*       getMesh()         const { return m_lods[0].mesh; }
     uint32_t       getVertexCount()  const { return m_lods[0].vertexCount; }
     uint32_t       getIndexCount()   const { return m_lods[0].indexCount; }
 
-    void setVertexBuffer(VkBuffer vb) { m_lods[0].vertexBuffer = vb; }
-    void setVertexMemory(VkDeviceMemory mem) { m_lods[0].vertexMemory = mem; }
-    void setIndexBuffer(VkBuffer ib) { m_lods[0].indexBuffer = ib; }
-    void setIndexMemory(VkDeviceMemory mem) { m_lods[0].indexMemory = mem; }
+    void setMesh(GpuMesh* mesh) { m_lods[0].mesh = mesh; }
     void setVertexCount(uint32_t c) { m_lods[0].vertexCount = c; }
     void setIndexCount(uint32_t c) { m_lods[0].indexCount = c; }
 
@@ -170,17 +359,32 @@ public:
     // Bounding Box & Stats
     // ---------------------------------------------------
     void getBoundingBox(glm::vec3& outMin, glm::vec3& outMax) const;
-    std::pair<size_t, size_t> getVoxelUsage() const;
+    std::pair<size_t, size_t> getVoxelUsage() const; // {non-air, air}, O(1)
 
 private:
     int m_worldX = 0, m_worldY = 0, m_worldZ = 0;
     std::vector<int> m_blocks; // The chunks voxel data
+    uint16_t    m_typeCounts[MAX_VOXEL_TYPES] = {}; // Blocks per voxel ID, see setBlock()
+    VoxelStats* m_stats = nullptr;
+    uint64_t m_faceConnectivity = ChunkVisibility::ALL_CONNECTED;
 
     bool m_isUploading = false;
 
     // LOD data for up to 3 levels
     ChunkLODData m_lods[MAX_LOD_LEVELS];
     bool         m_lodDirty[MAX_LOD_LEVELS] = { true, true, true };
+    int          m_targetLOD = -1;
+
+    std::atomic<uint32_t> m_version{ 0 };
+    mutable std::mutex    m_mipMutex;
+    mutable VoxelMipChain m_mips;
+
+    // Rebuilds m_mips if stale; m_mipMutex must be held
+    void updateMipChain(MipReduction mode, const VoxelPropertyTable& props) const;
+
+    static_assert(SIZE_X <= 16 && SIZE_Y <= 16 && SIZE_Z <= 16, "Dirty slice masks are 16 bits");
+    uint16_t m_dirtySlices[6] = {};
+    void markSlicesDirty(int x, int y, int z);
 
     // For advanced stitching: up to 6 possible seam meshes (each face).
     ChunkSeamData m_seams[6];
@@ -37,12 +37,11 @@ Chunk* ChunkManager::createChunk(int cx, int cy, int cz)
 
     std::unique_ptr<Chunk> newChunk = std::make_unique<Chunk>(cx, cy, cz);
     Chunk* chunkPtr = newChunk.get();
+    chunkPtr->setStats(&m_stats);
     m_chunks.emplace(coord, std::move(newChunk));
+    m_quadtree.insert(chunkPtr);
 
-    Logger::Info("Creating chunk at ("
-        + std::to_string(cx) + ", "
-        + std::to_string(cy) + ", "
-        + std::to_string(cz) + ")");
+    LOG_DEBUG("Creating chunk at ({}, {}, {})", cx, cy, cz);
     return chunkPtr;
 }
 
@@ -52,21 +51,12 @@ void ChunkManager::removeChunk(int cx, int cy, int cz)
     auto it = m_chunks.find(coord);
     if (it != m_chunks.end())
     {
+        m_quadtree.remove(it->second.get());
         m_chunks.erase(it);
-        Logger::Info("Removing chunk at ("
-            + std::to_string(cx) + ", "
-            + std::to_string(cy) + ", "
-            + std::to_string(cz) + ")");
+        LOG_DEBUG("Removing chunk at ({}, {}, {})", cx, cy, cz);
     }
 }
 
 std::pair<size_t, size_t> ChunkManager::getTotalVoxelUsage() const {
-    size_t totalActive = 0;
-    size_t totalEmpty = 0;
-    for (const auto& kv : m_chunks) {
-        auto usage = kv.second->getVoxelUsage();
-        totalActive += usage.first;
-        totalEmpty += usage.second;
-    }
-    return { totalActive, totalEmpty };
+    return { (size_t)m_stats.getNonAirCount(), (size_t)m_stats.getAirCount() };
 }
\ No newline at end of file
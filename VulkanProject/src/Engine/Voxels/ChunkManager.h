@@ -3,6 +3,8 @@
 #include <unordered_map>
 #include <memory>
 #include "Chunk.h"
+#include "ChunkQuadtree.h"
+#include "VoxelStats.h"
 
 /**
  * Represents a coordinate in chunk-space.
@@ -56,9 +58,25 @@ public:
         return m_chunks;
     }
 
-    // For debug usage stats
+    /**
+     * Quadtree over the loaded chunk columns, kept up to date as chunks are
+     * created and removed. refreshBounds() after a chunk's voxels change.
+     */
+    const ChunkQuadtree& getQuadtree() const { return m_quadtree; }
+    void refreshBounds(Chunk* chunk) { m_quadtree.refresh(chunk); }
+
+    // For debug usage stats: {non-air, air} over all loaded chunks, O(1)
     std::pair<size_t, size_t> getTotalVoxelUsage() const;
 
+    /**
+     * Per-type voxel totals over all loaded chunks, maintained incrementally
+     * by the chunks (see VoxelStats).
+     */
+    const VoxelStats& getVoxelStats() const { return m_stats; }
+
 private:
+    // Declared before m_chunks: chunks detach from it when destroyed
+    VoxelStats m_stats;
     std::unordered_map<ChunkCoord, std::unique_ptr<Chunk>, ChunkCoordHash> m_chunks;
+    ChunkQuadtree m_quadtree;
 };
\ No newline at end of file
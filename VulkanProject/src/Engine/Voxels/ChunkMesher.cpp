@@ -1,66 +1,16 @@
 #include "ChunkMesher.h"
-#include "VoxelTypeRegistry.h"
-#include "VoxelType.h"
 #include <stdexcept>
-#include <iostream>
-
-/**
- * Return block ID from the chunk or neighbor if out-of-bounds,
- * or 0 if the neighbor is missing (so no boundary face is generated).
- */
-int ChunkMesher::getBlockIDGlobal(
-    const Chunk& currentChunk,
-    int cx, int cy, int cz,
-    int x, int y, int z,
-    const ChunkManager& manager)
-{
-    if (x >= 0 && x < Chunk::SIZE_X &&
-        y >= 0 && y < Chunk::SIZE_Y &&
-        z >= 0 && z < Chunk::SIZE_Z)
-    {
-        return currentChunk.getBlock(x, y, z);
-    }
-    else
-    {
-        // Shift to neighbor
-        int nx = cx, ny = cy, nz = cz;
-        int lx = x, ly = y, lz = z;
-
-        if (lx < 0) {
-            nx -= 1; lx += Chunk::SIZE_X;
-        }
-        else if (lx >= Chunk::SIZE_X) {
-            nx += 1; lx -= Chunk::SIZE_X;
-        }
-        if (ly < 0) {
-            ny -= 1; ly += Chunk::SIZE_Y;
-        }
-        else if (ly >= Chunk::SIZE_Y) {
-            ny += 1; ly -= Chunk::SIZE_Y;
-        }
-        if (lz < 0) {
-            nz -= 1; lz += Chunk::SIZE_Z;
-        }
-        else if (lz >= Chunk::SIZE_Z) {
-            nz += 1; lz -= Chunk::SIZE_Z;
-        }
-
-        const Chunk* neighbor = manager.getChunk(nx, ny, nz);
-        if (!neighbor) {
-            // If missing, treat as same ID => skip boundary
-            return 0;
-        }
-        return neighbor->getBlock(lx, ly, lz);
-    }
-}
+#include "Engine/Utils/Logger.h"
+#include "Engine/Utils/Profiler.h"
+#include "LODDownsampler.h"
+#include <chrono>
+#include <algorithm>
 
 bool ChunkMesher::generateChunkMeshIfDirty(
     Chunk& chunk,
-    int cx, int cy, int cz,
     std::vector<Vertex>& outVertices,
     std::vector<uint32_t>& outIndices,
     int offsetX, int offsetY, int offsetZ,
-    const ChunkManager& manager,
     bool useGreedy
 )
 {
@@ -74,10 +24,9 @@ bool ChunkMesher::generateChunkMeshIfDirty(
 
     if (useGreedy) {
         generateMeshGreedy(
-            chunk, cx, cy, cz,
+            chunk,
             outVertices, outIndices,
-            offsetX, offsetY, offsetZ,
-            manager
+            offsetX, offsetY, offsetZ
         );
     }
     else {
@@ -87,475 +36,726 @@ bool ChunkMesher::generateChunkMeshIfDirty(
     return true;
 }
 
+void ChunkMesher::buildLODMesh(
+    const Chunk& chunk,
+    int cx, int cy, int cz,
+    int lodLevel,
+    std::vector<Vertex>& outVertices,
+    std::vector<uint32_t>& outIndices,
+    MeshBuildTimings* outTimings,
+    MeshSliceLayout* outSlices,
+    uint32_t* outOpaqueIndexCount,
+    MeshFaceRanges* outFaceRanges
+)
+{
+    typedef std::chrono::steady_clock Clock;
+
+    int offsetX = cx * Chunk::SIZE_X;
+    int offsetY = cy * Chunk::SIZE_Y;
+    int offsetZ = cz * Chunk::SIZE_Z;
+
+    if (lodLevel == 0)
+    {
+        Clock::time_point t0 = Clock::now();
+        if (outSlices) {
+            buildSegmentedMesh(chunk, cx, cy, cz, outVertices, outIndices, *outSlices);
+            if (outOpaqueIndexCount) {
+                *outOpaqueIndexCount = outSlices->passEnd[0] * 6;
+            }
+            storeFaceRanges(*outSlices, outFaceRanges);
+        }
+        else {
+            generateMeshGreedy(
+                chunk,
+                outVertices, outIndices,
+                offsetX, offsetY, offsetZ,
+                outOpaqueIndexCount, outFaceRanges
+            );
+        }
+        if (outTimings) {
+            outTimings->downsampleNs = 0;
+            outTimings->meshNs = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t0).count();
+        }
+        return;
+    }
+
+    Clock::time_point t0 = Clock::now();
+    std::vector<int>& dsData = threadScratch().cells;
+    {
+        PROFILE_ZONE("Downsample");
+        chunk.copyMipLevel(lodLevel, m_mipReduction.load(), m_props, dsData);
+    }
+    Clock::time_point t1 = Clock::now();
+
+    int dsX = Chunk::SIZE_X >> lodLevel;
+    int dsY = Chunk::SIZE_Y >> lodLevel;
+    int dsZ = Chunk::SIZE_Z >> lodLevel;
+
+    {
+        PROFILE_ZONE("Mesh Downsampled");
+        generateMeshFromArray(
+            dsData, dsX, dsY, dsZ,
+            offsetX, offsetY, offsetZ,
+            outVertices, outIndices,
+            true /* useGreedy */,
+            false /* border faces come from the seams */,
+            outOpaqueIndexCount, outFaceRanges
+        );
+    }
+
+    if (outTimings) {
+        outTimings->downsampleNs = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+        outTimings->meshNs = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - t1).count();
+    }
+}
+
 /**
  * "Greedy" meshing approach for LOD0, merges faces.
- * Also merges cross-chunk boundaries if neighbor block ID = same => no face.
+ * Faces on the chunk border are left to the seam meshes (buildLODBoundaryStitch).
  */
 void ChunkMesher::generateMeshGreedy(
     const Chunk& chunk,
-    int cx, int cy, int cz,
     std::vector<Vertex>& outVertices,
     std::vector<uint32_t>& outIndices,
     int offsetX, int offsetY, int offsetZ,
-    const ChunkManager& manager)
+    uint32_t* outOpaqueIndexCount,
+    MeshFaceRanges* outFaceRanges)
 {
+    PROFILE_ZONE("Greedy Mesh");
     outVertices.clear();
     outIndices.clear();
 
-    // +Z 
-    for (int z = 0; z < Chunk::SIZE_Z; z++)
+    Scratch& scratch = threadScratch();
+    std::vector<int>& mask = scratch.mask;
+    TranslucentQuads& translucent = scratch.translucent;
+    translucent.clear();
+    FaceQuadEnds faceEnds;
+    for (int face = 0; face < 6; face++)
     {
-        std::vector<int> mask(Chunk::SIZE_X * Chunk::SIZE_Y, -1);
-        for (int y = 0; y < Chunk::SIZE_Y; y++)
+        for (int layer = 0; layer < Chunk::SIZE_X; layer++)
         {
-            for (int x = 0; x < Chunk::SIZE_X; x++)
-            {
-                int id = chunk.getBlock(x, y, z);
-                if (id <= 0) continue;
-
-                int neighborID = getBlockIDGlobal(chunk, cx, cy, cz, x, y, z + 1, manager);
-                if (neighborID != id) {
-                    size_t idx = (size_t)(y)*Chunk::SIZE_X + x;
-                    mask[idx] = id;
-                }
-            }
+            meshSlice(chunk, face, layer, offsetX, offsetY, offsetZ,
+                mask, outVertices, outIndices, translucent);
         }
-        // standard greedy pass
-        for (int row = 0; row < Chunk::SIZE_Y; row++)
+        faceEnds.mark(face, outVertices, translucent);
+    }
+    appendTranslucent(outVertices, outIndices, translucent, outOpaqueIndexCount);
+    storeFaceRanges(faceEnds, outFaceRanges);
+
+    LOG_TRACE("[Mesh Debug] Chunk({},{},{}) => {} verts, {} inds",
+        chunk.worldX(), chunk.worldY(), chunk.worldZ(), outVertices.size(), outIndices.size());
+}
+
+void ChunkMesher::buildSegmentedMesh(
+    const Chunk& chunk,
+    int cx, int cy, int cz,
+    std::vector<Vertex>& outVertices,
+    std::vector<uint32_t>& outIndices,
+    MeshSliceLayout& outLayout
+)
+{
+    PROFILE_ZONE("Segmented Mesh");
+    outVertices.clear();
+    outIndices.clear();
+
+    const int layers = Chunk::SIZE_X;
+    const size_t passSlices = (size_t)6 * layers;
+    outLayout.clear();
+    outLayout.slices.resize(passSlices * MeshSliceLayout::PASS_COUNT);
+
+    auto placeSlice = [](MeshSlice& s, int quads, uint32_t& slot) {
+        s.first = slot;
+        s.used = (uint16_t)quads;
+        s.capacity = sliceCapacity(quads);
+        slot += s.capacity;
+    };
+    // Spare slots at the end of a pass, shared by slices that outgrow their run
+    auto spareSlots = [](uint32_t slots) { return 16 + slots / 8; };
+
+    // Opaque runs go straight into the mesh; translucent runs are numbered
+    // from 0 here and moved behind the opaque pass below
+    Scratch& scratch = threadScratch();
+    std::vector<int>& mask = scratch.mask;
+    std::vector<uint32_t>& sliceIndices = scratch.discardedIndices; // rebuilt over all slots below
+    TranslucentQuads& translucent = scratch.translucent;
+    std::vector<Vertex>& translucentRuns = scratch.translucentRuns;
+    translucentRuns.clear();
+    uint32_t slot = 0;
+    uint32_t translucentSlot = 0;
+    uint32_t realQuads = 0;
+    for (int face = 0; face < 6; face++)
+    {
+        for (int layer = 0; layer < layers; layer++)
         {
-            int col = 0;
-            while (col < Chunk::SIZE_X)
-            {
-                size_t idx = (size_t)row * Chunk::SIZE_X + col;
-                int bid = mask[idx];
-                if (bid < 0) {
-                    col++;
-                    continue;
-                }
-                int width = 1;
-                while ((col + width) < Chunk::SIZE_X)
-                {
-                    size_t idx2 = (size_t)row * Chunk::SIZE_X + (col + width);
-                    if (mask[idx2] == bid) width++;
-                    else break;
-                }
-                int height = 1;
-                bool done = false;
-                while (!done)
-                {
-                    int nextRow = row + height;
-                    if (nextRow >= Chunk::SIZE_Y) break;
-                    for (int c2 = 0; c2 < width; c2++)
-                    {
-                        size_t idx3 = (size_t)nextRow * Chunk::SIZE_X + (col + c2);
-                        if (mask[idx3] != bid) { done = true; break; }
-                    }
-                    if (!done) height++;
-                }
-                buildQuadPosZ(
-                    col, row, width, height, z,
-                    offsetX, offsetY, offsetZ, bid,
-                    outVertices, outIndices
-                );
-                // Mark used
-                for (int rr = 0; rr < height; rr++)
-                {
-                    for (int cc = 0; cc < width; cc++)
-                    {
-                        size_t idx4 = (size_t)(row + rr) * Chunk::SIZE_X + (col + cc);
-                        mask[idx4] = -1;
-                    }
-                }
-                col += width;
-            }
+            size_t start = outVertices.size();
+            translucent.clear();
+            sliceIndices.clear();
+            meshSlice(chunk, face, layer,
+                cx * Chunk::SIZE_X, cy * Chunk::SIZE_Y, cz * Chunk::SIZE_Z,
+                mask, outVertices, sliceIndices, translucent);
+
+            size_t index = (size_t)face * layers + layer;
+            int quads = (int)((outVertices.size() - start) / 4);
+            placeSlice(outLayout.slices[index], quads, slot);
+            padQuads(outVertices, slot);
+
+            int translucentQuads = (int)(translucent.verts.size() / 4);
+            placeSlice(outLayout.slices[passSlices + index], translucentQuads, translucentSlot);
+            translucentRuns.insert(translucentRuns.end(), translucent.verts.begin(), translucent.verts.end());
+            padQuads(translucentRuns, translucentSlot);
+
+            realQuads += (uint32_t)(quads + translucentQuads);
         }
     }
 
-    // -Z
-    for (int z = 0; z < Chunk::SIZE_Z; z++)
+    if (realQuads == 0) {
+        outVertices.clear();
+        outLayout.clear();
+        return;
+    }
+
+    outLayout.freeSlot[0] = slot;
+    outLayout.passEnd[0] = slot + spareSlots(slot);
+    padQuads(outVertices, outLayout.passEnd[0]);
+
+    const uint32_t translucentBase = outLayout.passEnd[0];
+    for (size_t i = passSlices; i < outLayout.slices.size(); i++) {
+        outLayout.slices[i].first += translucentBase;
+    }
+    outVertices.insert(outVertices.end(), translucentRuns.begin(), translucentRuns.end());
+    outLayout.freeSlot[1] = translucentBase + translucentSlot;
+    outLayout.passEnd[1] = outLayout.freeSlot[1] + spareSlots(translucentSlot);
+    padQuads(outVertices, outLayout.passEnd[1]);
+
+    if (!m_buildIndices) return;
+    const uint32_t slotCount = outLayout.slotCount();
+    outIndices.resize((size_t)slotCount * 6);
+    for (uint32_t q = 0; q < slotCount; q++)
     {
-        std::vector<int> mask(Chunk::SIZE_X * Chunk::SIZE_Y, -1);
-        for (int y = 0; y < Chunk::SIZE_Y; y++)
-        {
-            for (int x = 0; x < Chunk::SIZE_X; x++)
-            {
-                int id = chunk.getBlock(x, y, z);
-                if (id <= 0) continue;
+        uint32_t* idx = &outIndices[(size_t)q * 6];
+        uint32_t v = q * 4;
+        idx[0] = v + 0; idx[1] = v + 1; idx[2] = v + 2;
+        idx[3] = v + 2; idx[4] = v + 3; idx[5] = v + 0;
+    }
+}
 
-                int neighborID = getBlockIDGlobal(chunk, cx, cy, cz, x, y, z - 1, manager);
-                if (neighborID != id) {
-                    size_t idx = (size_t)(y)*Chunk::SIZE_X + x;
-                    mask[idx] = id;
-                }
-            }
-        }
-        // standard greedy
-        for (int row = 0; row < Chunk::SIZE_Y; row++)
-        {
-            int col = 0;
-            while (col < Chunk::SIZE_X)
-            {
-                size_t idx = (size_t)row * Chunk::SIZE_X + col;
-                int bid = mask[idx];
-                if (bid < 0) { col++; continue; }
+void ChunkMesher::buildSliceQuads(
+    const Chunk& chunk,
+    int face, int layer,
+    int offsetX, int offsetY, int offsetZ,
+    std::vector<Vertex>& outVertices,
+    std::vector<Vertex>& outTranslucentVertices
+)
+{
+    Scratch& scratch = threadScratch();
+    TranslucentQuads& translucent = scratch.translucent;
+    translucent.clear();
+    scratch.discardedIndices.clear();
+    meshSlice(chunk, face, layer, offsetX, offsetY, offsetZ,
+        scratch.mask, outVertices, scratch.discardedIndices, translucent);
+    outTranslucentVertices.insert(outTranslucentVertices.end(),
+        translucent.verts.begin(), translucent.verts.end());
+}
 
-                int width = 1;
-                while ((col + width) < Chunk::SIZE_X)
-                {
-                    size_t idx2 = (size_t)row * Chunk::SIZE_X + (col + width);
-                    if (mask[idx2] == bid) width++;
-                    else break;
-                }
-                int height = 1;
-                bool done = false;
-                while (!done)
-                {
-                    int nr = row + height;
-                    if (nr >= Chunk::SIZE_Y) break;
-                    for (int c2 = 0; c2 < width; c2++)
-                    {
-                        size_t idx3 = (size_t)nr * Chunk::SIZE_X + (col + c2);
-                        if (mask[idx3] != bid) { done = true; break; }
-                    }
-                    if (!done) height++;
-                }
-                buildQuadNegZ(
-                    col, row, width, height, z,
-                    offsetX, offsetY, offsetZ, bid,
-                    outVertices, outIndices
-                );
+ChunkMesher::Scratch& ChunkMesher::threadScratch()
+{
+    thread_local Scratch t_scratch;
+    return t_scratch;
+}
 
-                for (int rr = 0; rr < height; rr++)
-                {
-                    for (int cc = 0; cc < width; cc++)
-                    {
-                        size_t idx4 = (size_t)(row + rr) * Chunk::SIZE_X + (col + cc);
-                        mask[idx4] = -1;
-                    }
-                }
-                col += width;
-            }
-        }
+uint16_t ChunkMesher::sliceCapacity(int quads)
+{
+    // ~25% slack: a single edit usually adds a quad or splits one into a few
+    return (uint16_t)(quads + (quads + 3) / 4);
+}
+
+void ChunkMesher::padQuads(std::vector<Vertex>& verts, size_t quads)
+{
+    // All four corners on one point: zero-area triangles the rasterizer drops
+    verts.resize(quads * 4, Vertex(0.f, 0.f, 0.f, 0.f, 0.f, 0.f));
+}
+
+void ChunkMesher::buildQuadIndexPattern(uint32_t quads, std::vector<uint16_t>& out)
+{
+    if (quads > SHARED_INDEX_QUADS) {
+        throw std::runtime_error("Quad index pattern exceeds 16-bit indices");
+    }
+    out.resize((size_t)quads * 6);
+    for (uint32_t q = 0; q < quads; q++)
+    {
+        uint16_t* idx = &out[(size_t)q * 6];
+        uint16_t v = (uint16_t)(q * 4);
+        idx[0] = v + 0; idx[1] = v + 1; idx[2] = v + 2;
+        idx[3] = v + 2; idx[4] = v + 3; idx[5] = v + 0;
     }
+}
 
-    // +X
-    for (int x = 0; x < Chunk::SIZE_X; x++)
+// Grows a meshlet's box by one quad's corners; padding quads are skipped
+static void widenMeshlet(Meshlet& meshlet, const Vertex* corners)
+{
+    if (corners[0].px == corners[2].px && corners[0].py == corners[2].py && corners[0].pz == corners[2].pz) {
+        return;
+    }
+    for (int i = 0; i < 4; i++)
     {
-        std::vector<int> mask(Chunk::SIZE_Y * Chunk::SIZE_Z, -1);
-        for (int z = 0; z < Chunk::SIZE_Z; z++)
-        {
-            for (int y = 0; y < Chunk::SIZE_Y; y++)
-            {
-                int id = chunk.getBlock(x, y, z);
-                if (id <= 0) continue;
+        glm::vec3 p(corners[i].px, corners[i].py, corners[i].pz);
+        meshlet.minB = glm::min(meshlet.minB, p);
+        meshlet.maxB = glm::max(meshlet.maxB, p);
+    }
+}
 
-                int neighborID = getBlockIDGlobal(chunk, cx, cy, cz, x + 1, y, z, manager);
-                if (neighborID != id)
-                {
-                    size_t idx = (size_t)z * Chunk::SIZE_Y + y;
-                    mask[idx] = id;
-                }
+void ChunkMesher::buildMeshlets(const std::vector<Vertex>& verts, uint32_t opaqueIndexCount,
+    const MeshFaceRanges& faceRanges, std::vector<Meshlet>& outMeshlets)
+{
+    outMeshlets.clear();
+    const uint32_t indexCount = (uint32_t)(verts.size() / 4 * 6);
+
+    // Cuts [begin, end) into meshlets of direction `face` (-1: mixed)
+    auto split = [&](uint32_t begin, uint32_t end, int face) {
+        for (uint32_t first = begin; first < end; first += Meshlet::MAX_QUADS * 6)
+        {
+            Meshlet meshlet;
+            meshlet.firstIndex = first;
+            meshlet.indexCount = std::min(end - first, Meshlet::MAX_QUADS * 6);
+            meshlet.face = face;
+            for (uint32_t q = first / 6; q < (first + meshlet.indexCount) / 6; q++) {
+                widenMeshlet(meshlet, &verts[(size_t)q * 4]);
             }
+            outMeshlets.push_back(meshlet);
         }
-        for (int startZ = 0; startZ < Chunk::SIZE_Z; startZ++)
-        {
-            int startY = 0;
-            while (startY < Chunk::SIZE_Y)
-            {
-                size_t idx = (size_t)startZ * Chunk::SIZE_Y + startY;
-                int bid = mask[idx];
-                if (bid < 0) { startY++; continue; }
+    };
 
-                int height = 1;
-                while ((startY + height) < Chunk::SIZE_Y)
-                {
-                    size_t idx2 = (size_t)startZ * Chunk::SIZE_Y + (startY + height);
-                    if (mask[idx2] == bid) height++;
-                    else break;
-                }
-                int depth = 1;
-                bool done = false;
-                while (!done)
-                {
-                    int nz = startZ + depth;
-                    if (nz >= Chunk::SIZE_Z) break;
-                    for (int hy = 0; hy < height; hy++)
-                    {
-                        size_t idx3 = (size_t)nz * Chunk::SIZE_Y + (startY + hy);
-                        if (mask[idx3] != bid) { done = true; break; }
-                    }
-                    if (!done) depth++;
-                }
-                buildQuadPosX(
-                    startY, startZ, height, depth, x,
-                    offsetX, offsetY, offsetZ, bid,
-                    outVertices, outIndices
-                );
-                for (int dz = 0; dz < depth; dz++)
-                {
-                    for (int hy = 0; hy < height; hy++)
-                    {
-                        size_t idx4 = (size_t)(startZ + dz) * Chunk::SIZE_Y + (startY + hy);
-                        mask[idx4] = -1;
-                    }
-                }
-                startY += height;
-            }
+    for (int pass = 0; pass < MeshSliceLayout::PASS_COUNT; pass++)
+    {
+        const uint32_t passBegin = (pass == 0) ? 0 : opaqueIndexCount;
+        const uint32_t passEnd = (pass == 0) ? opaqueIndexCount : indexCount;
+        if (!faceRanges.valid)
+        {
+            split(passBegin, passEnd, -1);
+            continue;
+        }
+        const uint32_t* s = faceRanges.start[pass];
+        split(passBegin, s[0], -1);
+        for (int face = 0; face < MeshFaceRanges::FACE_COUNT; face++) {
+            split(s[face], s[face + 1], face);
         }
+        split(s[MeshFaceRanges::FACE_COUNT], passEnd, -1);
     }
+}
 
-    // -X
-    for (int x = 0; x < Chunk::SIZE_X; x++)
+void ChunkMesher::growMeshlets(std::vector<Meshlet>& meshlets, uint32_t firstVertex,
+    const std::vector<Vertex>& verts)
+{
+    const uint32_t firstQuad = firstVertex / 4;
+    const uint32_t endQuad = firstQuad + (uint32_t)(verts.size() / 4);
+    for (Meshlet& meshlet : meshlets)
     {
-        std::vector<int> mask(Chunk::SIZE_Y * Chunk::SIZE_Z, -1);
-        for (int z = 0; z < Chunk::SIZE_Z; z++)
-        {
-            for (int y = 0; y < Chunk::SIZE_Y; y++)
-            {
-                int id = chunk.getBlock(x, y, z);
-                if (id <= 0) continue;
+        const uint32_t begin = std::max(meshlet.firstIndex / 6, firstQuad);
+        const uint32_t end = std::min((meshlet.firstIndex + meshlet.indexCount) / 6, endQuad);
+        for (uint32_t q = begin; q < end; q++) {
+            widenMeshlet(meshlet, &verts[(size_t)(q - firstQuad) * 4]);
+        }
+    }
+}
 
-                int neighborID = getBlockIDGlobal(chunk, cx, cy, cz, x - 1, y, z, manager);
-                if (neighborID != id)
-                {
-                    size_t idx = (size_t)z * Chunk::SIZE_Y + y;
-                    mask[idx] = id;
-                }
-            }
+void ChunkMesher::appendTranslucent(
+    std::vector<Vertex>& outVertices,
+    std::vector<uint32_t>& outIndices,
+    const TranslucentQuads& translucent,
+    uint32_t* outOpaqueIndexCount
+)
+{
+    if (outOpaqueIndexCount) {
+        *outOpaqueIndexCount = (uint32_t)(outVertices.size() / 4 * 6);
+    }
+    if (translucent.verts.empty()) return;
+
+    const uint32_t base = (uint32_t)outVertices.size();
+    outVertices.insert(outVertices.end(), translucent.verts.begin(), translucent.verts.end());
+    outIndices.reserve(outIndices.size() + translucent.inds.size());
+    for (uint32_t index : translucent.inds) {
+        outIndices.push_back(base + index);
+    }
+}
+
+void ChunkMesher::storeFaceRanges(const FaceQuadEnds& ends, MeshFaceRanges* outFaceRanges)
+{
+    if (!outFaceRanges) return;
+
+    const int faces = MeshFaceRanges::FACE_COUNT;
+    const uint32_t opaqueQuads = ends.end[0][faces - 1];
+    for (int pass = 0; pass < MeshSliceLayout::PASS_COUNT; pass++)
+    {
+        const uint32_t base = (pass == 0) ? 0 : opaqueQuads;
+        outFaceRanges->start[pass][0] = base * 6;
+        for (int face = 0; face < faces; face++) {
+            outFaceRanges->start[pass][face + 1] = (base + ends.end[pass][face]) * 6;
         }
-        for (int startZ = 0; startZ < Chunk::SIZE_Z; startZ++)
-        {
-            int startY = 0;
-            while (startY < Chunk::SIZE_Y)
-            {
-                size_t idx = (size_t)startZ * Chunk::SIZE_Y + startY;
-                int bid = mask[idx];
-                if (bid < 0) { startY++; continue; }
+    }
+    outFaceRanges->valid = true;
+}
 
-                int height = 1;
-                while ((startY + height) < Chunk::SIZE_Y)
-                {
-                    size_t idx2 = (size_t)startZ * Chunk::SIZE_Y + (startY + height);
-                    if (mask[idx2] == bid) height++;
-                    else break;
-                }
-                int depth = 1;
-                bool done = false;
-                while (!done)
-                {
-                    int nz = startZ + depth;
-                    if (nz >= Chunk::SIZE_Z) break;
-                    for (int hy = 0; hy < height; hy++)
-                    {
-                        size_t idx3 = (size_t)nz * Chunk::SIZE_Y + (startY + hy);
-                        if (mask[idx3] != bid) { done = true; break; }
-                    }
-                    if (!done) depth++;
-                }
-                buildQuadNegX(
-                    startY, startZ, height, depth, x,
-                    offsetX, offsetY, offsetZ, bid,
-                    outVertices, outIndices
-                );
-                for (int dz = 0; dz < depth; dz++)
-                {
-                    for (int hy = 0; hy < height; hy++)
-                    {
-                        size_t idx4 = (size_t)(startZ + dz) * Chunk::SIZE_Y + (startY + hy);
-                        mask[idx4] = -1;
-                    }
-                }
-                startY += height;
-            }
+void ChunkMesher::storeFaceRanges(const MeshSliceLayout& layout, MeshFaceRanges* outFaceRanges)
+{
+    if (!outFaceRanges) return;
+    *outFaceRanges = MeshFaceRanges();
+    if (layout.empty()) return;
+
+    // Each direction's slices are consecutive runs; edits only ever move a
+    // slice into the spare slots, which the ranges leave to the mixed tail
+    const int faces = MeshFaceRanges::FACE_COUNT;
+    for (int pass = 0; pass < MeshSliceLayout::PASS_COUNT; pass++)
+    {
+        for (int face = 0; face < faces; face++) {
+            outFaceRanges->start[pass][face] = layout.slices[((size_t)pass * faces + face) * Chunk::SIZE_X].first * 6;
         }
+        outFaceRanges->start[pass][faces] = layout.freeSlot[pass] * 6;
     }
+    outFaceRanges->valid = true;
+}
 
-    // +Y
-    for (int y = 0; y < Chunk::SIZE_Y; y++)
+void ChunkMesher::meshSlice(
+    const Chunk& chunk,
+    int face, int layer,
+    int offsetX, int offsetY, int offsetZ,
+    std::vector<int>& mask,
+    std::vector<Vertex>& outVertices,
+    std::vector<uint32_t>& outIndices,
+    TranslucentQuads& outTranslucent
+)
+{
+    // In-plane axes per face axis, matching the buildQuad argument order:
+    //   X faces => (y, z), Y faces => (x, z), Z faces => (x, y)
+    static const int uAxes[3] = { 1, 0, 0 };
+    static const int vAxes[3] = { 2, 2, 1 };
+
+    const int n = Chunk::SIZE_X;
+    const int d = face / 2;
+    const int dir = (face % 2 == 0) ? 1 : -1;
+
+    // Chunk-border faces belong to the seam meshes
+    if (layer + dir < 0 || layer + dir >= n) return;
+
+    const size_t stride[3] = { 1, (size_t)n, (size_t)n * n };
+    const size_t strideU = stride[uAxes[d]];
+    const size_t strideV = stride[vAxes[d]];
+    const size_t base = stride[d] * (size_t)layer;
+    const size_t next = (dir > 0) ? base + stride[d] : base - stride[d]; // layer faced
+
+    const std::vector<int>& blocks = chunk.getBlocks();
+    mask.assign((size_t)n * n, -1);
+    bool any = false;
+    for (int v = 0; v < n; v++)
     {
-        std::vector<int> mask(Chunk::SIZE_X * Chunk::SIZE_Z, -1);
-        for (int z = 0; z < Chunk::SIZE_Z; z++)
+        for (int u = 0; u < n; u++)
         {
-            for (int x = 0; x < Chunk::SIZE_X; x++)
-            {
-                int id = chunk.getBlock(x, y, z);
-                if (id <= 0) continue;
-
-                int neighborID = getBlockIDGlobal(chunk, cx, cy, cz, x, y + 1, z, manager);
-                if (neighborID != id)
-                {
-                    size_t idx = (size_t)z * Chunk::SIZE_X + x;
-                    mask[idx] = id;
-                }
+            size_t offset = strideU * u + strideV * v;
+            int id = blocks[base + offset];
+            if (hasFace(id, blocks[next + offset])) {
+                mask[(size_t)v * n + u] = id;
+                any = true;
             }
         }
-        for (int startZ = 0; startZ < Chunk::SIZE_Z; startZ++)
-        {
-            int startX = 0;
-            while (startX < Chunk::SIZE_X)
-            {
-                size_t idx = (size_t)startZ * Chunk::SIZE_X + startX;
-                int bid = mask[idx];
-                if (bid < 0) { startX++; continue; }
+    }
+    if (!any) return;
 
-                int width = 1;
-                while ((startX + width) < Chunk::SIZE_X)
-                {
-                    size_t idx2 = (size_t)startZ * Chunk::SIZE_X + (startX + width);
-                    if (mask[idx2] == bid) width++;
-                    else break;
-                }
-                int depth = 1;
-                bool done = false;
-                while (!done)
-                {
-                    int nz = startZ + depth;
-                    if (nz >= Chunk::SIZE_Z) break;
-                    for (int wx = 0; wx < width; wx++)
-                    {
-                        size_t idx3 = (size_t)nz * Chunk::SIZE_X + (startX + wx);
-                        if (mask[idx3] != bid) { done = true; break; }
-                    }
-                    if (!done) depth++;
-                }
-                buildQuadPosY(
-                    startX, startZ, width, depth, y,
-                    offsetX, offsetY, offsetZ, bid,
-                    outVertices, outIndices
-                );
-                for (int dz = 0; dz < depth; dz++)
-                {
-                    for (int wx = 0; wx < width; wx++)
-                    {
-                        size_t idx4 = (size_t)(startZ + dz) * Chunk::SIZE_X + (startX + wx);
-                        mask[idx4] = -1;
-                    }
+    emitMaskQuads(mask, n, n, face, layer, 1, 1,
+        offsetX, offsetY, offsetZ, outVertices, outIndices, outTranslucent, true);
+}
+
+void ChunkMesher::generateMeshFromArray(
+    const std::vector<int>& voxelArray,
+    int dsX, int dsY, int dsZ,
+    int worldOffsetX, int worldOffsetY, int worldOffsetZ,
+    std::vector<Vertex>& outVertices,
+    std::vector<uint32_t>& outIndices,
+    bool useGreedy,
+    bool emitBorderFaces,
+    uint32_t* outOpaqueIndexCount,
+    MeshFaceRanges* outFaceRanges
+)
+{
+    outVertices.clear();
+    outIndices.clear();
+
+    // One cell covers scale[axis] voxels
+    const int dims[3] = { dsX, dsY, dsZ };
+    const int scale[3] = {
+        Chunk::SIZE_X / dsX,
+        Chunk::SIZE_Y / dsY,
+        Chunk::SIZE_Z / dsZ
+    };
+    TranslucentQuads& translucent = threadScratch().translucent;
+    translucent.clear();
+    FaceQuadEnds faceEnds;
+    meshCellArray(voxelArray, dims, scale,
+        worldOffsetX, worldOffsetY, worldOffsetZ,
+        outVertices, outIndices, translucent, faceEnds, useGreedy, emitBorderFaces);
+    appendTranslucent(outVertices, outIndices, translucent, outOpaqueIndexCount);
+    storeFaceRanges(faceEnds, outFaceRanges);
+}
+
+/**
+ * Far-field superchunk: the members' mip levels go into one array, so the
+ * greedy pass merges straight across the old chunk borders.
+ */
+void ChunkMesher::buildSuperChunkMesh(
+    const std::vector<std::vector<int>>& memberVoxels,
+    int groupSize,
+    int lodLevel,
+    int worldOffsetX, int worldOffsetY, int worldOffsetZ,
+    std::vector<Vertex>& outVertices,
+    std::vector<uint32_t>& outIndices,
+    uint32_t* outOpaqueIndexCount,
+    MeshFaceRanges* outFaceRanges
+)
+{
+    PROFILE_ZONE("Superchunk Mesh");
+    outVertices.clear();
+    outIndices.clear();
+
+    const int dsX = Chunk::SIZE_X >> lodLevel;
+    const int dsY = Chunk::SIZE_Y >> lodLevel;
+    const int dsZ = Chunk::SIZE_Z >> lodLevel;
+    const int dims[3] = { dsX * groupSize, dsY, dsZ * groupSize };
+    const int scale[3] = { 1 << lodLevel, 1 << lodLevel, 1 << lodLevel };
+
+    Scratch& scratch = threadScratch();
+    std::vector<int>& cells = scratch.cells;
+    cells.assign((size_t)dims[0] * dims[1] * dims[2], 0);
+    for (int mz = 0; mz < groupSize; mz++)
+    {
+        for (int mx = 0; mx < groupSize; mx++)
+        {
+            const std::vector<int>& src = memberVoxels[(size_t)mx + (size_t)groupSize * mz];
+            if (src.size() != (size_t)dsX * dsY * dsZ) continue; // missing => air
+
+            for (int z = 0; z < dsZ; z++) {
+                for (int y = 0; y < dsY; y++) {
+                    const int* row = &src[(size_t)dsX * (y + (size_t)dsY * z)];
+                    size_t dst = (size_t)(mx * dsX) + (size_t)dims[0] * (y + (size_t)dims[1] * (mz * dsZ + z));
+                    std::copy(row, row + dsX, cells.begin() + dst);
                 }
-                startX += width;
             }
         }
     }
 
-    // -Y
-    for (int y = 0; y < Chunk::SIZE_Y; y++)
-    {
-        std::vector<int> mask(Chunk::SIZE_X * Chunk::SIZE_Z, -1);
-        for (int z = 0; z < Chunk::SIZE_Z; z++)
-        {
-            for (int x = 0; x < Chunk::SIZE_X; x++)
-            {
-                int id = chunk.getBlock(x, y, z);
-                if (id <= 0) continue;
+    TranslucentQuads& translucent = scratch.translucent;
+    translucent.clear();
+    FaceQuadEnds faceEnds;
+    meshCellArray(cells, dims, scale,
+        worldOffsetX, worldOffsetY, worldOffsetZ,
+        outVertices, outIndices, translucent, faceEnds, true, true);
+    appendTranslucent(outVertices, outIndices, translucent, outOpaqueIndexCount);
+    storeFaceRanges(faceEnds, outFaceRanges);
+}
 
-                int neighborID = getBlockIDGlobal(chunk, cx, cy, cz, x, y - 1, z, manager);
-                if (neighborID != id)
-                {
-                    size_t idx = (size_t)z * Chunk::SIZE_X + x;
-                    mask[idx] = id;
-                }
-            }
+void ChunkMesher::meshCellArray(
+    const std::vector<int>& cells,
+    const int dims[3],
+    const int scale[3],
+    int worldOffsetX, int worldOffsetY, int worldOffsetZ,
+    std::vector<Vertex>& outVertices,
+    std::vector<uint32_t>& outIndices,
+    TranslucentQuads& outTranslucent,
+    FaceQuadEnds& outFaceEnds,
+    bool useGreedy,
+    bool emitBorderFaces
+)
+{
+    PROFILE_ZONE("Array Mesh");
+    // The buildQuad helpers work in voxel units, so every coordinate
+    // is scaled up before emitting.
+    const int dsX = dims[0], dsY = dims[1], dsZ = dims[2];
+
+    // Anything outside the array counts as air (no cross-chunk culling for LODs)
+    auto cellAt = [&](const int p[3]) -> int {
+        if (p[0] < 0 || p[1] < 0 || p[2] < 0
+            || p[0] >= dsX || p[1] >= dsY || p[2] >= dsZ) {
+            return 0;
         }
-        for (int startZ = 0; startZ < Chunk::SIZE_Z; startZ++)
+        return cells[(size_t)p[0] + (size_t)dsX * ((size_t)p[1] + (size_t)dsY * p[2])];
+    };
+
+    // In-plane axes per face axis, matching the buildQuad argument order:
+    //   X faces => (y, z), Y faces => (x, z), Z faces => (x, y)
+    static const int uAxes[3] = { 1, 0, 0 };
+    static const int vAxes[3] = { 2, 2, 1 };
+
+    std::vector<int>& mask = threadScratch().mask;
+    for (int d = 0; d < 3; d++)
+    {
+        const int du = uAxes[d];
+        const int dv = vAxes[d];
+        const int nu = dims[du];
+        const int nv = dims[dv];
+        mask.assign((size_t)nu * nv, -1);
+
+        for (int dir = 1; dir >= -1; dir -= 2)
         {
-            int startX = 0;
-            while (startX < Chunk::SIZE_X)
+            const int face = d * 2 + (dir < 0 ? 1 : 0);
+            for (int layer = 0; layer < dims[d]; layer++)
             {
-                size_t idx = (size_t)startZ * Chunk::SIZE_X + startX;
-                int bid = mask[idx];
-                if (bid < 0) { startX++; continue; }
-
-                int width = 1;
-                while ((startX + width) < Chunk::SIZE_X)
-                {
-                    size_t idx2 = (size_t)startZ * Chunk::SIZE_X + (startX + width);
-                    if (mask[idx2] == bid) width++;
-                    else break;
-                }
-                int depth = 1;
-                bool done = false;
-                while (!done)
-                {
-                    int nz = startZ + depth;
-                    if (nz >= Chunk::SIZE_Z) break;
-                    for (int wx = 0; wx < width; wx++)
-                    {
-                        size_t idx3 = (size_t)nz * Chunk::SIZE_X + (startX + wx);
-                        if (mask[idx3] != bid) { done = true; break; }
-                    }
-                    if (!done) depth++;
-                }
-                buildQuadNegY(
-                    startX, startZ, width, depth, y,
-                    offsetX, offsetY, offsetZ, bid,
-                    outVertices, outIndices
-                );
-                for (int dz = 0; dz < depth; dz++)
+                // Build the face mask for this slice
+                for (int v = 0; v < nv; v++)
                 {
-                    for (int wx = 0; wx < width; wx++)
+                    for (int u = 0; u < nu; u++)
                     {
-                        size_t idx4 = (size_t)(startZ + dz) * Chunk::SIZE_X + (startX + wx);
-                        mask[idx4] = -1;
+                        int p[3];
+                        p[d] = layer; p[du] = u; p[dv] = v;
+                        int id = cellAt(p);
+                        int& m = mask[(size_t)v * nu + u];
+                        m = -1;
+                        if (id <= 0) continue;
+
+                        p[d] += dir;
+                        if (p[d] < 0 || p[d] >= dims[d]) {
+                            // Outside the array: a border face (seams own those for chunks)
+                            if (!emitBorderFaces) continue;
+                        }
+                        if (hasFace(id, cellAt(p))) {
+                            m = id;
+                        }
                     }
                 }
-                startX += width;
+
+                int slice = (dir > 0) ? (layer + 1) * scale[d] - 1 : layer * scale[d];
+                emitMaskQuads(mask, nu, nv, face, slice,
+                    scale[du], scale[dv], worldOffsetX, worldOffsetY, worldOffsetZ,
+                    outVertices, outIndices, outTranslucent, useGreedy);
             }
+            outFaceEnds.mark(face, outVertices, outTranslucent);
         }
     }
-
-    std::cout << "[Mesh Debug] Chunk(" << cx << "," << cy << "," << cz
-        << ") => " << outVertices.size() << " verts, "
-        << outIndices.size() << " inds\n";
 }
 
-void ChunkMesher::generateMeshFromArray(
-    const std::vector<int>& voxelArray,
-    int dsX, int dsY, int dsZ,
+/**
+ * Seam faces on one chunk face. Both layers are sampled on the finer of
+ * the two grids, so a coarse cell simply covers 2x2 (or 4x4) fine cells:
+ * A gets a face wherever its cell is solid and B's is a different ID,
+ * exactly what A's own mesh would emit if B were meshed at A's LOD.
+ * B's seam on the opposite face covers the rest of the plane, so the
+ * two sides close up whatever LODs they are drawn at.
+ */
+void ChunkMesher::buildLODBoundaryStitch(
+    int face,
+    const std::vector<int>& layerA,
+    int lodA,
+    const std::vector<int>& layerB,
+    int lodB,
     int worldOffsetX, int worldOffsetY, int worldOffsetZ,
     std::vector<Vertex>& outVertices,
     std::vector<uint32_t>& outIndices,
-    bool useGreedy
+    uint32_t* outOpaqueIndexCount
 )
 {
+    PROFILE_ZONE("Seam Mesh");
     outVertices.clear();
     outIndices.clear();
 
-    // If you want to do a naive approach ignoring neighbors or
-    // do a partial "greedy" ignoring cross-chunk merges
-    // (same code as original).
+    const bool hasB = !layerB.empty();
+    const int fine = hasB ? std::min(lodA, lodB) : lodA;
+    const int n = Chunk::SIZE_X >> fine;
+    const int nA = Chunk::SIZE_X >> lodA;
+    const int nB = Chunk::SIZE_X >> lodB;
+    const int shiftA = lodA - fine;
+    const int shiftB = lodB - fine;
+
+    Scratch& scratch = threadScratch();
+    std::vector<int>& mask = scratch.mask;
+    mask.assign((size_t)n * n, -1);
+    for (int v = 0; v < n; v++)
+    {
+        for (int u = 0; u < n; u++)
+        {
+            int a = layerA[(size_t)(u >> shiftA) + (size_t)nA * (v >> shiftA)];
+            if (a <= 0) continue;
 
-    // We'll keep basically the same approach you had before:
-    //  - if useGreedy => combine faces internally
-    //  - no cross-chunk adjacency considered for LOD
+            int b = hasB ? layerB[(size_t)(u >> shiftB) + (size_t)nB * (v >> shiftB)] : 0;
+            if (hasFace(a, b)) {
+                mask[(size_t)v * n + u] = a;
+            }
+        }
+    }
 
-    // For brevity, not re-pasting entire code. See original snippet.
-    // [You placed it in your prior code. Just keep that or adapt as needed.]
+    // Outermost voxel layer on this face (positive faces add +1 in the helper)
+    const int slice = (face % 2 == 0) ? Chunk::SIZE_X - 1 : 0;
+    TranslucentQuads& translucent = scratch.translucent;
+    translucent.clear();
+    emitMaskQuads(mask, n, n, face, slice, 1 << fine, 1 << fine,
+        worldOffsetX, worldOffsetY, worldOffsetZ, outVertices, outIndices, translucent, true);
+    appendTranslucent(outVertices, outIndices, translucent, outOpaqueIndexCount);
 }
 
-/**
- * A placeholder for how you'd build bridging geometry between chunkA (lodA)
- * and chunkB (lodB).
- */
-void ChunkMesher::buildLODBoundaryStitch(
-    const Chunk& chunkA,
-    int lodA,
-    const Chunk& chunkB,
-    int lodB,
+void ChunkMesher::emitMaskQuads(
+    std::vector<int>& mask,
+    int nu, int nv,
+    int face, int slice,
+    int scaleU, int scaleV,
+    int worldOffsetX, int worldOffsetY, int worldOffsetZ,
     std::vector<Vertex>& outVertices,
-    std::vector<uint32_t>& outIndices
+    std::vector<uint32_t>& outIndices,
+    TranslucentQuads& outTranslucent,
+    bool useGreedy
 )
 {
-    // For instance, if chunkA is LOD0 (16x16) on that boundary,
-    // while chunkB is LOD1 (8x8), you can subdivide or merge 
-    // to produce a "strip" that seamlessly connects them.
-
-    // The actual shape building is entirely up to you. 
-    // Some pseudo-logic:
-    //
-    // 1) Identify the line of boundary points in chunkA.
-    // 2) Identify the line of boundary points in chunkB.
-    // 3) Generate triangles bridging them. Possibly 2 triangles for each sub-square.
-    //
-    // We won't implement it fully here. This is just the placeholder.
+    // Greedy merge (or 1x1 quads)
+    for (int row = 0; row < nv; row++)
+    {
+        int col = 0;
+        while (col < nu)
+        {
+            int bid = mask[(size_t)row * nu + col];
+            if (bid < 0) { col++; continue; }
+
+            int width = 1;
+            int height = 1;
+            if (useGreedy)
+            {
+                while (col + width < nu && mask[(size_t)row * nu + col + width] == bid) {
+                    width++;
+                }
+                bool done = false;
+                while (!done && row + height < nv)
+                {
+                    for (int c2 = 0; c2 < width; c2++)
+                    {
+                        if (mask[(size_t)(row + height) * nu + col + c2] != bid) {
+                            done = true;
+                            break;
+                        }
+                    }
+                    if (!done) height++;
+                }
+            }
+
+            // Voxel-space quad; positive faces add +1 inside the helper
+            int u0 = col * scaleU;
+            int v0 = row * scaleV;
+            int w = width * scaleU;
+            int h = height * scaleV;
+
+            const bool translucent = (m_props.cullClass[bid] == VoxelCullClass::Translucent);
+            std::vector<Vertex>& verts = translucent ? outTranslucent.verts : outVertices;
+            std::vector<uint32_t>& inds = translucent ? outTranslucent.inds : outIndices;
+            switch (face)
+            {
+            case 0: buildQuadPosX(u0, v0, w, h, slice, worldOffsetX, worldOffsetY, worldOffsetZ, bid, verts, inds); break;
+            case 1: buildQuadNegX(u0, v0, w, h, slice, worldOffsetX, worldOffsetY, worldOffsetZ, bid, verts, inds); break;
+            case 2: buildQuadPosY(u0, v0, w, h, slice, worldOffsetX, worldOffsetY, worldOffsetZ, bid, verts, inds); break;
+            case 3: buildQuadNegY(u0, v0, w, h, slice, worldOffsetX, worldOffsetY, worldOffsetZ, bid, verts, inds); break;
+            case 4: buildQuadPosZ(u0, v0, w, h, slice, worldOffsetX, worldOffsetY, worldOffsetZ, bid, verts, inds); break;
+            default: buildQuadNegZ(u0, v0, w, h, slice, worldOffsetX, worldOffsetY, worldOffsetZ, bid, verts, inds); break;
+            }
+
+            for (int rr = 0; rr < height; rr++) {
+                for (int cc = 0; cc < width; cc++) {
+                    mask[(size_t)(row + rr) * nu + col + cc] = -1;
+                }
+            }
+            col += width;
+        }
+    }
 }
 
 void ChunkMesher::buildQuadPosZ(
@@ -565,8 +765,8 @@ void ChunkMesher::buildQuadPosZ(
     std::vector<uint32_t>& outIndices
 )
 {
-    const VoxelType& vt = VoxelTypeRegistry::get().getVoxel(blockID);
-    float r = vt.color.r, g = vt.color.g, b = vt.color.b;
+    const VoxelPropertyTable::Color& color = m_props.color[blockID];
+    float r = color.r, g = color.g, b = color.b;
 
     float zPos = float(z + 1 + offsetZ);
     float X0 = float(startX + offsetX);
@@ -580,6 +780,7 @@ void ChunkMesher::buildQuadPosZ(
     outVertices.push_back(Vertex(X1, Y1, zPos, r, g, b));
     outVertices.push_back(Vertex(X0, Y1, zPos, r, g, b));
 
+    if (!m_buildIndices) return;
     outIndices.push_back(startIndex + 0);
     outIndices.push_back(startIndex + 1);
     outIndices.push_back(startIndex + 2);
@@ -595,8 +796,8 @@ void ChunkMesher::buildQuadNegZ(
     std::vector<uint32_t>& outIndices
 )
 {
-    const VoxelType& vt = VoxelTypeRegistry::get().getVoxel(blockID);
-    float r = vt.color.r, g = vt.color.g, b = vt.color.b;
+    const VoxelPropertyTable::Color& color = m_props.color[blockID];
+    float r = color.r, g = color.g, b = color.b;
 
     float zPos = float(z + offsetZ);
 
@@ -612,6 +813,7 @@ void ChunkMesher::buildQuadNegZ(
     outVertices.push_back(Vertex(X0, Y1, zPos, r, g, b));
     outVertices.push_back(Vertex(X1, Y1, zPos, r, g, b));
 
+    if (!m_buildIndices) return;
     outIndices.push_back(startIndex + 0);
     outIndices.push_back(startIndex + 1);
     outIndices.push_back(startIndex + 2);
@@ -627,8 +829,8 @@ void ChunkMesher::buildQuadPosX(
     std::vector<uint32_t>& outIndices
 )
 {
-    const VoxelType& vt = VoxelTypeRegistry::get().getVoxel(blockID);
-    float r = vt.color.r, g = vt.color.g, b = vt.color.b;
+    const VoxelPropertyTable::Color& color = m_props.color[blockID];
+    float r = color.r, g = color.g, b = color.b;
 
     float xPos = float((x + 1) + offsetX);
     float Y0 = float(startY + offsetY);
@@ -643,6 +845,7 @@ void ChunkMesher::buildQuadPosX(
     outVertices.push_back(Vertex(xPos, Y1, Z1, r, g, b));
     outVertices.push_back(Vertex(xPos, Y1, Z0, r, g, b));
 
+    if (!m_buildIndices) return;
     outIndices.push_back(startIndex + 0);
     outIndices.push_back(startIndex + 1);
     outIndices.push_back(startIndex + 2);
@@ -658,8 +861,8 @@ void ChunkMesher::buildQuadNegX(
     std::vector<uint32_t>& outIndices
 )
 {
-    const VoxelType& vt = VoxelTypeRegistry::get().getVoxel(blockID);
-    float r = vt.color.r, g = vt.color.g, b = vt.color.b;
+    const VoxelPropertyTable::Color& color = m_props.color[blockID];
+    float r = color.r, g = color.g, b = color.b;
 
     float xPos = float(x + offsetX);
     float Y0 = float(startY + offsetY);
@@ -674,6 +877,7 @@ void ChunkMesher::buildQuadNegX(
     outVertices.push_back(Vertex(xPos, Y1, Z0, r, g, b));
     outVertices.push_back(Vertex(xPos, Y1, Z1, r, g, b));
 
+    if (!m_buildIndices) return;
     outIndices.push_back(startIndex + 0);
     outIndices.push_back(startIndex + 1);
     outIndices.push_back(startIndex + 2);
@@ -689,8 +893,8 @@ void ChunkMesher::buildQuadPosY(
     std::vector<uint32_t>& outIndices
 )
 {
-    const VoxelType& vt = VoxelTypeRegistry::get().getVoxel(blockID);
-    float r = vt.color.r, g = vt.color.g, b = vt.color.b;
+    const VoxelPropertyTable::Color& color = m_props.color[blockID];
+    float r = color.r, g = color.g, b = color.b;
 
     float yPos = float((y + 1) + offsetY);
     float X0 = float(startX + offsetX);
@@ -705,6 +909,7 @@ void ChunkMesher::buildQuadPosY(
     outVertices.push_back(Vertex(X1, yPos, Z1, r, g, b));
     outVertices.push_back(Vertex(X0, yPos, Z1, r, g, b));
 
+    if (!m_buildIndices) return;
     outIndices.push_back(startIndex + 0);
     outIndices.push_back(startIndex + 1);
     outIndices.push_back(startIndex + 2);
@@ -720,8 +925,8 @@ void ChunkMesher::buildQuadNegY(
     std::vector<uint32_t>& outIndices
 )
 {
-    const VoxelType& vt = VoxelTypeRegistry::get().getVoxel(blockID);
-    float r = vt.color.r, g = vt.color.g, b = vt.color.b;
+    const VoxelPropertyTable::Color& color = m_props.color[blockID];
+    float r = color.r, g = color.g, b = color.b;
 
     float yPos = float(y + offsetY);
     float X0 = float(startX + offsetX);
@@ -736,6 +941,7 @@ void ChunkMesher::buildQuadNegY(
     outVertices.push_back(Vertex(X0, yPos, Z1, r, g, b));
     outVertices.push_back(Vertex(X1, yPos, Z1, r, g, b));
 
+    if (!m_buildIndices) return;
     outIndices.push_back(startIndex + 0);
     outIndices.push_back(startIndex + 1);
     outIndices.push_back(startIndex + 2);
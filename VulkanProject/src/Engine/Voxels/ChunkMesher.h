@@ -1,8 +1,10 @@
 #pragma once
 
 #include <vector>
+#include <cstdint>
+#include <atomic>
 #include "Chunk.h"
-#include "ChunkManager.h"
+#include "VoxelPropertyTable.h"
 
 /**
  * Represents a single mesh vertex with position + color (or other).
@@ -19,31 +21,62 @@ struct Vertex
     {}
 };
 
+/**
+ * Optional per-stage timings reported by ChunkMesher::buildLODMesh.
+ */
+struct MeshBuildTimings
+{
+    uint64_t downsampleNs = 0; // 0 for LOD0
+    uint64_t meshNs = 0;
+};
+
 /**
  * The ChunkMesher class can build:
- *  - Normal LOD geometry for each chunk
- *  - Optional seam geometry bridging chunk boundaries
+ *  - Normal LOD geometry for each chunk (interior faces only)
+ *  - Seam geometry for the faces on each chunk border
+ *
+ * Faces are culled by cull class (VoxelCullClass): a voxel shows a face
+ * towards any neighbour that is neither opaque nor the same type, so
+ * buried opaque-opaque interfaces emit nothing and water only has faces
+ * against air. Every mesh lists its opaque quads first and its
+ * translucent ones after; builders report where the translucent index
+ * range starts (`outOpaqueIndexCount`) so it can be drawn in a second,
+ * blended pass. Within each pass quads go face direction by face
+ * direction (+X first, -Z last); `outFaceRanges` reports where each
+ * direction's run starts, so a renderer can skip the ones facing away.
  */
 class ChunkMesher
 {
 public:
+    /**
+     * `properties` is the frozen voxel table (VoxelTypeRegistry::getProperties);
+     * it must outlive the mesher.
+     */
+    explicit ChunkMesher(const VoxelPropertyTable& properties) : m_props(properties) {}
+
+    /// The voxel table meshes (and Chunk's mip chains) are built against.
+    const VoxelPropertyTable& getProperties() const { return m_props; }
+
     /**
      * Generates a "greedy" mesh for LOD0 (or the chunks data).
-     * Checks neighbor blocks to skip hidden faces.
+     * Skips hidden faces inside the chunk; faces on the chunk border are
+     * left to the seam meshes (buildLODBoundaryStitch).
      */
     void generateMeshGreedy(
         const Chunk& chunk,
-        int cx, int cy, int cz,
         std::vector<Vertex>& outVertices,
         std::vector<uint32_t>& outIndices,
         int offsetX, int offsetY, int offsetZ,
-        const ChunkManager& manager
+        uint32_t* outOpaqueIndexCount = nullptr,
+        MeshFaceRanges* outFaceRanges = nullptr
     );
 
     /**
      * Builds a mesh from a downsampled array (for LOD1, LOD2, etc.).
      * Optionally merges internal faces if useGreedy==true.
-     * Does NOT do cross-chunk boundaries for LODs.
+     * Outside the array counts as air; with emitBorderFaces==false the
+     * faces on the array's border are skipped instead (chunk LODs, whose
+     * borders come from the seams).
      */
     void generateMeshFromArray(
         const std::vector<int>& voxelArray,
@@ -51,55 +84,282 @@ public:
         int worldOffsetX, int worldOffsetY, int worldOffsetZ,
         std::vector<Vertex>& outVertices,
         std::vector<uint32_t>& outIndices,
-        bool useGreedy = false
+        bool useGreedy = false,
+        bool emitBorderFaces = true,
+        uint32_t* outOpaqueIndexCount = nullptr,
+        MeshFaceRanges* outFaceRanges = nullptr
+    );
+
+    /**
+     * Meshes groupSize x groupSize chunks (x, then z) of one layer as a
+     * single far-field mesh. memberVoxels[mx + groupSize * mz] is that
+     * member's mip level `lodLevel` (Chunk::copyMipLevel); an empty entry
+     * counts as air. Offsets are the world position of member (0, 0).
+     */
+    void buildSuperChunkMesh(
+        const std::vector<std::vector<int>>& memberVoxels,
+        int groupSize,
+        int lodLevel,
+        int worldOffsetX, int worldOffsetY, int worldOffsetZ,
+        std::vector<Vertex>& outVertices,
+        std::vector<uint32_t>& outIndices,
+        uint32_t* outOpaqueIndexCount = nullptr,
+        MeshFaceRanges* outFaceRanges = nullptr
+    );
+
+    /**
+     * Builds one LOD of a chunk: LOD0 is the greedy mesh, higher LODs mesh
+     * the chunk's cached voxel mip level (Chunk::copyMipLevel). Border
+     * faces are not included, see buildLODBoundaryStitch. Shared by
+     * VoxelWorld's meshing jobs and the headless benchmark.
+     * With `outSlices`, LOD0 is built segmented (buildSegmentedMesh); its
+     * face ranges then end at the spare slots, which may hold any
+     * direction once edits move slices there.
+     */
+    void buildLODMesh(
+        const Chunk& chunk,
+        int cx, int cy, int cz,
+        int lodLevel,
+        std::vector<Vertex>& outVertices,
+        std::vector<uint32_t>& outIndices,
+        MeshBuildTimings* outTimings = nullptr,
+        MeshSliceLayout* outSlices = nullptr,
+        uint32_t* outOpaqueIndexCount = nullptr,
+        MeshFaceRanges* outFaceRanges = nullptr
     );
 
+    /**
+     * LOD0 mesh laid out for in-place edits: each of the 6 x SIZE_X slices
+     * (face direction, voxel layer) gets a run of quad slots with some
+     * slack in each pass (opaque, then translucent), and each pass ends in
+     * spare slots for slices that outgrow theirs. The opaque index range
+     * is the first outLayout.passEnd[0] quads.
+     * Unused slots hold degenerate quads and the indices are the fixed
+     * quad pattern over every slot, so patching a slice only rewrites its
+     * vertices. A chunk without faces gives an empty mesh and layout.
+     */
+    void buildSegmentedMesh(
+        const Chunk& chunk,
+        int cx, int cy, int cz,
+        std::vector<Vertex>& outVertices,
+        std::vector<uint32_t>& outIndices,
+        MeshSliceLayout& outLayout
+    );
+
+    /**
+     * Quads of one LOD0 slice (face direction `face`, voxel layer `layer`
+     * along its axis), four vertices each, no indices, split into opaque
+     * and translucent ones. The same faces generateMeshGreedy emits for
+     * that slice.
+     */
+    void buildSliceQuads(
+        const Chunk& chunk,
+        int face, int layer,
+        int offsetX, int offsetY, int offsetZ,
+        std::vector<Vertex>& outVertices,
+        std::vector<Vertex>& outTranslucentVertices
+    );
+
+    /// Quad slots a slice with `quads` quads gets in a segmented mesh.
+    static uint16_t sliceCapacity(int quads);
+
+    /// Pads (or trims) `verts` to `quads` quads with degenerate ones.
+    static void padQuads(std::vector<Vertex>& verts, size_t quads);
+
+    /// Quads one draw can address with 16-bit shared quad indices (65536 vertices)
+    static const uint32_t SHARED_INDEX_QUADS = 16384;
+
+    /// The fixed quad index pattern (0,1,2,2,3,0, +4 per quad) for `quads` quads
+    static void buildQuadIndexPattern(uint32_t quads, std::vector<uint16_t>& out);
+
+    /**
+     * Splits a built mesh (quad q = vertices [4q, 4q + 4), indices
+     * [6q, 6q + 6), opaque quads first) into meshlets of at most
+     * Meshlet::MAX_QUADS quads, in index order, none crossing a range of
+     * `faceRanges` or the pass boundary. Padding quads don't widen boxes.
+     */
+    static void buildMeshlets(const std::vector<Vertex>& verts, uint32_t opaqueIndexCount,
+        const MeshFaceRanges& faceRanges, std::vector<Meshlet>& outMeshlets);
+
+    /**
+     * Widens the boxes of the meshlets holding vertices [firstVertex,
+     * firstVertex + verts.size()) to the quads now written there (slice
+     * patches). Boxes never shrink, so they stay conservative.
+     */
+    static void growMeshlets(std::vector<Meshlet>& meshlets, uint32_t firstVertex,
+        const std::vector<Vertex>& verts);
+
+    /**
+     * Whether builders emit indices (the default). Turned off for sinks
+     * that draw with shared quad indices (MeshSink::usesSharedQuadIndices):
+     * outIndices then stays empty and quad q implicitly uses indices
+     * [6q, 6q + 6), which is also how opaque index counts are reported.
+     * Set before the first build.
+     */
+    void setBuildIndices(bool build) { m_buildIndices = build; }
+    bool getBuildIndices() const { return m_buildIndices; }
+
     /**
      * (Legacy) If LOD0 is dirty, build the chunk. This remains basically
      * the same but references the new generateMeshGreedy method.
      */
     bool generateChunkMeshIfDirty(
         Chunk& chunk,
-        int cx, int cy, int cz,
         std::vector<Vertex>& outVertices,
         std::vector<uint32_t>& outIndices,
         int offsetX, int offsetY, int offsetZ,
-        const ChunkManager& manager,
         bool useGreedy = true
     );
 
+    /**
+     * How LOD1+ voxels are reduced (see MipReduction). Meshes built after
+     * a change use the new mode; the caller re-dirties existing LODs.
+     */
+    void         setMipReduction(MipReduction mode) { m_mipReduction.store(mode); }
+    MipReduction getMipReduction() const { return m_mipReduction.load(); }
+
     // -------------------------------------------------------------------------
-    // SEAM / STITCH Methods (placeholders)
+    // SEAM / STITCH Methods
     // -------------------------------------------------------------------------
     /**
-     * Build a "stitch" mesh bridging chunk As face with chunk Bs face,
-     * if they differ by exactly 1 in LOD.
-     *
-     * This is a placeholder demonstration. The full logic depends on how
-     * you want to morph or subdivide the boundary.
+     * Builds the border faces of chunk A on one face (Chunk::SeamDirection)
+     * against its neighbor B across that face. layerA / layerB are the two
+     * outermost layers touching the shared plane (Chunk::copyBoundaryLayer)
+     * at the LOD each side is drawn at; an empty layerB means no neighbor
+     * (air). The LODs may differ by any amount. Pure function of its
+     * inputs, so it runs on worker threads.
      */
     void buildLODBoundaryStitch(
-        const Chunk& chunkA,
+        int face,
+        const std::vector<int>& layerA,
         int lodA,
-        const Chunk& chunkB,
+        const std::vector<int>& layerB,
         int lodB,
-        // Possibly info about the shared boundary or direction
-        // ...
+        int worldOffsetX, int worldOffsetY, int worldOffsetZ,
         std::vector<Vertex>& outVertices,
-        std::vector<uint32_t>& outIndices
+        std::vector<uint32_t>& outIndices,
+        uint32_t* outOpaqueIndexCount = nullptr
     );
 
 private:
+    const VoxelPropertyTable& m_props;
+    std::atomic<MipReduction> m_mipReduction{ MipReduction::SurfacePreserving };
+    bool m_buildIndices = true;
+
+    /// Translucent quads of a mesh being built, appended after the opaque ones
+    struct TranslucentQuads
+    {
+        std::vector<Vertex>   verts;
+        std::vector<uint32_t> inds;
+
+        void clear() { verts.clear(); inds.clear(); }
+    };
+
+    /// Quads in each pass where each face direction's run ends, recorded while building
+    struct FaceQuadEnds
+    {
+        uint32_t end[MeshSliceLayout::PASS_COUNT][MeshFaceRanges::FACE_COUNT] = {};
+
+        void mark(int face, const std::vector<Vertex>& opaque, const TranslucentQuads& translucent)
+        {
+            end[0][face] = (uint32_t)(opaque.size() / 4);
+            end[1][face] = (uint32_t)(translucent.verts.size() / 4);
+        }
+    };
 
     /**
-     * Helper that returns block ID from current or neighbor chunk,
-     * or 0 if neighbor is missing.  (Used in LOD0 to skip faces.)
+     * Per-thread working memory reused by every build on that thread, so
+     * meshing in steady state doesn't allocate (outputs are the caller's,
+     * see MeshBufferPool). Builders that call one another use different
+     * members: `cells` holds buildLODMesh's mip level or the superchunk
+     * array while meshCellArray uses `mask`.
      */
-    static int getBlockIDGlobal(
-        const Chunk& currentChunk,
-        int cx, int cy, int cz,
-        int x, int y, int z,
-        const ChunkManager& manager
+    struct Scratch
+    {
+        std::vector<int>      mask;
+        std::vector<int>      cells;
+        TranslucentQuads      translucent;
+        std::vector<Vertex>   translucentRuns; // buildSegmentedMesh
+        std::vector<uint32_t> discardedIndices; // indices rebuilt or not wanted
+    };
+
+    /// This thread's Scratch
+    static Scratch& threadScratch();
+
+    /// Whether voxel `id` shows a face towards `neighbor` (see class comment)
+    bool hasFace(int id, int neighbor) const
+    {
+        return id > 0 && neighbor != id && !m_props.isOpaque(neighbor);
+    }
+
+    /**
+     * Appends `translucent` to the mesh and stores the opaque index count
+     * (the translucent range's first index) if `outOpaqueIndexCount` is set.
+     */
+    static void appendTranslucent(
+        std::vector<Vertex>& outVertices,
+        std::vector<uint32_t>& outIndices,
+        const TranslucentQuads& translucent,
+        uint32_t* outOpaqueIndexCount
+    );
+
+    /**
+     * Turns `ends` into index ranges (nullptr is ignored), with the
+     * translucent quads placed behind the opaque ones by appendTranslucent.
+     */
+    static void storeFaceRanges(const FaceQuadEnds& ends, MeshFaceRanges* outFaceRanges);
+
+    /// Face ranges of a segmented mesh, from its freshly built slice table
+    static void storeFaceRanges(const MeshSliceLayout& layout, MeshFaceRanges* outFaceRanges);
+
+    /**
+     * Face mask of one LOD0 slice, greedy-merged into quads. Chunk-border
+     * faces are skipped (seams). `mask` is scratch.
+     */
+    void meshSlice(
+        const Chunk& chunk,
+        int face, int layer,
+        int offsetX, int offsetY, int offsetZ,
+        std::vector<int>& mask,
+        std::vector<Vertex>& outVertices,
+        std::vector<uint32_t>& outIndices,
+        TranslucentQuads& outTranslucent
+    );
+
+    /**
+     * Greedy/plain face extraction over a dims[0] x dims[1] x dims[2] cell
+     * array where one cell spans scale[axis] voxels. Appends to the output,
+     * marking each face direction's end in `outFaceEnds`.
+     */
+    void meshCellArray(
+        const std::vector<int>& cells,
+        const int dims[3],
+        const int scale[3],
+        int worldOffsetX, int worldOffsetY, int worldOffsetZ,
+        std::vector<Vertex>& outVertices,
+        std::vector<uint32_t>& outIndices,
+        TranslucentQuads& outTranslucent,
+        FaceQuadEnds& outFaceEnds,
+        bool useGreedy,
+        bool emitBorderFaces
+    );
+
+    /**
+     * Turns an nu x nv face mask (block ID or -1) for one face direction
+     * into quads and clears it. `slice` is the voxel layer the faces sit
+     * on; one mask cell spans scaleU x scaleV voxels. Quads of translucent
+     * types go to `outTranslucent`.
+     */
+    void emitMaskQuads(
+        std::vector<int>& mask,
+        int nu, int nv,
+        int face, int slice,
+        int scaleU, int scaleV,
+        int worldOffsetX, int worldOffsetY, int worldOffsetZ,
+        std::vector<Vertex>& outVertices,
+        std::vector<uint32_t>& outIndices,
+        TranslucentQuads& outTranslucent,
+        bool useGreedy
     );
 
     // -------------------------------------------------------------------------
@@ -0,0 +1,316 @@
+#include "ChunkQuadtree.h"
+#include "Chunk.h"
+
+#include <algorithm>
+
+namespace
+{
+    // v / d rounded toward -infinity
+    int floorDiv(int v, int d)
+    {
+        return (v >= 0) ? v / d : -((-v + d - 1) / d);
+    }
+
+    // Cell of the next level up
+    int parentCell(int v)
+    {
+        return floorDiv(v, 2);
+    }
+
+    int leafCell(int column)
+    {
+        return floorDiv(column, ChunkQuadtree::LEAF_COLUMNS);
+    }
+
+    float distanceSq(const glm::vec3& p, const glm::vec3& minB, const glm::vec3& maxB)
+    {
+        float dx = std::max(std::max(minB.x - p.x, 0.0f), p.x - maxB.x);
+        float dy = std::max(std::max(minB.y - p.y, 0.0f), p.y - maxB.y);
+        float dz = std::max(std::max(minB.z - p.z, 0.0f), p.z - maxB.z);
+        return dx * dx + dy * dy + dz * dz;
+    }
+}
+
+uint64_t ChunkQuadtree::cellKey(int x, int z)
+{
+    return ((uint64_t)(uint32_t)x << 32) | (uint64_t)(uint32_t)z;
+}
+
+bool ChunkQuadtree::chunkBounds(const Chunk& chunk, glm::vec3& outMin, glm::vec3& outMax)
+{
+    if (chunk.isEmpty()) return false;
+
+    const std::vector<int>& blocks = chunk.getBlocks();
+    int minY = Chunk::SIZE_Y, maxY = -1;
+    for (int y = 0; y < Chunk::SIZE_Y; y++)
+    {
+        bool any = false;
+        for (int z = 0; z < Chunk::SIZE_Z && !any; z++)
+        {
+            const int* row = &blocks[(size_t)Chunk::SIZE_X * (y + Chunk::SIZE_Y * z)];
+            for (int x = 0; x < Chunk::SIZE_X; x++) {
+                if (row[x] != 0) { any = true; break; }
+            }
+        }
+        if (any) {
+            minY = std::min(minY, y);
+            maxY = y;
+        }
+    }
+    if (maxY < 0) return false;
+
+    const int cell = 1 << (Chunk::MAX_LOD_LEVELS - 1);
+    minY = minY / cell * cell;
+    maxY = (maxY / cell + 1) * cell;
+
+    chunk.getBoundingBox(outMin, outMax);
+    outMax.y = outMin.y + float(maxY);
+    outMin.y += float(minY);
+    return true;
+}
+
+ChunkQuadtree::Node* ChunkQuadtree::getOrCreate(int level, int x, int z)
+{
+    auto inserted = m_levels[level].emplace(cellKey(x, z), Node());
+    Node* node = &inserted.first->second;
+    if (!inserted.second) return node;
+
+    node->level = level;
+    node->x = x;
+    node->z = z;
+    if (level + 1 < LEVELS)
+    {
+        Node* parent = getOrCreate(level + 1, parentCell(x), parentCell(z));
+        const int slot = (x - 2 * parent->x) + 2 * (z - 2 * parent->z);
+        parent->children[slot] = node;
+        parent->childCount++;
+        node->parent = parent;
+    }
+    return node;
+}
+
+// Removes a node that has nothing left below it, then any parent left empty
+void ChunkQuadtree::erase(Node* node)
+{
+    while (node)
+    {
+        Node* parent = node->parent;
+        if (parent)
+        {
+            const int slot = (node->x - 2 * parent->x) + 2 * (node->z - 2 * parent->z);
+            parent->children[slot] = nullptr;
+            parent->childCount--;
+        }
+        m_levels[node->level].erase(cellKey(node->x, node->z));
+
+        if (!parent || parent->childCount > 0) {
+            propagate(parent);
+            return;
+        }
+        node = parent;
+    }
+}
+
+// Bounds and count from the entries / children; true if they changed
+bool ChunkQuadtree::recompute(Node& node)
+{
+    glm::vec3 minB(0.0f), maxB(0.0f);
+    bool hasBounds = false;
+    uint32_t count = 0;
+
+    auto grow = [&](const glm::vec3& lo, const glm::vec3& hi)
+    {
+        if (!hasBounds) {
+            minB = lo;
+            maxB = hi;
+            hasBounds = true;
+        }
+        else {
+            minB = glm::min(minB, lo);
+            maxB = glm::max(maxB, hi);
+        }
+    };
+
+    if (node.level == 0)
+    {
+        for (const Entry& e : node.entries)
+        {
+            if (!e.hasBounds) continue;
+            grow(e.minB, e.maxB);
+            count++;
+        }
+    }
+    else
+    {
+        for (const Node* child : node.children)
+        {
+            if (!child || !child->hasBounds) continue;
+            grow(child->minB, child->maxB);
+            count += child->chunkCount;
+        }
+    }
+
+    const bool changed = hasBounds != node.hasBounds || count != node.chunkCount
+        || (hasBounds && (minB != node.minB || maxB != node.maxB));
+    node.minB = minB;
+    node.maxB = maxB;
+    node.hasBounds = hasBounds;
+    node.chunkCount = count;
+    return changed;
+}
+
+// Recomputes up the parent chain until a node comes out unchanged
+void ChunkQuadtree::propagate(Node* node)
+{
+    while (node && recompute(*node)) {
+        node = node->parent;
+    }
+}
+
+void ChunkQuadtree::insert(Chunk* chunk)
+{
+    Node* leaf = getOrCreate(0, leafCell(chunk->worldX()), leafCell(chunk->worldZ()));
+    Entry entry;
+    entry.chunk = chunk;
+    entry.hasBounds = chunkBounds(*chunk, entry.minB, entry.maxB);
+    leaf->entries.push_back(entry);
+    m_chunkCount++;
+    propagate(leaf);
+}
+
+void ChunkQuadtree::remove(Chunk* chunk)
+{
+    auto it = m_levels[0].find(cellKey(leafCell(chunk->worldX()), leafCell(chunk->worldZ())));
+    if (it == m_levels[0].end()) return;
+
+    Node& leaf = it->second;
+    auto e = std::find_if(leaf.entries.begin(), leaf.entries.end(),
+        [chunk](const Entry& entry) { return entry.chunk == chunk; });
+    if (e == leaf.entries.end()) return;
+
+    leaf.entries.erase(e);
+    m_chunkCount--;
+    if (leaf.entries.empty()) {
+        erase(&leaf);
+    }
+    else {
+        propagate(&leaf);
+    }
+}
+
+void ChunkQuadtree::refresh(Chunk* chunk)
+{
+    auto it = m_levels[0].find(cellKey(leafCell(chunk->worldX()), leafCell(chunk->worldZ())));
+    if (it == m_levels[0].end()) return;
+
+    Node& leaf = it->second;
+    for (Entry& e : leaf.entries)
+    {
+        if (e.chunk != chunk) continue;
+
+        glm::vec3 minB, maxB;
+        const bool hasBounds = chunkBounds(*chunk, minB, maxB);
+        if (hasBounds == e.hasBounds && (!hasBounds || (minB == e.minB && maxB == e.maxB))) {
+            return;
+        }
+        e.minB = minB;
+        e.maxB = maxB;
+        e.hasBounds = hasBounds;
+        propagate(&leaf);
+        return;
+    }
+}
+
+void ChunkQuadtree::clear()
+{
+    for (auto& level : m_levels) {
+        level.clear();
+    }
+    m_chunkCount = 0;
+}
+
+size_t ChunkQuadtree::getNodeCount() const
+{
+    size_t count = 0;
+    for (const auto& level : m_levels) {
+        count += level.size();
+    }
+    return count;
+}
+
+void ChunkQuadtree::cull(const Frustum* frustum, const glm::vec3& eye, float maxDistance,
+    std::vector<Chunk*>& outInside,
+    AABBList& outCandidates,
+    std::vector<Chunk*>& outCandidateChunks,
+    CullStats* outStats) const
+{
+    outInside.clear();
+    outCandidates.clear();
+    outCandidateChunks.clear();
+
+    CullStats stats;
+    for (const auto& kv : m_levels[LEVELS - 1])
+    {
+        cullNode(kv.second, frustum, false, eye, maxDistance * maxDistance,
+            outInside, outCandidates, outCandidateChunks, stats);
+    }
+    if (outStats) *outStats = stats;
+}
+
+// `inside`: an ancestor is entirely inside the frustum, so no plane can cut
+// anything below it
+void ChunkQuadtree::cullNode(const Node& node, const Frustum* frustum, bool inside,
+    const glm::vec3& eye, float maxDistanceSq,
+    std::vector<Chunk*>& outInside, AABBList& outCandidates,
+    std::vector<Chunk*>& outCandidateChunks, CullStats& stats) const
+{
+    stats.nodesVisited++;
+    if (!node.hasBounds) return; // all air
+
+    if (distanceSq(eye, node.minB, node.maxB) > maxDistanceSq)
+    {
+        stats.nodesCulled++;
+        stats.chunksCulled += node.chunkCount;
+        return;
+    }
+    if (frustum && !inside)
+    {
+        const Frustum::Containment c = frustum->classifyAABB(node.minB, node.maxB);
+        if (c == Frustum::OUTSIDE)
+        {
+            stats.nodesCulled++;
+            stats.chunksCulled += node.chunkCount;
+            return;
+        }
+        inside = (c == Frustum::INSIDE);
+    }
+
+    if (node.level > 0)
+    {
+        for (const Node* child : node.children)
+        {
+            if (child) {
+                cullNode(*child, frustum, inside, eye, maxDistanceSq,
+                    outInside, outCandidates, outCandidateChunks, stats);
+            }
+        }
+        return;
+    }
+
+    for (const Entry& e : node.entries)
+    {
+        if (!e.hasBounds) continue;
+        if (distanceSq(eye, e.minB, e.maxB) > maxDistanceSq)
+        {
+            stats.chunksCulled++;
+            continue;
+        }
+        if (!frustum || inside) {
+            outInside.push_back(e.chunk);
+        }
+        else {
+            outCandidates.add(e.minB, e.maxB);
+            outCandidateChunks.push_back(e.chunk);
+        }
+    }
+}
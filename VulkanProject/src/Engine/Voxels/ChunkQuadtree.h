@@ -0,0 +1,118 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+#include <glm/glm.hpp>
+#include "Engine/Graphics/Frustum.h" // AABBList
+
+class Chunk;
+
+/**
+ * Quadtree over the loaded chunk columns (x, z), for culling whole areas of
+ * the world with one box test.
+ *
+ * Level 0 nodes are leaves of LEAF_COLUMNS x LEAF_COLUMNS columns holding
+ * their chunks. A node on level L covers 2^L leaves a side and links the
+ * (up to four) nodes of level L-1 inside it; level LEVELS-1 nodes are the
+ * roots. Nodes exist only where chunks are loaded, so the tree follows the
+ * streaming window.
+ *
+ * Every node keeps the union of its chunks' bounds. A chunk's bounds are
+ * its box narrowed in Y to the rows holding voxels, rounded out to the
+ * coarsest LOD's cells (a coarse voxel may draw past the rows it came
+ * from); all-air chunks have none and are never returned by cull().
+ * insert() and remove() update one path to a root, refresh() the same
+ * path but only as far as a node's bounds actually change.
+ *
+ * Not thread safe: ChunkManager, VoxelWorld's result polling and the
+ * renderer all use it from the main thread.
+ */
+class ChunkQuadtree
+{
+public:
+    static const int LEAF_COLUMNS = 4;
+    static const int LEVELS = 6; // a root covers 4 * 2^5 = 128 columns a side
+
+    struct CullStats
+    {
+        uint32_t nodesVisited = 0;
+        uint32_t nodesCulled = 0;   // subtrees dropped by one test
+        uint32_t chunksCulled = 0;  // in those subtrees, or out of range alone
+    };
+
+    ChunkQuadtree() = default;
+    ChunkQuadtree(const ChunkQuadtree&) = delete;
+    ChunkQuadtree& operator=(const ChunkQuadtree&) = delete;
+
+    void insert(Chunk* chunk);
+    void remove(Chunk* chunk);
+
+    /**
+     * Re-reads a chunk's bounds after its voxels changed (VoxelWorld calls
+     * it whenever it installs a new mesh for the chunk).
+     */
+    void refresh(Chunk* chunk);
+
+    void clear();
+
+    /**
+     * Chunks with a point of their bounds within maxDistance of the eye
+     * and, with a frustum, not outside it. Subtrees outside either are
+     * skipped whole. Chunks of subtrees entirely inside the frustum go to
+     * outInside; those of leaves crossing a plane to outCandidates and
+     * outCandidateChunks (same order), to be tested one by one (see
+     * Frustum::cullAABBs). Without a frustum every chunk in range goes to
+     * outInside. Clears the outputs first.
+     */
+    void cull(const Frustum* frustum, const glm::vec3& eye, float maxDistance,
+        std::vector<Chunk*>& outInside,
+        AABBList& outCandidates,
+        std::vector<Chunk*>& outCandidateChunks,
+        CullStats* outStats = nullptr) const;
+
+    size_t getChunkCount() const { return m_chunkCount; }
+    size_t getNodeCount() const;
+
+    /**
+     * A chunk's bounds as the tree uses them; false if it is all air.
+     */
+    static bool chunkBounds(const Chunk& chunk, glm::vec3& outMin, glm::vec3& outMax);
+
+private:
+    struct Entry
+    {
+        Chunk*    chunk = nullptr;
+        glm::vec3 minB, maxB;
+        bool      hasBounds = false;
+    };
+
+    struct Node
+    {
+        int       level = 0;
+        int       x = 0, z = 0;          // cell on its level
+        Node*     parent = nullptr;
+        Node*     children[4] = { nullptr, nullptr, nullptr, nullptr };
+        int       childCount = 0;
+        std::vector<Entry> entries;      // level 0 only
+        glm::vec3 minB, maxB;
+        bool      hasBounds = false;
+        uint32_t  chunkCount = 0;        // chunks with bounds below
+    };
+
+    static uint64_t cellKey(int x, int z);
+    Node* getOrCreate(int level, int x, int z);
+    void  erase(Node* node);
+    bool  recompute(Node& node);
+    void  propagate(Node* node);
+    void  cullNode(const Node& node, const Frustum* frustum, bool inside,
+        const glm::vec3& eye, float maxDistanceSq,
+        std::vector<Chunk*>& outInside, AABBList& outCandidates,
+        std::vector<Chunk*>& outCandidateChunks, CullStats& stats) const;
+
+    // Per level, cell => node. unordered_map nodes don't move, so the
+    // parent / child pointers stay valid as cells come and go.
+    std::unordered_map<uint64_t, Node> m_levels[LEVELS];
+    size_t m_chunkCount = 0;
+};
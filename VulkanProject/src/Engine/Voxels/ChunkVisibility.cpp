@@ -0,0 +1,89 @@
+#include "ChunkVisibility.h"
+#include "Chunk.h"
+
+namespace ChunkVisibility
+{
+    uint64_t computeFaceConnectivity(const std::vector<int>& blocks)
+    {
+        const int SX = Chunk::SIZE_X;
+        const int SY = Chunk::SIZE_Y;
+        const int SZ = Chunk::SIZE_Z;
+        const int total = SX * SY * SZ;
+
+        // Quick outs: all air or no air at all
+        int airCount = 0;
+        for (int i = 0; i < total; i++) {
+            if (blocks[i] == 0) airCount++;
+        }
+        if (airCount == total) return ALL_CONNECTED;
+        if (airCount == 0)     return NONE_CONNECTED;
+
+        std::vector<uint8_t>  visited(total, 0);
+        std::vector<uint16_t> stack;
+        stack.reserve(total);
+
+        uint64_t result = 0;
+
+        for (int seed = 0; seed < total; seed++)
+        {
+            if (visited[seed] || blocks[seed] != 0) continue;
+
+            // Flood one air region, collecting which chunk faces it touches
+            unsigned faceMask = 0;
+            visited[seed] = 1;
+            stack.push_back(static_cast<uint16_t>(seed));
+
+            while (!stack.empty())
+            {
+                int idx = stack.back();
+                stack.pop_back();
+
+                int x = idx % SX;
+                int y = (idx / SX) % SY;
+                int z = idx / (SX * SY);
+
+                if (x == SX - 1) faceMask |= 1u << 0; // +X
+                if (x == 0)      faceMask |= 1u << 1; // -X
+                if (y == SY - 1) faceMask |= 1u << 2; // +Y
+                if (y == 0)      faceMask |= 1u << 3; // -Y
+                if (z == SZ - 1) faceMask |= 1u << 4; // +Z
+                if (z == 0)      faceMask |= 1u << 5; // -Z
+
+                // 6-neighborhood inside the chunk
+                int nbr[6];
+                int n = 0;
+                if (x + 1 < SX) nbr[n++] = idx + 1;
+                if (x > 0)      nbr[n++] = idx - 1;
+                if (y + 1 < SY) nbr[n++] = idx + SX;
+                if (y > 0)      nbr[n++] = idx - SX;
+                if (z + 1 < SZ) nbr[n++] = idx + SX * SY;
+                if (z > 0)      nbr[n++] = idx - SX * SY;
+
+                for (int i = 0; i < n; i++)
+                {
+                    int ni = nbr[i];
+                    if (!visited[ni] && blocks[ni] == 0) {
+                        visited[ni] = 1;
+                        stack.push_back(static_cast<uint16_t>(ni));
+                    }
+                }
+            }
+
+            // Every pair of faces touched by this region can see each other
+            for (int a = 0; a < FACE_COUNT; a++)
+            {
+                if (!(faceMask & (1u << a))) continue;
+                for (int b = 0; b < FACE_COUNT; b++)
+                {
+                    if (faceMask & (1u << b)) {
+                        result |= 1ull << (a * FACE_COUNT + b);
+                    }
+                }
+            }
+
+            if (result == ALL_CONNECTED) break;
+        }
+
+        return result;
+    }
+}
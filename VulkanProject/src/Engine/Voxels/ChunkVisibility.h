@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+/**
+ * Chunk face connectivity for visibility-graph ("cave") culling.
+ *
+ * Faces use the same order as Chunk::SeamDirection:
+ *   +X=0, -X=1, +Y=2, -Y=3, +Z=4, -Z=5
+ *
+ * The connectivity of a chunk is a 6x6 symmetric matrix packed into the
+ * low 36 bits of a uint64_t: bit (a * 6 + b) is set if face 'a' and face 'b'
+ * are joined by a path through air voxels inside the chunk.
+ */
+namespace ChunkVisibility
+{
+    static const int      FACE_COUNT = 6;
+    static const uint64_t ALL_CONNECTED = 0xFFFFFFFFFull; // 36 bits
+    static const uint64_t NONE_CONNECTED = 0;
+
+    inline int oppositeFace(int face) { return face ^ 1; }
+
+    inline bool facesConnected(uint64_t connectivity, int faceA, int faceB)
+    {
+        return (connectivity >> (faceA * FACE_COUNT + faceB)) & 1ull;
+    }
+
+    /**
+     * Flood fills the air regions of a SIZE_X * SIZE_Y * SIZE_Z block array
+     * (indexed x + SIZE_X*(y + SIZE_Y*z)) and returns the packed matrix.
+     * An all-air chunk is fully connected, an all-solid one not at all.
+     */
+    uint64_t computeFaceConnectivity(const std::vector<int>& blocks);
+}
@@ -1,10 +1,14 @@
 #include "TerrainGenerator.h"
 #include <cmath>
+#include <atomic>
+#include "Engine/Utils/Profiler.h"
+#include "Engine/Voxels/BuiltinVoxels.h"
 
 // ---------- ADDED FOR TIMING ----------
 #include <chrono>        // for timing
-static double s_totalGenTime = 0.0;
-static int    s_genCount = 0;
+// Written from every worker thread, so atomic (nanoseconds, not double seconds)
+static std::atomic<uint64_t> s_totalGenTimeNs{ 0 };
+static std::atomic<int>      s_genCount{ 0 };
 // --------------------------------------
 
 // -----------------------------------------------------------------------------
@@ -23,9 +27,14 @@ TerrainGenerator::TerrainGenerator()
 // -----------------------------------------------------------------------------
 void TerrainGenerator::generateChunk(Chunk& chunk, int cx, int cy, int cz)
 {
+    PROFILE_ZONE("Generate Chunk");
     using namespace std::chrono;
     auto startTime = high_resolution_clock::now();
 
+    // Filled locally, then handed to the chunk in one go (one count pass,
+    // one dirty mark) instead of a setBlock per voxel
+    int blocks[Chunk::VOLUME] = {};
+
     // World offsets based on chunk coordinates
     int worldXOffset = cx * Chunk::SIZE_X;
     int worldZOffset = cz * Chunk::SIZE_Z;
@@ -52,30 +61,40 @@ void TerrainGenerator::generateChunk(Chunk& chunk, int cx, int cy, int cz)
             // Fill from y=0 up to y=heightVal
             for (int y = 0; y <= heightVal; y++)
             {
+                int idx = localX + Chunk::SIZE_X * (y + Chunk::SIZE_Y * localZ);
                 if (y == heightVal) {
-                    // Top layer => Grass (ID=2)
-                    chunk.setBlock(localX, y, localZ, 2);
+                    // Top layer => Grass
+                    blocks[idx] = BuiltinVoxels::GRASS;
                 }
                 else if (y >= heightVal - 2) {
-                    // Next two layers => Dirt (ID=3)
-                    chunk.setBlock(localX, y, localZ, 3);
+                    // Next two layers => Dirt
+                    blocks[idx] = BuiltinVoxels::DIRT;
                 }
                 else {
-                    // Below => Stone (ID=1)
-                chunk.setBlock(localX, y, localZ, 1);
+                    // Below => Stone
+                    blocks[idx] = BuiltinVoxels::STONE;
+                }
             }
         }
     }
-}
+
+    chunk.assignBlocks(blocks);
 
     auto endTime = high_resolution_clock::now();
-    double elapsedSec = duration<double>(endTime - startTime).count();
-    s_totalGenTime += elapsedSec;
-    s_genCount++;
+    s_totalGenTimeNs.fetch_add((uint64_t)duration_cast<nanoseconds>(endTime - startTime).count(),
+        std::memory_order_relaxed);
+    s_genCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+void TerrainGenerator::setSeed(int seed)
+{
+    m_seed = seed;
+    m_noise.SetSeed(m_seed);
 }
 
 double TerrainGenerator::getAvgGenTime()
 {
-    if (s_genCount == 0) return 0.0;
-    return s_totalGenTime / s_genCount;
+    int count = s_genCount.load(std::memory_order_relaxed);
+    if (count == 0) return 0.0;
+    return (s_totalGenTimeNs.load(std::memory_order_relaxed) / 1.0e9) / count;
 }
@@ -31,6 +31,11 @@ public:
      * @param cz    Chunk Z coordinate (in chunk-space).
      */
     void generateChunk(Chunk& chunk, int cx, int cy, int cz);
+
+    /**
+     * Re-seeds the noise generator. The same seed always produces the same world.
+     */
+    void setSeed(int seed);
     static double getAvgGenTime(); // <-- Add this
 
 private:
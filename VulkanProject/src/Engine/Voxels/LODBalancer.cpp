@@ -0,0 +1,119 @@
+#include "LODBalancer.h"
+
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include "ChunkManager.h"
+#include "Engine/Utils/Profiler.h"
+
+void LODBalancer::update(const ChunkManager& chunks, const LODPolicy& policy, const glm::vec3& viewerPos)
+{
+    PROFILE_ZONE("Balance LODs");
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point t0 = Clock::now();
+
+    m_changed.clear();
+    m_reassigned = 0;
+
+    const auto& allChunks = chunks.getAllChunks();
+    if (allChunks.empty()) {
+        m_lastTimeMs = 0.0;
+        return;
+    }
+
+    // 1) Bounding box of the loaded chunks
+    int minX = INT_MAX, minY = INT_MAX, minZ = INT_MAX;
+    int maxX = INT_MIN, maxY = INT_MIN, maxZ = INT_MIN;
+    for (auto& kv : allChunks)
+    {
+        const ChunkCoord& c = kv.first;
+        minX = std::min(minX, c.x); maxX = std::max(maxX, c.x);
+        minY = std::min(minY, c.y); maxY = std::max(maxY, c.y);
+        minZ = std::min(minZ, c.z); maxZ = std::max(maxZ, c.z);
+    }
+    m_minX = minX; m_minY = minY; m_minZ = minZ;
+    m_dimX = maxX - minX + 1;
+    m_dimY = maxY - minY + 1;
+    m_dimZ = maxZ - minZ + 1;
+
+    const size_t cellCount = (size_t)m_dimX * m_dimY * m_dimZ;
+    m_cells.assign(cellCount, nullptr);
+    m_desired.assign(cellCount, 0);
+    m_levels.assign(cellCount, 0);
+    for (int L = 0; L < LOD_COUNT; L++) {
+        m_buckets[L].clear();
+    }
+
+    // 2) Policy pick per chunk (hysteresis against its current target)
+    for (auto& kv : allChunks)
+    {
+        const ChunkCoord& c = kv.first;
+        Chunk* chunk = kv.second.get();
+        if (!chunk) continue;
+
+        size_t idx = (size_t)(c.x - m_minX)
+            + (size_t)m_dimX * ((size_t)(c.y - m_minY) + (size_t)m_dimY * (c.z - m_minZ));
+        float dist = LODPolicy::chunkDistance(c.x, c.y, c.z, viewerPos);
+        int lod = policy.selectLOD(dist, chunk->getTargetLOD());
+
+        m_cells[idx] = chunk;
+        m_desired[idx] = (int8_t)lod;
+        m_levels[idx] = (int8_t)lod;
+        m_buckets[lod].push_back((int)idx);
+    }
+
+    // 3) Finest first: a cell at level b caps its neighbors at b + 1.
+    //    Lowered cells join the next bucket; stale entries are skipped.
+    const int strideY = m_dimX;
+    const int strideZ = m_dimX * m_dimY;
+    for (int b = 0; b + 1 < LOD_COUNT; b++)
+    {
+        std::vector<int>& bucket = m_buckets[b];
+        std::vector<int>& next = m_buckets[b + 1];
+        for (size_t k = 0; k < bucket.size(); k++)
+        {
+            int idx = bucket[k];
+            if (m_levels[idx] != b) continue;
+
+            int x = idx % m_dimX;
+            int y = (idx / strideY) % m_dimY;
+            int z = idx / strideZ;
+            int neighbors[6];
+            int count = 0;
+            if (x > 0)            neighbors[count++] = idx - 1;
+            if (x + 1 < m_dimX)   neighbors[count++] = idx + 1;
+            if (y > 0)            neighbors[count++] = idx - strideY;
+            if (y + 1 < m_dimY)   neighbors[count++] = idx + strideY;
+            if (z > 0)            neighbors[count++] = idx - strideZ;
+            if (z + 1 < m_dimZ)   neighbors[count++] = idx + strideZ;
+
+            for (int n = 0; n < count; n++)
+            {
+                int j = neighbors[n];
+                if (m_cells[j] && m_levels[j] > b + 1)
+                {
+                    m_levels[j] = (int8_t)(b + 1);
+                    next.push_back(j);
+                }
+            }
+        }
+    }
+
+    // 4) Write back only what changed
+    for (size_t idx = 0; idx < cellCount; idx++)
+    {
+        Chunk* chunk = m_cells[idx];
+        if (!chunk) continue;
+
+        if (m_levels[idx] != m_desired[idx]) {
+            m_reassigned++;
+        }
+        if (m_levels[idx] != chunk->getTargetLOD())
+        {
+            chunk->setTargetLOD(m_levels[idx]);
+            m_changed.push_back(chunk);
+        }
+    }
+
+    m_lastTimeMs = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <glm/vec3.hpp>
+#include "Chunk.h"
+#include "LODPolicy.h"
+
+class ChunkManager;
+
+/**
+ * Assigns every loaded chunk its target LOD under the 2:1 rule: face
+ * neighbors differ by at most one level.
+ *
+ * Each update lays the loaded chunks out on a dense grid over their
+ * bounding box, takes LODPolicy's pick per chunk, then refines wherever a
+ * neighbor is finer by more than one level. The refinement is a bucket
+ * queue over the LOD levels (finest first), so a cell is lowered at most
+ * LOD_COUNT - 1 times and the whole pass is O(chunks) regardless of how
+ * far a constraint has to travel. Coarser never wins over finer.
+ *
+ * Only chunks whose target actually changed are reported, so the
+ * scheduler queues builds for those and not for everything it balanced.
+ * Main thread only.
+ */
+class LODBalancer
+{
+public:
+    /**
+     * Balances all loaded chunks and writes Chunk::setTargetLOD for the
+     * ones that changed (see getChangedChunks).
+     */
+    void update(const ChunkManager& chunks, const LODPolicy& policy, const glm::vec3& viewerPos);
+
+    /// Chunks whose target LOD changed during the last update.
+    const std::vector<Chunk*>& getChangedChunks() const { return m_changed; }
+
+    // Stats for the last update
+    int    getReassignCount() const { return m_reassigned; } // policy picks refined by the 2:1 rule
+    double getLastTimeMs() const { return m_lastTimeMs; }
+
+private:
+    static const int LOD_COUNT = LODPolicy::LOD_COUNT;
+
+    // Dense grid over the loaded chunks' bounding box (reused between updates)
+    int m_minX = 0, m_minY = 0, m_minZ = 0;
+    int m_dimX = 0, m_dimY = 0, m_dimZ = 0;
+    std::vector<Chunk*>  m_cells;   // nullptr => not loaded
+    std::vector<int8_t>  m_desired; // LODPolicy's pick
+    std::vector<int8_t>  m_levels;  // balanced result
+    std::vector<int>     m_buckets[LOD_COUNT];
+
+    std::vector<Chunk*> m_changed;
+    int    m_reassigned = 0;
+    double m_lastTimeMs = 0.0;
+};
@@ -1,210 +1,300 @@
 #include "LODDownsampler.h"
+#include "VoxelPropertyTable.h"
 #include <stdexcept>
 #include <algorithm>
-#include <vector>
-
-/**
- * Advanced downsampleVoxelData:
- *  - Factor = (1 << lodLevel).
- *  - For each (x,z) in the downsampled space, we scan the corresponding
- *    sub-block in the original data to find the highest solid block (if any),
- *    and detect if water or lava is present.
- *  - Then we fill that column in the LOD array with a simple layering rule:
- *      grass on top (ID=2),
- *      a couple layers of dirt (ID=3),
- *      then stone (ID=1) below.
- *    If water (ID=9) or lava (ID=10) appears in the sub-block,
- *    we fill up to the top with that fluid instead.
- */
+#include <cstring>
 
-std::vector<int> downsampleVoxelData(
-    const std::vector<int>& fullData,
-    int sx, int sy, int sz,
-    int lodLevel
-)
+#if (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)) && !defined(VOXEL_NO_SIMD)
+#define VOXEL_MIP_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace
 {
-    // If LOD=0 => just return original
-    if (lodLevel <= 0) {
-        return fullData;
-    }
+    const int MAX_IDS = 64;
+    const uint8_t ID_MASK = 0x3F;
 
-    // Calculate factor (2^lodLevel)
-    const int factor = 1 << lodLevel;
+    // Solidity class per voxel ID: 0 = air/other, 1 = liquid, 2 = solid
+    struct ClassTable
+    {
+        uint8_t cls[MAX_IDS];
 
-    // Dimensions of the downsampled array
-    const int dsx = sx / factor;
-    const int dsy = sy / factor;
-    const int dsz = sz / factor;
+        explicit ClassTable(const VoxelPropertyTable& props)
+        {
+            for (int id = 0; id < MAX_IDS; id++) {
+                cls[id] = props.isSolid(id) ? 2 : (props.isLiquid(id) ? 1 : 0);
+            }
+            cls[0] = 0;
+        }
+    };
 
-    if (dsx <= 0 || dsy <= 0 || dsz <= 0) {
-        throw std::runtime_error(
-            "downsampleVoxelData: LOD level is too high for the given chunk size."
-        );
+    // -------------------------------------------------------------------------
+    // Max-based reductions
+    //  Each ID becomes a sort key (priority << 6 | id), the 2x2x2 max of the
+    //  keys picks the winner, and the low 6 bits give its ID back.
+    // -------------------------------------------------------------------------
+    void buildKeys(const uint8_t* src, int size, MipReduction mode, const ClassTable& table, uint8_t* keys)
+    {
+        for (int z = 0; z < size; z++)
+        {
+            for (int y = 0; y < size; y++)
+            {
+                // Surface mode: solids in the upper half of a cell outrank the lower half
+                uint8_t solidPrio = (mode == MipReduction::SurfacePreserving) ? uint8_t(2 + (y & 1)) : 2;
+                const uint8_t* row = src + (size_t)size * (y + (size_t)size * z);
+                uint8_t* out = keys + (size_t)size * (y + (size_t)size * z);
+                for (int x = 0; x < size; x++)
+                {
+                    uint8_t id = row[x];
+                    uint8_t cls = table.cls[id];
+                    uint8_t prio = (cls == 2) ? solidPrio : cls;
+                    out[x] = uint8_t((prio << 6) | id);
+                }
+            }
+        }
     }
 
-    // Prepare the result array (dsx * dsy * dsz)
-    std::vector<int> result(dsx * dsy * dsz, 0);
-
-    // Constants for block IDs (change as needed)
-    const int AIR = 0;
-    const int GRASS = 2;
-    const int DIRT = 3;
-    const int STONE = 1;
-    const int WATER = 9;
-    const int LAVA = 10;
-
-    // Temporary arrays for each (x,z) column to store:
-    //   - the highest Y (within the sub-block)
-    //   - whether we found water or lava
-    std::vector<int>  columnMaxY(dsx * dsz, -1);
-    std::vector<bool> columnHasWater(dsx * dsz, false);
-    std::vector<bool> columnHasLava(dsx * dsz, false);
-
-    // ---------------------------
-    // PASS 1: Scan sub-blocks to find max Y and fluid flags
-    // ---------------------------
-    for (int z = 0; z < dsz; z++)
+    void reduceMaxScalar(const uint8_t* keys, int size, uint8_t* dst)
     {
-        for (int x = 0; x < dsx; x++)
+        const int half = size / 2;
+        const size_t plane = (size_t)size * size;
+        for (int oz = 0; oz < half; oz++)
         {
-            // The sub-block region in the original data:
-            int startX = x * factor;
-            int startZ = z * factor;
-
-            int maxYFound = -1;
-            bool hasWater = false;
-            bool hasLava = false;
-
-            // For simplicity, we scan all Y in [0..factor) within that sub-block,
-            // though you could scan [0..factor*someLODHeight], etc.
-            for (int localZ = 0; localZ < factor; localZ++)
+            for (int oy = 0; oy < half; oy++)
             {
-                for (int localY = 0; localY < factor; localY++)
+                const uint8_t* r00 = keys + (size_t)size * (2 * oy) + plane * (2 * oz);
+                const uint8_t* r10 = r00 + size;
+                const uint8_t* r01 = r00 + plane;
+                const uint8_t* r11 = r01 + size;
+                uint8_t* out = dst + (size_t)half * (oy + (size_t)half * oz);
+                for (int ox = 0; ox < half; ox++)
                 {
-                    for (int localX = 0; localX < factor; localX++)
-                    {
-                        int fx = startX + localX;
-                        int fy = localY;          // We'll iterate within [0..factor)
-                        int fz = startZ + localZ;
-
-                        // Safety check in case factor * dsy > sy
-                        if (fx < 0 || fx >= sx ||
-                            fy < 0 || fy >= sy ||
-                            fz < 0 || fz >= sz)
-                        {
-                            continue;
-                        }
-
-                        // Index in fullData
-                        int fullIdx = fx + sx * (fy + sy * fz);
-                        int voxelID = fullData[fullIdx];
-
-                        if (voxelID != AIR)
-                        {
-                            // Track the top Y
-                            if (localY > maxYFound) {
-                                maxYFound = localY;
-                            }
-                            // If it's water or lava, note that
-                            if (voxelID == WATER) {
-                                hasWater = true;
-                            }
-                            else if (voxelID == LAVA) {
-                                hasLava = true;
-                            }
-                        }
-                    }
+                    int x = 2 * ox;
+                    uint8_t m = std::max(std::max(r00[x], r00[x + 1]), std::max(r10[x], r10[x + 1]));
+                    m = std::max(m, std::max(std::max(r01[x], r01[x + 1]), std::max(r11[x], r11[x + 1])));
+                    out[ox] = uint8_t(m & ID_MASK);
                 }
             }
-
-            // Save results for this column
-            columnMaxY[x + z * dsx] = maxYFound;
-            columnHasWater[x + z * dsx] = hasWater;
-            columnHasLava[x + z * dsx] = hasLava;
         }
     }
 
-    // ---------------------------
-    // PASS 2: Fill the downsampled 3D array
-    // ---------------------------
-    // We treat each (x,z) as a "column" in the downsampled data,
-    // then fill from bottom to top with stone/dirt/grass,
-    // or water/lava if found in the sub-block.
+#ifdef VOXEL_MIP_SSE2
+    // Max of adjacent byte pairs, packed into the low half:
+    // out[k] = max(v[2k], v[2k+1]) & ID_MASK
+    inline __m128i pairMaxPack(__m128i v)
+    {
+        __m128i m = _mm_max_epu8(v, _mm_srli_epi16(v, 8));
+        m = _mm_and_si128(m, _mm_set1_epi16(ID_MASK));
+        return _mm_packus_epi16(m, m);
+    }
 
-    for (int z = 0; z < dsz; z++)
+    void reduceMaxSSE2(const uint8_t* keys, int size, uint8_t* dst)
     {
-        for (int y = 0; y < dsy; y++)
+        const int half = size / 2;
+        const size_t plane = (size_t)size * size;
+        for (int oz = 0; oz < half; oz++)
         {
-            for (int x = 0; x < dsx; x++)
+            for (int oy = 0; oy < half; oy++)
             {
-                // The final index in the LOD array
-                int dsIdx = x + dsx * (y + dsy * z);
+                const uint8_t* r00 = keys + (size_t)size * (2 * oy) + plane * (2 * oz);
+                const uint8_t* r10 = r00 + size;
+                const uint8_t* r01 = r00 + plane;
+                const uint8_t* r11 = r01 + size;
+                uint8_t* out = dst + (size_t)half * (oy + (size_t)half * oz);
 
-                int topY = columnMaxY[x + z * dsx];
-                if (topY < 0)
+                int x = 0;
+                for (; x + 16 <= size; x += 16)
                 {
-                    // No solid blocks => air
-                    result[dsIdx] = AIR;
-                    continue;
+                    __m128i v = _mm_max_epu8(
+                        _mm_max_epu8(_mm_loadu_si128((const __m128i*)(r00 + x)), _mm_loadu_si128((const __m128i*)(r10 + x))),
+                        _mm_max_epu8(_mm_loadu_si128((const __m128i*)(r01 + x)), _mm_loadu_si128((const __m128i*)(r11 + x))));
+                    _mm_storel_epi64((__m128i*)(out + x / 2), pairMaxPack(v));
                 }
-
-                bool hasWater = columnHasWater[x + z * dsx];
-                bool hasLava = columnHasLava[x + z * dsx];
-
-                // If water or lava is present in that sub-block, we simply fill
-                // up to topY with that fluid (in the downsampled scale).
-                // Because factor in Y => topY is in [0..factor). We must
-                // compare y to topY/factor in downsampled coordinates. But
-                // a simpler approach is to assume topY maps to topY in LOD space
-                // for direct layering.
-
-                // For each LOD cell y in [0..dsy), if y <= topY => fill,
-                // else => air. (We could scale it more precisely if topY> dsy.)
-                // This is a simplified approach.
-
-                if (hasWater)
+                if (x + 8 <= size)
                 {
-                    // Water wins out if both water & lava present
-                    if (y <= topY)
-                        result[dsIdx] = WATER;
-                    else
-                        result[dsIdx] = AIR;
+                    __m128i v = _mm_max_epu8(
+                        _mm_max_epu8(_mm_loadl_epi64((const __m128i*)(r00 + x)), _mm_loadl_epi64((const __m128i*)(r10 + x))),
+                        _mm_max_epu8(_mm_loadl_epi64((const __m128i*)(r01 + x)), _mm_loadl_epi64((const __m128i*)(r11 + x))));
+                    int packed = _mm_cvtsi128_si32(pairMaxPack(v));
+                    std::memcpy(out + x / 2, &packed, 4);
+                    x += 8;
                 }
-                else if (hasLava)
+                for (; x < size; x += 2)
                 {
-                    if (y <= topY)
-                        result[dsIdx] = LAVA;
-                    else
-                        result[dsIdx] = AIR;
+                    uint8_t m = std::max(std::max(r00[x], r00[x + 1]), std::max(r10[x], r10[x + 1]));
+                    m = std::max(m, std::max(std::max(r01[x], r01[x + 1]), std::max(r11[x], r11[x + 1])));
+                    out[x / 2] = uint8_t(m & ID_MASK);
                 }
-                else
+            }
+        }
+    }
+#endif
+
+    // -------------------------------------------------------------------------
+    // Majority
+    // -------------------------------------------------------------------------
+    void reduceMajority(const uint8_t* src, int size, uint8_t* dst, const ClassTable& table)
+    {
+        const int half = size / 2;
+        const size_t plane = (size_t)size * size;
+        for (int oz = 0; oz < half; oz++)
+        {
+            for (int oy = 0; oy < half; oy++)
+            {
+                const uint8_t* r00 = src + (size_t)size * (2 * oy) + plane * (2 * oz);
+                uint8_t* out = dst + (size_t)half * (oy + (size_t)half * oz);
+                for (int ox = 0; ox < half; ox++)
                 {
-                    // No water/lava => do layering
-                    // We'll keep it simple: bottom is stone, the top 2 layers are dirt, topmost is grass.
-                    // If (y == topY) => grass
-                    // else if (y >= topY-2 && y < topY) => dirt
-                    // else => stone
+                    int x = 2 * ox;
+                    uint8_t ids[8] = {
+                        r00[x], r00[x + 1], r00[size + x], r00[size + x + 1],
+                        r00[plane + x], r00[plane + x + 1], r00[plane + size + x], r00[plane + size + x + 1]
+                    };
 
-                    if (y > topY)
-                    {
-                        result[dsIdx] = AIR; // above top
-                    }
-                    else if (y == topY)
+                    uint8_t best = ids[0];
+                    int bestCount = 0;
+                    for (int i = 0; i < 8; i++)
                     {
-                        result[dsIdx] = GRASS;
-                    }
-                    else if (y >= topY - 2)
-                    {
-                        result[dsIdx] = DIRT;
-                    }
-                    else
-                    {
-                        result[dsIdx] = STONE;
+                        int count = 0;
+                        for (int j = 0; j < 8; j++) {
+                            count += (ids[j] == ids[i]);
+                        }
+                        bool better = count > bestCount
+                            || (count == bestCount && table.cls[ids[i]] > table.cls[best]);
+                        if (better) {
+                            best = ids[i];
+                            bestCount = count;
+                        }
                     }
+                    out[ox] = best;
                 }
             }
         }
     }
 
-    return result;
+    // -------------------------------------------------------------------------
+    // One 2x2x2 step; allowSIMD = false forces the scalar max kernel
+    // -------------------------------------------------------------------------
+    void downsample(const uint8_t* src, int size, uint8_t* dst, MipReduction mode,
+        const ClassTable& table, bool allowSIMD)
+    {
+        if (size < 2 || (size & 1)) {
+            throw std::runtime_error("downsampleVoxels2x: size must be even.");
+        }
+
+        if (mode == MipReduction::Majority) {
+            reduceMajority(src, size, dst, table);
+            return;
+        }
+
+        // Scratch for the sort keys (at most a 16^3 chunk on the meshing path)
+        uint8_t localKeys[16 * 16 * 16];
+        std::vector<uint8_t> heapKeys;
+        size_t count = (size_t)size * size * size;
+        uint8_t* keys = localKeys;
+        if (count > sizeof(localKeys)) {
+            heapKeys.resize(count);
+            keys = heapKeys.data();
+        }
+
+        buildKeys(src, size, mode, table, keys);
+#ifdef VOXEL_MIP_SSE2
+        if (allowSIMD) {
+            reduceMaxSSE2(keys, size, dst);
+            return;
+        }
+#else
+        (void)allowSIMD;
+#endif
+        reduceMaxScalar(keys, size, dst);
+    }
+}
+
+const char* mipReductionName(MipReduction mode)
+{
+    switch (mode)
+    {
+    case MipReduction::Majority:          return "majority";
+    case MipReduction::MostSolid:         return "mostSolid";
+    case MipReduction::SurfacePreserving: return "surface";
+    default:                              return "unknown";
+    }
+}
+
+void downsampleVoxels2x(const uint8_t* src, int size, uint8_t* dst, MipReduction mode,
+    const VoxelPropertyTable& props)
+{
+    downsample(src, size, dst, mode, ClassTable(props), true);
+}
+
+void downsampleVoxels2xScalar(const uint8_t* src, int size, uint8_t* dst, MipReduction mode,
+    const VoxelPropertyTable& props)
+{
+    downsample(src, size, dst, mode, ClassTable(props), false);
+}
+
+const char* mipKernelName()
+{
+#ifdef VOXEL_MIP_SSE2
+    return "sse2";
+#else
+    return "scalar";
+#endif
+}
+
+void VoxelMipChain::build(const int* blocks, int size, int levelCount, MipReduction reduction,
+    const VoxelPropertyTable& props, uint32_t newVersion)
+{
+    const int maxLevels = (int)(sizeof(levels) / sizeof(levels[0]));
+    if (levelCount > maxLevels || (size >> (levelCount - 1)) < 1) {
+        throw std::runtime_error("VoxelMipChain: too many levels for the given size.");
+    }
+
+    size_t count = (size_t)size * size * size;
+    levels[0].resize(count);
+    for (size_t i = 0; i < count; i++) {
+        levels[0][i] = (uint8_t)blocks[i];
+    }
+
+    const ClassTable table(props);
+    const uint8_t* prev = levels[0].data();
+    int prevSize = size;
+    for (int L = 1; L < levelCount; L++)
+    {
+        int s = prevSize / 2;
+        levels[L].resize((size_t)s * s * s);
+        downsample(prev, prevSize, levels[L].data(), reduction, table, true);
+        prev = levels[L].data();
+        prevSize = s;
+    }
+
+    mode = reduction;
+    version = newVersion;
+}
+
+std::vector<int> downsampleVoxelData(
+    const std::vector<int>& fullData,
+    int sx, int sy, int sz,
+    int lodLevel,
+    const VoxelPropertyTable& props,
+    MipReduction mode
+)
+{
+    // If LOD=0 => just return original
+    if (lodLevel <= 0) {
+        return fullData;
+    }
+
+    const int factor = 1 << lodLevel;
+    if (sx != sy || sy != sz || sx % factor != 0) {
+        throw std::runtime_error(
+            "downsampleVoxelData: LOD level is too high for the given chunk size."
+        );
+    }
+
+    VoxelMipChain chain;
+    chain.build(fullData.data(), sx, lodLevel + 1, mode, props, 0);
+
+    const std::vector<uint8_t>& level = chain.levels[lodLevel];
+    return std::vector<int>(level.begin(), level.end());
 }
@@ -1,29 +1,90 @@
 #pragma once
 
 #include <vector>
+#include <cstdint>
+
+struct VoxelPropertyTable;
 
 /**
- * Downsamples a full-resolution voxel array into a lower resolution array
- * by a factor of 2^lodLevel. For example:
- *   lodLevel = 1 => factor = 2 (half resolution in each dimension)
- *   lodLevel = 2 => factor = 4 (quarter resolution), etc.
+ * How a 2x2x2 block of voxels collapses into one voxel of the next mip
+ * level. Solid/liquid come from the voxel property table the caller
+ * passes in, so new voxel types work without touching this code.
  *
- * @param fullData   A vector<int> of size (sx * sy * sz), holding voxel IDs.
- *                   Typically chunk->m_blocks or similar.
- * @param sx         Chunk dimension in X (e.g. 16, 32, 64).
- * @param sy         Chunk dimension in Y.
- * @param sz         Chunk dimension in Z.
- * @param lodLevel   Which LOD factor to use. For LOD=1 => 2x downsampling, etc.
- * @return           A new array of voxel data, of size
- *                   (sx/factor) * (sy/factor) * (sz/factor).
+ *  - Majority:          most common ID of the 8 (ties go to the more
+ *                       solid type). Thins out thin features.
+ *  - MostSolid:         solid beats liquid beats air. Never opens holes.
+ *  - SurfacePreserving: like MostSolid, but among solids the upper layer
+ *                       wins, so grass tops stay grass instead of the
+ *                       dirt underneath showing through.
+ */
+enum class MipReduction
+{
+    Majority,
+    MostSolid,
+    SurfacePreserving
+};
+
+const char* mipReductionName(MipReduction mode);
+
+/**
+ * One 2x2x2 reduction step: `src` is size^3 voxel IDs (x fastest, then y,
+ * then z), `dst` receives (size/2)^3. `size` must be even. IDs must be
+ * below 64 (Chunk::MAX_VOXEL_TYPES). `props` classifies them as solid /
+ * liquid / air.
  *
- * Implementation chooses the "first non-air" block from the sub-voxel region
- * (i.e. if any block is solid, we store that ID). You can change the rule
- * to majority, average height, or anything else.
+ * The max-based modes run an SSE2 kernel (16 voxels per instruction) when
+ * available and fall back to scalar code otherwise; both give the same
+ * result.
+ */
+void downsampleVoxels2x(const uint8_t* src, int size, uint8_t* dst, MipReduction mode,
+    const VoxelPropertyTable& props);
+
+/**
+ * downsampleVoxels2x on the scalar kernel even where SSE2 is available, to
+ * check the two against each other (world_bench does, on random input).
+ */
+void downsampleVoxels2xScalar(const uint8_t* src, int size, uint8_t* dst, MipReduction mode,
+    const VoxelPropertyTable& props);
+
+/**
+ * "sse2" or "scalar": the kernel downsampleVoxels2x was built with.
+ */
+const char* mipKernelName();
+
+/**
+ * A chunk's voxel mip chain: level 0 is the chunk itself as bytes, level L
+ * has (size >> L)^3 voxels and is built from level L-1. Every level keeps
+ * its storage, so rebuilds after an edit don't allocate.
+ * Chunk keeps one of these and rebuilds it when its version changes
+ * (see Chunk::copyMipLevel).
+ */
+struct VoxelMipChain
+{
+    static const uint32_t NO_VERSION = 0xFFFFFFFFu;
+
+    uint32_t             version = NO_VERSION;
+    MipReduction         mode = MipReduction::SurfacePreserving;
+    std::vector<uint8_t> levels[4];
+
+    /**
+     * Rebuilds levels 1..levelCount-1 from a cube of `size`^3 voxel IDs.
+     */
+    void build(const int* blocks, int size, int levelCount, MipReduction reduction,
+        const VoxelPropertyTable& props, uint32_t newVersion);
+};
+
+/**
+ * Downsamples a full-resolution voxel array by a factor of 2^lodLevel,
+ * one 2x2x2 step at a time (LOD2 is built from LOD1, not from LOD0).
+ * sx, sy and sz must be equal and divisible by 2^lodLevel.
+ *
+ * Meshing goes through the cached per-chunk chain instead; this is for
+ * one-off use on arbitrary arrays.
  */
 std::vector<int> downsampleVoxelData(
     const std::vector<int>& fullData,
     int sx, int sy, int sz,
-    int lodLevel
+    int lodLevel,
+    const VoxelPropertyTable& props,
+    MipReduction mode = MipReduction::SurfacePreserving
 );
-
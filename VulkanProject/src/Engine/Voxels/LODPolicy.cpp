@@ -0,0 +1,76 @@
+#include "LODPolicy.h"
+
+#include <algorithm>
+#include <cmath>
+
+LODPolicy::LODPolicy()
+{
+    updateSwitchDistances();
+}
+
+void LODPolicy::setProjection(float fovYRadians, float viewportHeight)
+{
+    if (fovYRadians == m_fovY && viewportHeight == m_viewportHeight) {
+        return;
+    }
+    m_fovY = fovYRadians;
+    m_viewportHeight = std::max(viewportHeight, 1.f);
+    updateSwitchDistances();
+}
+
+void LODPolicy::setMaxPixelError(float pixels)
+{
+    m_maxPixelError = std::max(pixels, 0.1f);
+    updateSwitchDistances();
+}
+
+void LODPolicy::setHysteresis(float fraction)
+{
+    m_hysteresis = std::min(std::max(fraction, 0.f), 0.9f);
+}
+
+void LODPolicy::updateSwitchDistances()
+{
+    // Pixels per voxel of error at distance 1
+    float pixelsPerUnit = m_viewportHeight / (2.f * std::tan(m_fovY * 0.5f));
+
+    for (int lod = 0; lod < LOD_COUNT; lod++)
+    {
+        float errorVoxels = float((1 << lod) - 1);
+        m_switchDistance[lod] = errorVoxels * pixelsPerUnit / m_maxPixelError;
+    }
+}
+
+float LODPolicy::chunkDistance(int cx, int cy, int cz, const glm::vec3& point)
+{
+    float minX = float(cx * Chunk::SIZE_X), maxX = minX + Chunk::SIZE_X;
+    float minY = float(cy * Chunk::SIZE_Y), maxY = minY + Chunk::SIZE_Y;
+    float minZ = float(cz * Chunk::SIZE_Z), maxZ = minZ + Chunk::SIZE_Z;
+
+    float dx = std::max(std::max(minX - point.x, 0.f), point.x - maxX);
+    float dy = std::max(std::max(minY - point.y, 0.f), point.y - maxY);
+    float dz = std::max(std::max(minZ - point.z, 0.f), point.z - maxZ);
+    return std::sqrt(dx * dx + dy * dy + dz * dz);
+}
+
+int LODPolicy::selectLOD(float distance, int currentLOD) const
+{
+    if (currentLOD < 0 || currentLOD >= LOD_COUNT)
+    {
+        // No history: plain bands
+        int lod = 0;
+        while (lod + 1 < LOD_COUNT && distance >= m_switchDistance[lod + 1]) {
+            lod++;
+        }
+        return lod;
+    }
+
+    int lod = currentLOD;
+    while (lod + 1 < LOD_COUNT && distance >= m_switchDistance[lod + 1] * (1.f + m_hysteresis)) {
+        lod++;
+    }
+    while (lod > 0 && distance < m_switchDistance[lod] * (1.f - m_hysteresis)) {
+        lod--;
+    }
+    return lod;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <glm/vec3.hpp>
+#include "Chunk.h"
+
+/**
+ * Decides which LOD a chunk should use. VoxelWorld asks it which LOD to
+ * build, the renderer draws whatever the world settled on
+ * (Chunk::getTargetLOD), so the two can't disagree any more.
+ *
+ * Selection is by screen-space error: LOD L merges 2^L voxels per cell, so
+ * its surface can be off by up to (2^L - 1) voxels. Projected at distance d
+ * that is
+ *
+ *     pixels = error * viewportHeight / (2 * d * tan(fovY / 2))
+ *
+ * and LOD L becomes acceptable once that drops below maxPixelError. The
+ * resulting switch distances scale with resolution and FOV.
+ *
+ * Hysteresis: a chunk only goes coarser once it is (1 + h) past a switch
+ * distance and only back finer once it is (1 - h) inside it, so a camera
+ * hovering on a boundary doesn't rebuild the chunk every frame.
+ */
+class LODPolicy
+{
+public:
+    static const int LOD_COUNT = Chunk::MAX_LOD_LEVELS;
+
+    LODPolicy();
+
+    /**
+     * Camera projection the error is measured in (radians / pixels).
+     */
+    void setProjection(float fovYRadians, float viewportHeight);
+
+    void  setMaxPixelError(float pixels);
+    float getMaxPixelError() const { return m_maxPixelError; }
+
+    void  setHysteresis(float fraction);
+    float getHysteresis() const { return m_hysteresis; }
+
+    /**
+     * Distance from which LOD `lod` is acceptable (0 for LOD0).
+     */
+    float getSwitchDistance(int lod) const { return m_switchDistance[lod]; }
+
+    /**
+     * Distance from a point to the bounding box of chunk (cx, cy, cz).
+     */
+    static float chunkDistance(int cx, int cy, int cz, const glm::vec3& point);
+
+    /**
+     * LOD for a chunk at `distance` that currently targets `currentLOD`
+     * (-1 if it has none yet, which skips hysteresis).
+     */
+    int selectLOD(float distance, int currentLOD) const;
+
+private:
+    void updateSwitchDistances();
+
+    float m_fovY = 0.785398f;          // 45 degrees
+    float m_viewportHeight = 600.f;
+    float m_maxPixelError = 12.f;
+    float m_hysteresis = 0.1f;
+
+    float m_switchDistance[LOD_COUNT];
+};
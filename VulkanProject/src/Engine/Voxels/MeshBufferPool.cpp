@@ -0,0 +1,66 @@
+#include "MeshBufferPool.h"
+
+#include <utility>
+
+MeshBufferPool::MeshBufferPool()
+{
+    m_free.reserve(MAX_POOLED);
+}
+
+void MeshBufferPool::acquire(size_t vertexEstimate, size_t indexEstimate,
+    std::vector<Vertex>& outVerts, std::vector<uint32_t>& outInds)
+{
+    Buffers taken;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_free.empty())
+        {
+            taken = std::move(m_free.back());
+            m_free.pop_back();
+            m_reuses++;
+        }
+        else {
+            m_misses++;
+        }
+    }
+
+    outVerts.swap(taken.verts);
+    outInds.swap(taken.inds);
+    outVerts.clear();
+    outInds.clear();
+    outVerts.reserve(vertexEstimate);
+    outInds.reserve(indexEstimate);
+}
+
+void MeshBufferPool::release(std::vector<Vertex>& verts, std::vector<uint32_t>& inds)
+{
+    Buffers returned;
+    returned.verts.swap(verts);
+    returned.inds.swap(inds);
+    returned.verts.clear();
+    returned.inds.clear();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_free.size() < MAX_POOLED) {
+        m_free.push_back(std::move(returned));
+    }
+    // Otherwise `returned` frees them after the lock is released
+}
+
+size_t MeshBufferPool::getPooledCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_free.size();
+}
+
+uint64_t MeshBufferPool::getReuseCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_reuses;
+}
+
+uint64_t MeshBufferPool::getMissCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_misses;
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <mutex>
+#include "ChunkMesher.h" // Vertex
+
+/**
+ * Recycled vertex and index vectors for meshing results.
+ *
+ * A meshing job takes a cleared pair, reserved for an estimate (usually
+ * the size of the mesh it replaces), builds into it and, once the sink has
+ * copied the geometry, the owner hands the pair back. The pool keeps the
+ * capacity, so remeshing in steady state doesn't touch the heap, and
+ * nothing grows by doubling from empty. At most MAX_POOLED pairs are kept;
+ * extra ones are simply freed.
+ *
+ * Thread safe: workers acquire, the main thread releases.
+ */
+class MeshBufferPool
+{
+public:
+    static const size_t MAX_POOLED = 64;
+
+    MeshBufferPool();
+
+    /**
+     * Moves a pooled pair (or, when the pool is empty, fresh vectors) into
+     * outVerts / outInds, cleared and reserved for at least the estimates.
+     * Whatever outVerts / outInds held before is dropped.
+     */
+    void acquire(size_t vertexEstimate, size_t indexEstimate,
+        std::vector<Vertex>& outVerts, std::vector<uint32_t>& outInds);
+
+    /// Takes the vectors back (they are left empty, without capacity)
+    void release(std::vector<Vertex>& verts, std::vector<uint32_t>& inds);
+
+    // Stats
+    size_t   getPooledCount() const;
+    uint64_t getReuseCount() const;
+    uint64_t getMissCount() const; // acquires that found the pool empty
+
+private:
+    struct Buffers
+    {
+        std::vector<Vertex>   verts;
+        std::vector<uint32_t> inds;
+    };
+
+    mutable std::mutex   m_mutex;
+    std::vector<Buffers> m_free; // reserved to MAX_POOLED, so returning never allocates
+    uint64_t             m_reuses = 0;
+    uint64_t             m_misses = 0;
+};
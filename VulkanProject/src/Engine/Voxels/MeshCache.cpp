@@ -0,0 +1,169 @@
+#include "MeshCache.h"
+
+#include <cstring>
+#include <iterator>
+#include <utility>
+
+namespace
+{
+    uint64_t mix(uint64_t x)
+    {
+        x += 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+
+    uint64_t rotl(uint64_t x, int r)
+    {
+        return (x << r) | (x >> (64 - r));
+    }
+
+    // Padding quads (ChunkMesher::padQuads) stay at the origin
+    bool isPadding(const Vertex* c)
+    {
+        return c[0].px == c[2].px && c[0].py == c[2].py && c[0].pz == c[2].pz;
+    }
+
+    // Moves every real quad by (dx, dy, dz). Whole-number positions
+    // well inside float precision, so moving back and forth is exact.
+    void translate(std::vector<Vertex>& verts, float dx, float dy, float dz)
+    {
+        for (size_t q = 0; q + 4 <= verts.size(); q += 4)
+        {
+            Vertex* c = &verts[q];
+            if (isPadding(c)) continue;
+            for (int i = 0; i < 4; i++)
+            {
+                c[i].px += dx;
+                c[i].py += dy;
+                c[i].pz += dz;
+            }
+        }
+    }
+}
+
+// Two voxels per step, multiply-rotate like xxHash's inner loop
+uint64_t MeshCache::chunkKey(const Chunk& chunk, int lodLevel, MipReduction mode,
+    bool segmented, bool buildIndices)
+{
+    const std::vector<int>& blocks = chunk.getBlocks();
+    const size_t words = blocks.size() / 2;
+    uint64_t h = 0x27D4EB2F165667C5ull ^ (uint64_t)blocks.size();
+    for (size_t i = 0; i < words; i++)
+    {
+        uint64_t w;
+        std::memcpy(&w, &blocks[i * 2], sizeof(w));
+        h = rotl(h ^ (w * 0xC2B2AE3D27D4EB4Full), 31) * 0x9E3779B185EBCA87ull;
+    }
+    if (blocks.size() % 2) {
+        h = rotl(h ^ ((uint64_t)(uint32_t)blocks.back() * 0xC2B2AE3D27D4EB4Full), 31) * 0x9E3779B185EBCA87ull;
+    }
+
+    const uint64_t variant = (uint64_t)(lodLevel + 1)
+        | ((uint64_t)mode << 8)
+        | ((uint64_t)segmented << 16)
+        | ((uint64_t)buildIndices << 17);
+    return mix(h ^ mix(variant));
+}
+
+bool MeshCache::lookup(uint64_t key, int offsetX, int offsetY, int offsetZ,
+    std::vector<Vertex>& outVerts,
+    std::vector<uint32_t>& outInds,
+    uint32_t& outOpaqueIndexCount,
+    MeshSliceLayout* outSlices,
+    MeshFaceRanges& outFaceRanges)
+{
+    std::shared_ptr<const Entry> entry;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_lookups++;
+        auto it = m_entries.find(key);
+        if (it == m_entries.end()) {
+            return false;
+        }
+        m_lru.splice(m_lru.begin(), m_lru, it->second);
+        entry = it->second->second;
+        m_hits++;
+    }
+
+    // Copied outside the lock; the entry is immutable and stays alive
+    // through `entry` even if it is evicted meanwhile
+    outVerts.assign(entry->verts.begin(), entry->verts.end());
+    outInds.assign(entry->inds.begin(), entry->inds.end());
+    translate(outVerts, float(offsetX), float(offsetY), float(offsetZ));
+    outOpaqueIndexCount = entry->opaqueIndexCount;
+    if (outSlices) *outSlices = entry->slices;
+    outFaceRanges = entry->faceRanges;
+    return true;
+}
+
+void MeshCache::store(uint64_t key, int offsetX, int offsetY, int offsetZ,
+    const std::vector<Vertex>& verts,
+    const std::vector<uint32_t>& inds,
+    uint32_t opaqueIndexCount,
+    const MeshSliceLayout* slices,
+    const MeshFaceRanges& faceRanges)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_entries.count(key)) return;
+    }
+
+    std::shared_ptr<Entry> entry = std::make_shared<Entry>();
+    entry->verts = verts;
+    entry->inds = inds;
+    translate(entry->verts, -float(offsetX), -float(offsetY), -float(offsetZ));
+    entry->opaqueIndexCount = opaqueIndexCount;
+    if (slices) entry->slices = *slices;
+    entry->faceRanges = faceRanges;
+    entry->bytes = sizeof(Vertex) * verts.size() + sizeof(uint32_t) * inds.size()
+        + sizeof(MeshSlice) * entry->slices.slices.size();
+
+    std::list<Item> evicted; // freed after the lock is released
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_entries.count(key)) return; // another job stored it meanwhile
+
+    m_lru.emplace_front(key, entry);
+    m_entries[key] = m_lru.begin();
+    m_bytes += entry->bytes;
+    while (m_bytes > MAX_BYTES && m_lru.size() > 1)
+    {
+        auto last = std::prev(m_lru.end());
+        m_bytes -= last->second->bytes;
+        m_entries.erase(last->first);
+        evicted.splice(evicted.begin(), m_lru, last);
+    }
+}
+
+void MeshCache::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_lru.clear();
+    m_entries.clear();
+    m_bytes = 0;
+}
+
+uint64_t MeshCache::getLookupCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_lookups;
+}
+
+uint64_t MeshCache::getHitCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_hits;
+}
+
+size_t MeshCache::getEntryCount() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+size_t MeshCache::getBytes() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_bytes;
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <vector>
+#include <list>
+#include <unordered_map>
+#include <memory>
+#include <cstdint>
+#include <cstddef>
+#include <mutex>
+#include "ChunkMesher.h" // Vertex, MeshSliceLayout, MipReduction
+
+/**
+ * Chunk LOD meshes by voxel content, so identical chunks (ocean floor,
+ * solid rock, repeated builds) are meshed once.
+ *
+ * The key is a hash of the chunk's voxels plus everything else the mesh
+ * depends on (LOD, mip reduction, segmented or not, indices or not). A
+ * chunk's LOD mesh leaves out its border faces (those are seams), so its
+ * own voxels are the whole neighbourhood it depends on; no padding layer
+ * from the neighbours goes into the key.
+ *
+ * Entries are stored chunk-local (positions relative to the chunk's
+ * world offset) and moved to the asking chunk on a hit, which gives the
+ * same vertices a fresh build would. Least recently used entries go
+ * once the cache holds more than MAX_BYTES of geometry.
+ *
+ * Keys are 64-bit hashes and are trusted: two different chunks sharing a
+ * key would share a mesh. chunkKey() and the build read the voxels
+ * separately, so a caller racing edits compares Chunk::getVersion()
+ * before hashing and after building and only stores if it held.
+ *
+ * Thread safe: meshing jobs look up and store concurrently.
+ */
+class MeshCache
+{
+public:
+    static const size_t MAX_BYTES = 16 * 1024 * 1024;
+
+    /**
+     * Key of one chunk LOD mesh. `segmented` and `buildIndices` as passed
+     * to ChunkMesher::buildLODMesh (a slice layout, getBuildIndices).
+     */
+    static uint64_t chunkKey(const Chunk& chunk, int lodLevel, MipReduction mode,
+        bool segmented, bool buildIndices);
+
+    /**
+     * On a hit, overwrites the outputs with the cached mesh moved to the
+     * given world offset (Chunk::SIZE_* times the chunk coordinate) and
+     * returns true. outSlices may be null. Leaves them alone on a miss.
+     */
+    bool lookup(uint64_t key, int offsetX, int offsetY, int offsetZ,
+        std::vector<Vertex>& outVerts,
+        std::vector<uint32_t>& outInds,
+        uint32_t& outOpaqueIndexCount,
+        MeshSliceLayout* outSlices,
+        MeshFaceRanges& outFaceRanges);
+
+    /**
+     * Adds a freshly built mesh, given as built (world positions at the
+     * offset). Does nothing if the key is already cached.
+     */
+    void store(uint64_t key, int offsetX, int offsetY, int offsetZ,
+        const std::vector<Vertex>& verts,
+        const std::vector<uint32_t>& inds,
+        uint32_t opaqueIndexCount,
+        const MeshSliceLayout* slices,
+        const MeshFaceRanges& faceRanges);
+
+    void clear();
+
+    // Stats
+    uint64_t getLookupCount() const;
+    uint64_t getHitCount() const;
+    size_t   getEntryCount() const;
+    size_t   getBytes() const;
+
+private:
+    struct Entry
+    {
+        std::vector<Vertex>   verts; // chunk-local
+        std::vector<uint32_t> inds;
+        uint32_t              opaqueIndexCount = 0;
+        MeshSliceLayout       slices;
+        MeshFaceRanges        faceRanges;
+        size_t                bytes = 0;
+    };
+    typedef std::pair<uint64_t, std::shared_ptr<const Entry>> Item;
+
+    mutable std::mutex m_mutex;
+    std::list<Item>    m_lru; // most recently used first
+    std::unordered_map<uint64_t, std::list<Item>::iterator> m_entries;
+    size_t             m_bytes = 0;
+    uint64_t           m_lookups = 0;
+    uint64_t           m_hits = 0;
+};
@@ -0,0 +1,86 @@
+#include "MeshResidency.h"
+
+#include <algorithm>
+#include "ChunkManager.h"
+#include "MeshSink.h"
+
+void MeshResidency::onMeshUploaded(int lodLevel, size_t bytes)
+{
+    m_residentBytes[lodLevel] += bytes;
+    m_residentMeshes[lodLevel]++;
+}
+
+void MeshResidency::onMeshDestroyed(int lodLevel, size_t bytes)
+{
+    m_residentBytes[lodLevel] -= std::min(bytes, m_residentBytes[lodLevel]);
+    if (m_residentMeshes[lodLevel] > 0) {
+        m_residentMeshes[lodLevel]--;
+    }
+}
+
+void MeshResidency::onSuperChunkUploaded(size_t bytes)
+{
+    m_superChunkBytes += bytes;
+    m_superChunkMeshes++;
+}
+
+void MeshResidency::onSuperChunkDestroyed(size_t bytes)
+{
+    m_superChunkBytes -= std::min(bytes, m_superChunkBytes);
+    if (m_superChunkMeshes > 0) {
+        m_superChunkMeshes--;
+    }
+}
+
+size_t MeshResidency::getTotalResidentBytes() const
+{
+    size_t total = m_superChunkBytes;
+    for (int L = 0; L < LOD_COUNT; L++) {
+        total += m_residentBytes[L];
+    }
+    return total;
+}
+
+void MeshResidency::collectEvictions(const ChunkManager& chunks, std::vector<Eviction>& out)
+{
+    out.clear();
+    size_t total = getTotalResidentBytes();
+    if (m_budgetBytes == 0 || total <= m_budgetBytes) {
+        m_overBudget = false;
+        return;
+    }
+
+    // Only runs under pressure, so a full pass over the loaded chunks is fine
+    m_candidates.clear();
+    for (auto& kv : chunks.getAllChunks())
+    {
+        Chunk* chunk = kv.second.get();
+        if (!chunk || chunk->isUploading()) continue;
+
+        for (int L = 0; L < COARSEST_LOD; L++)
+        {
+            const ChunkLODData& lod = chunk->getLODData(L);
+            if (!lod.valid || !lod.mesh) continue;
+            if (L == chunk->getTargetLOD() || lod.lastUsedFrame == m_frame) continue;
+
+            Candidate c;
+            c.lastUsed = lod.lastUsedFrame;
+            c.bytes = lod.mesh->byteSize;
+            c.eviction.chunk = chunk;
+            c.eviction.lodLevel = L;
+            m_candidates.push_back(c);
+        }
+    }
+
+    std::sort(m_candidates.begin(), m_candidates.end(),
+        [](const Candidate& a, const Candidate& b) { return a.lastUsed < b.lastUsed; });
+
+    for (const Candidate& c : m_candidates)
+    {
+        if (total <= m_budgetBytes) break;
+        out.push_back(c.eviction);
+        total -= std::min(c.bytes, total);
+    }
+    m_evictions += out.size();
+    m_overBudget = total > m_budgetBytes;
+}
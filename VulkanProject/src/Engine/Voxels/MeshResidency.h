@@ -0,0 +1,97 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "Chunk.h"
+
+class ChunkManager;
+
+/**
+ * Keeps chunk LOD meshes resident within a GPU memory budget.
+ *
+ * A chunk keeps a mesh for every LOD it has been built at, so the camera
+ * moving back and forth reuses them instead of remeshing. Under budget
+ * pressure the least recently drawn meshes go first (the renderer stamps
+ * ChunkLODData::lastUsedFrame via markUsed()). Never evicted:
+ *  - the coarsest LOD, so any LOD switch has something to draw at once,
+ *  - the LOD the chunk currently targets,
+ *  - anything drawn this frame.
+ *
+ * VoxelWorld reports every upload/destroy, so per-LOD byte counts are exact.
+ * SuperChunkManager reports its far-field meshes the same way; they count
+ * toward the total (and so the budget) but are never evicted here.
+ * Main thread only.
+ */
+class MeshResidency
+{
+public:
+    static const int LOD_COUNT = Chunk::MAX_LOD_LEVELS;
+    static const int COARSEST_LOD = LOD_COUNT - 1;
+
+    struct Eviction
+    {
+        Chunk* chunk = nullptr;
+        int    lodLevel = 0;
+    };
+
+    /// 0 = unlimited
+    void   setBudgetBytes(size_t bytes) { m_budgetBytes = bytes; }
+    size_t getBudgetBytes() const { return m_budgetBytes; }
+
+    // ---------------------------------------------------
+    // Bookkeeping (VoxelWorld)
+    // ---------------------------------------------------
+    void onMeshUploaded(int lodLevel, size_t bytes);
+    void onMeshDestroyed(int lodLevel, size_t bytes);
+
+    // SuperChunkManager
+    void onSuperChunkUploaded(size_t bytes);
+    void onSuperChunkDestroyed(size_t bytes);
+
+    /// Advances the LRU clock; call once per world update.
+    void beginFrame() { m_frame++; }
+    uint64_t getFrame() const { return m_frame; }
+
+    /// The renderer drew this LOD of the chunk this frame.
+    void markUsed(Chunk& chunk, int lodLevel) { chunk.getLODData(lodLevel).lastUsedFrame = m_frame; }
+
+    /**
+     * Picks least recently used meshes to drop until the resident total
+     * fits the budget (empty if it already does). The caller destroys them.
+     */
+    void collectEvictions(const ChunkManager& chunks, std::vector<Eviction>& out);
+
+    // ---------------------------------------------------
+    // Stats
+    // ---------------------------------------------------
+    size_t   getResidentBytes(int lodLevel) const { return m_residentBytes[lodLevel]; }
+    size_t   getTotalResidentBytes() const;
+    uint32_t getResidentMeshes(int lodLevel) const { return m_residentMeshes[lodLevel]; }
+    size_t   getSuperChunkBytes() const { return m_superChunkBytes; }
+    uint32_t getSuperChunkMeshes() const { return m_superChunkMeshes; }
+    uint64_t getEvictionCount() const { return m_evictions; }
+
+    /// Still over budget after the last eviction pass (only protected meshes left).
+    bool isOverBudget() const { return m_overBudget; }
+
+private:
+    size_t   m_budgetBytes = 256ull * 1024 * 1024;
+    uint64_t m_frame = 1;
+
+    size_t   m_residentBytes[LOD_COUNT] = {};
+    uint32_t m_residentMeshes[LOD_COUNT] = {};
+    size_t   m_superChunkBytes = 0;
+    uint32_t m_superChunkMeshes = 0;
+    uint64_t m_evictions = 0;
+    bool     m_overBudget = false;
+
+    // Scratch for collectEvictions
+    struct Candidate
+    {
+        uint64_t lastUsed;
+        size_t   bytes;
+        Eviction eviction;
+    };
+    std::vector<Candidate> m_candidates;
+};
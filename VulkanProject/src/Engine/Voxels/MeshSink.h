@@ -0,0 +1,78 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include "ChunkMesher.h" // Vertex
+
+/**
+ * Whatever a MeshSink hands back for an uploaded mesh. Chunks only hold
+ * this base; the sink that created it knows the concrete type (e.g. the
+ * Vulkan buffers in VulkanGpuMesh).
+ */
+struct GpuMesh
+{
+    uint32_t vertexCount = 0;
+    uint32_t indexCount = 0;
+    size_t   byteSize = 0; // vertex + index data
+};
+
+/**
+ * New vertices for part of an uploaded mesh, starting at vertex
+ * `firstVertex`. The indices stay as they are.
+ */
+struct MeshPatch
+{
+    uint32_t            firstVertex = 0;
+    std::vector<Vertex> verts;
+};
+
+/**
+ * Destination for finished chunk geometry.
+ *
+ * Keeps VoxelWorld free of any graphics API: the Vulkan renderer plugs in a
+ * VulkanMeshSink, headless tools (benchmarks) a sink that just counts.
+ * All calls come from the thread that drives VoxelWorld.
+ */
+class MeshSink
+{
+public:
+    virtual ~MeshSink() = default;
+
+    /**
+     * Takes ownership of a copy of the geometry. Returns nullptr for an
+     * empty mesh. The mesh may be usable only after the next endFrame().
+     * With shared quad indices `inds` is empty and ignored.
+     */
+    virtual GpuMesh* uploadMesh(const std::vector<Vertex>& verts, const std::vector<uint32_t>& inds) = 0;
+
+    /**
+     * Releases a mesh returned by uploadMesh (nullptr is ignored). The sink
+     * may defer the actual release until the GPU is done with it.
+     */
+    virtual void destroyMesh(GpuMesh* mesh) = 0;
+
+    /**
+     * Overwrites vertex ranges of a mesh returned by uploadMesh in place
+     * (slice edits, see ChunkMesher::buildSegmentedMesh). Ranges must lie
+     * inside the mesh. Returns false if the sink can't patch; the caller
+     * then uploads a new mesh instead.
+     */
+    virtual bool patchMesh(GpuMesh* /*mesh*/, const std::vector<MeshPatch>& /*patches*/) { return false; }
+
+    /**
+     * True if the sink keeps no per-mesh indices and draws every mesh with
+     * one shared 16-bit quad index buffer (ChunkMesher::buildQuadIndexPattern,
+     * split into draws of at most SHARED_INDEX_QUADS quads), or pulls
+     * packed quads in the vertex shader (PackedQuad). Meshes must then be
+     * plain quads, four vertices each; GpuMesh::indexCount is the implied
+     * six per quad. Fixed for the sink's lifetime.
+     */
+    virtual bool usesSharedQuadIndices() const { return false; }
+
+    /**
+     * Called once per world update, after that update's uploads/destroys.
+     * Batching sinks submit their pending work here.
+     */
+    virtual void endFrame() {}
+};
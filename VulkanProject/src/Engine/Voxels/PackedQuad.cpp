@@ -0,0 +1,164 @@
+#include "PackedQuad.h"
+#include "ChunkMesher.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    // In-plane axes per face axis, as in ChunkMesher
+    const int U_AXES[3] = { 1, 0, 0 };
+    const int V_AXES[3] = { 2, 2, 1 };
+
+    int floorDiv(int a, int b)
+    {
+        return (a >= 0) ? a / b : -((-a + b - 1) / b);
+    }
+
+    void position(const Vertex& v, float out[3])
+    {
+        out[0] = v.px; out[1] = v.py; out[2] = v.pz;
+    }
+
+    bool isPadding(const Vertex* c)
+    {
+        return c[0].px == c[2].px && c[0].py == c[2].py && c[0].pz == c[2].pz;
+    }
+
+    uint32_t channel7(float c)
+    {
+        float clamped = std::min(std::max(c, 0.f), 1.f);
+        return (uint32_t)(clamped * 127.f + 0.5f);
+    }
+
+    // Coordinate relative to the origin, if it is a whole number in range
+    bool relative(float p, int origin, uint32_t& out)
+    {
+        float r = p - float(origin);
+        if (r < 0.f || r > float(PackedQuads::MAX_COORD) || std::floor(r) != r) {
+            return false;
+        }
+        out = (uint32_t)r;
+        return true;
+    }
+}
+
+const uint8_t PackedQuads::CORNERS[6][4][2] = {
+    { {0,0}, {0,1}, {1,1}, {1,0} }, // +X
+    { {0,1}, {0,0}, {1,0}, {1,1} }, // -X
+    { {0,0}, {1,0}, {1,1}, {0,1} }, // +Y
+    { {1,0}, {0,0}, {0,1}, {1,1} }, // -Y
+    { {0,0}, {1,0}, {1,1}, {0,1} }, // +Z
+    { {1,0}, {0,0}, {0,1}, {1,1} }, // -Z
+};
+
+void PackedQuads::meshOrigin(const std::vector<Vertex>& verts, int outOrigin[3])
+{
+    const int cell[3] = { Chunk::SIZE_X, Chunk::SIZE_Y, Chunk::SIZE_Z };
+    float lowest[3] = { 0.f, 0.f, 0.f };
+    bool any = false;
+    for (size_t q = 0; q + 4 <= verts.size(); q += 4)
+    {
+        const Vertex* c = &verts[q];
+        if (isPadding(c)) continue;
+        for (int i = 0; i < 4; i++)
+        {
+            float p[3];
+            position(c[i], p);
+            for (int a = 0; a < 3; a++) {
+                lowest[a] = any ? std::min(lowest[a], p[a]) : p[a];
+            }
+            any = true;
+        }
+    }
+    for (int a = 0; a < 3; a++) {
+        outOrigin[a] = any ? floorDiv((int)std::floor(lowest[a]), cell[a]) * cell[a] : 0;
+    }
+}
+
+bool PackedQuads::pack(const Vertex* corners, const int origin[3], PackedQuad& out)
+{
+    out = PackedQuad();
+    if (isPadding(corners)) return true;
+
+    float p[4][3];
+    float lo[3], hi[3];
+    for (int i = 0; i < 4; i++) {
+        position(corners[i], p[i]);
+    }
+    for (int a = 0; a < 3; a++)
+    {
+        lo[a] = std::min(std::min(p[0][a], p[1][a]), std::min(p[2][a], p[3][a]));
+        hi[a] = std::max(std::max(p[0][a], p[1][a]), std::max(p[2][a], p[3][a]));
+    }
+
+    int axis = -1;
+    for (int a = 0; a < 3; a++) {
+        if (lo[a] == hi[a]) axis = a;
+    }
+    if (axis < 0) return false;
+    const int du = U_AXES[axis];
+    const int dv = V_AXES[axis];
+
+    // Which of the axis' two faces wrote these corners
+    int face = -1;
+    for (int f = axis * 2; f < axis * 2 + 2 && face < 0; f++)
+    {
+        bool match = true;
+        for (int i = 0; i < 4 && match; i++)
+        {
+            float u = CORNERS[f][i][0] ? hi[du] : lo[du];
+            float v = CORNERS[f][i][1] ? hi[dv] : lo[dv];
+            match = (p[i][du] == u && p[i][dv] == v);
+        }
+        if (match) face = f;
+    }
+    if (face < 0) return false;
+
+    uint32_t x, y, z, w, h;
+    if (!relative(lo[0], origin[0], x) || !relative(lo[1], origin[1], y) || !relative(lo[2], origin[2], z)
+        || !relative(hi[du] - lo[du], 0, w) || !relative(hi[dv] - lo[dv], 0, h)) {
+        return false;
+    }
+
+    const Vertex& c = corners[0];
+    out.lo = x | (y << 8) | (z << 16) | (w << 24);
+    out.hi = h | ((uint32_t)face << 8)
+        | (channel7(c.cx) << 11) | (channel7(c.cy) << 18) | (channel7(c.cz) << 25);
+    return true;
+}
+
+void PackedQuads::unpack(const PackedQuad& quad, const int origin[3], Vertex* outCorners)
+{
+    const int face = (quad.hi >> 8) & 7u;
+    const int axis = face / 2;
+    const float base[3] = {
+        float((quad.lo & 255u) + origin[0]),
+        float(((quad.lo >> 8) & 255u) + origin[1]),
+        float(((quad.lo >> 16) & 255u) + origin[2])
+    };
+    const float w = float(quad.lo >> 24);
+    const float h = float(quad.hi & 255u);
+    const float r = float((quad.hi >> 11) & 127u) / 127.f;
+    const float g = float((quad.hi >> 18) & 127u) / 127.f;
+    const float b = float((quad.hi >> 25) & 127u) / 127.f;
+
+    for (int i = 0; i < 4; i++)
+    {
+        float p[3] = { base[0], base[1], base[2] };
+        p[U_AXES[axis]] += CORNERS[face][i][0] * w;
+        p[V_AXES[axis]] += CORNERS[face][i][1] * h;
+        outCorners[i] = Vertex(p[0], p[1], p[2], r, g, b);
+    }
+}
+
+bool PackedQuads::packMesh(const std::vector<Vertex>& verts, const int origin[3], std::vector<PackedQuad>& out)
+{
+    out.resize(verts.size() / 4);
+    for (size_t q = 0; q < out.size(); q++)
+    {
+        if (!pack(&verts[q * 4], origin, out[q])) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+struct Vertex;
+
+/**
+ * One mesher quad in 8 bytes, for vertex pulling: shaders/quad_pull.vert
+ * reads these from a storage buffer and expands each into its corners
+ * from gl_VertexIndex, so a quad costs 8 bytes instead of 4 x 24 (plus
+ * indices).
+ *
+ *   lo: x | y << 8 | z << 16 | w << 24
+ *   hi: h | face << 8 | r << 11 | g << 18 | b << 25
+ *
+ * (x, y, z) is the quad's minimum corner relative to the mesh origin,
+ * w and h its size along the face's in-plane axes (X faces: y, z; Y faces:
+ * x, z; Z faces: x, y), face the mesher's face index (+X = 0 ... -Z = 5)
+ * and r, g, b its colour at 7 bits per channel. Coordinates and sizes
+ * must fit 0..MAX_COORD, enough for an 8x8 superchunk.
+ *
+ * A record of all zeros is an empty quad (ChunkMesher::padQuads padding).
+ */
+struct PackedQuad
+{
+    uint32_t lo = 0;
+    uint32_t hi = 0;
+};
+
+namespace PackedQuads
+{
+    const int MAX_COORD = 255;
+
+    /**
+     * Corner order of ChunkMesher's buildQuad helpers as (u, v) steps per
+     * face, so unpacking reproduces their winding. quad_pull.vert has
+     * the same table.
+     */
+    extern const uint8_t CORNERS[6][4][2];
+
+    /**
+     * Origin for packing a mesh: its lowest quad corner rounded down to
+     * the chunk grid. Every mesh (chunk LOD, seam, superchunk) lies within
+     * one chunk or group from there, and slice patches of a LOD0 mesh stay
+     * in the same chunk, so the origin doesn't move. Padding quads are
+     * skipped; a mesh of only padding gets (0, 0, 0).
+     */
+    void meshOrigin(const std::vector<Vertex>& verts, int outOrigin[3]);
+
+    /**
+     * Packs four corners written by a buildQuad helper. Returns false if
+     * they don't form an axis-aligned quad within MAX_COORD of `origin`.
+     */
+    bool pack(const Vertex* corners, const int origin[3], PackedQuad& out);
+
+    /**
+     * CPU copy of what quad_pull.vert does, for checks and tools.
+     */
+    void unpack(const PackedQuad& quad, const int origin[3], Vertex* outCorners);
+
+    /**
+     * Packs verts (four per quad) into out, one record per quad. Returns
+     * false, with out partly written, if a quad doesn't fit.
+     */
+    bool packMesh(const std::vector<Vertex>& verts, const int origin[3], std::vector<PackedQuad>& out);
+}
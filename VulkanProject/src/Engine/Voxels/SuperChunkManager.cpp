@@ -0,0 +1,284 @@
+#include "SuperChunkManager.h"
+
+#include <algorithm>
+#include <cmath>
+#include "Engine/Utils/Logger.h"
+#include "Engine/Utils/Profiler.h"
+#include "Engine/Utils/ThreadPool.h"
+
+extern ThreadPool g_threadPool;
+
+namespace
+{
+    // splitmix64 finalizer
+    uint64_t mix64(uint64_t x)
+    {
+        x += 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
+    }
+
+    int floorDiv(int a, int b)
+    {
+        return (a >= 0) ? a / b : -((-a + b - 1) / b);
+    }
+
+    const int COARSEST_LOD = Chunk::MAX_LOD_LEVELS - 1;
+}
+
+SuperChunkManager::SuperChunkManager(MeshSink* meshSink, MeshResidency& residency)
+    : m_meshSink(meshSink)
+    , m_residency(&residency)
+{
+}
+
+SuperChunkManager::~SuperChunkManager()
+{
+    clear();
+}
+
+void SuperChunkManager::setEnabled(bool enabled)
+{
+    if (enabled == m_enabled) return;
+    m_enabled = enabled;
+    if (!m_enabled) {
+        clear();
+    }
+}
+
+void SuperChunkManager::setGroupSize(int groupSize)
+{
+    groupSize = (groupSize >= 8) ? 8 : 4;
+    if (groupSize == m_groupSize) return;
+    m_groupSize = groupSize;
+    clear();
+}
+
+ChunkCoord SuperChunkManager::groupOf(int cx, int cy, int cz) const
+{
+    return ChunkCoord(floorDiv(cx, m_groupSize), cy, floorDiv(cz, m_groupSize));
+}
+
+const SuperChunk* SuperChunkManager::findActive(int cx, int cy, int cz) const
+{
+    if (m_activeCount == 0) return nullptr;
+    auto it = m_superChunks.find(groupOf(cx, cy, cz));
+    if (it == m_superChunks.end() || !it->second.active) {
+        return nullptr;
+    }
+    return &it->second;
+}
+
+void SuperChunkManager::getBoundingBox(const SuperChunk& sc, glm::vec3& outMin, glm::vec3& outMax) const
+{
+    outMin = glm::vec3(float(sc.gx * m_groupSize * Chunk::SIZE_X),
+        float(sc.gy * Chunk::SIZE_Y),
+        float(sc.gz * m_groupSize * Chunk::SIZE_Z));
+    outMax = outMin + glm::vec3(float(m_groupSize * Chunk::SIZE_X),
+        float(Chunk::SIZE_Y),
+        float(m_groupSize * Chunk::SIZE_Z));
+}
+
+void SuperChunkManager::clear()
+{
+    for (auto& kv : m_superChunks) {
+        destroyMesh(kv.second);
+    }
+    m_superChunks.clear();
+    m_activeCount = 0;
+
+    // Builds still in flight land in pollResults and find no superchunk
+    std::lock_guard<std::mutex> lock(m_resultMutex);
+    m_results.clear();
+}
+
+void SuperChunkManager::destroyMesh(SuperChunk& sc)
+{
+    if (sc.mesh) {
+        m_residency->onSuperChunkDestroyed(sc.mesh->byteSize);
+    }
+    m_meshSink->destroyMesh(sc.mesh);
+    sc.mesh = nullptr;
+    sc.vertexCount = 0;
+    sc.indexCount = 0;
+    sc.opaqueIndexCount = 0;
+    sc.faceRanges = MeshFaceRanges();
+    sc.meshlets.clear();
+    sc.built = false;
+}
+
+// ------------------------------------------------
+// update
+// ------------------------------------------------
+void SuperChunkManager::update(const ChunkManager& chunks, ChunkMesher& mesher,
+    const glm::vec3& viewerPos, float farDistance, float hysteresis)
+{
+    PROFILE_ZONE("Superchunks");
+    pollResults();
+
+    m_activeCount = 0;
+    if (!m_enabled) return;
+
+    // 1) Group the loaded chunks. The signature is order independent so
+    //    the map's iteration order doesn't matter.
+    m_scan.clear();
+    for (auto& kv : chunks.getAllChunks())
+    {
+        const ChunkCoord& c = kv.first;
+        ChunkCoord g = groupOf(c.x, c.y, c.z);
+        GroupScan& scan = m_scan[g];
+        scan.members++;
+
+        uint32_t version = kv.second->getVersion();
+        if (version == 0) {
+            scan.generated = false; // still queued for generation
+        }
+        int local = (c.x - g.x * m_groupSize) + m_groupSize * (c.z - g.z * m_groupSize);
+        scan.signature += mix64(((uint64_t)local << 32) | version);
+    }
+
+    // 2) Drop superchunks whose group is gone or incomplete
+    const int fullGroup = m_groupSize * m_groupSize;
+    for (auto it = m_superChunks.begin(); it != m_superChunks.end(); )
+    {
+        auto s = m_scan.find(it->first);
+        if (s == m_scan.end() || s->second.members < fullGroup || !s->second.generated) {
+            destroyMesh(it->second);
+            it = m_superChunks.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+
+    // 3) Activate far groups, (re)build stale ones
+    const uint64_t modeSalt = mix64(((uint64_t)mesher.getMipReduction() << 8) | (uint64_t)m_groupSize);
+    int buildsLeft = MAX_BUILDS_PER_UPDATE;
+    for (auto& kv : m_scan)
+    {
+        const GroupScan& scan = kv.second;
+        if (scan.members < fullGroup || !scan.generated) continue;
+
+        SuperChunk probe;
+        probe.gx = kv.first.x;
+        probe.gy = kv.first.y;
+        probe.gz = kv.first.z;
+        glm::vec3 minB, maxB;
+        getBoundingBox(probe, minB, maxB);
+        float dx = std::max(std::max(minB.x - viewerPos.x, 0.f), viewerPos.x - maxB.x);
+        float dy = std::max(std::max(minB.y - viewerPos.y, 0.f), viewerPos.y - maxB.y);
+        float dz = std::max(std::max(minB.z - viewerPos.z, 0.f), viewerPos.z - maxB.z);
+        float dist = std::sqrt(dx * dx + dy * dy + dz * dz);
+
+        auto it = m_superChunks.find(kv.first);
+        bool wasActive = (it != m_superChunks.end() && it->second.active);
+
+        // Same hysteresis idea as LODPolicy: harder to enter than to stay
+        bool far = wasActive ? (dist >= farDistance)
+                             : (dist >= farDistance * (1.f + hysteresis));
+        if (!far)
+        {
+            if (it != m_superChunks.end()) it->second.active = false;
+            continue;
+        }
+
+        if (it == m_superChunks.end()) {
+            it = m_superChunks.emplace(kv.first, probe).first;
+        }
+        SuperChunk& sc = it->second;
+
+        uint64_t signature = scan.signature ^ modeSalt;
+        bool stale = !sc.built || sc.builtSignature != signature;
+        bool inFlight = sc.building && sc.pendingSignature == signature;
+        if (stale && !inFlight && !sc.building && buildsLeft > 0) {
+            scheduleBuild(sc, signature, chunks, mesher);
+            buildsLeft--;
+        }
+
+        sc.active = sc.built;
+        if (sc.active) m_activeCount++;
+    }
+}
+
+// ------------------------------------------------
+// scheduleBuild
+//  Members' mip levels are copied here on the main thread (cheap, usually
+//  cached), so the job never touches a chunk that might get unloaded.
+// ------------------------------------------------
+void SuperChunkManager::scheduleBuild(SuperChunk& sc, uint64_t signature,
+    const ChunkManager& chunks, ChunkMesher& mesher)
+{
+    const int groupSize = m_groupSize;
+    std::vector<std::vector<int>> members((size_t)groupSize * groupSize);
+    for (int mz = 0; mz < groupSize; mz++)
+    {
+        for (int mx = 0; mx < groupSize; mx++)
+        {
+            const Chunk* c = chunks.getChunk(sc.gx * groupSize + mx, sc.gy, sc.gz * groupSize + mz);
+            if (c) {
+                c->copyMipLevel(COARSEST_LOD, mesher.getMipReduction(), mesher.getProperties(),
+                    members[(size_t)mx + (size_t)groupSize * mz]);
+            }
+        }
+    }
+
+    sc.building = true;
+    sc.pendingSignature = signature;
+
+    ChunkCoord group(sc.gx, sc.gy, sc.gz);
+    int offX = sc.gx * groupSize * Chunk::SIZE_X;
+    int offY = sc.gy * Chunk::SIZE_Y;
+    int offZ = sc.gz * groupSize * Chunk::SIZE_Z;
+
+    g_threadPool.enqueueTask([this, &mesher, members = std::move(members), group, signature,
+        groupSize, offX, offY, offZ]()
+        {
+            PROFILE_ZONE("Superchunk Job");
+            BuildResult res;
+            res.group = group;
+            res.signature = signature;
+            mesher.buildSuperChunkMesh(members, groupSize, COARSEST_LOD,
+                offX, offY, offZ, res.verts, res.inds, &res.opaqueIndexCount, &res.faceRanges);
+            ChunkMesher::buildMeshlets(res.verts, res.opaqueIndexCount, res.faceRanges, res.meshlets);
+
+            std::lock_guard<std::mutex> lock(m_resultMutex);
+            m_results.push_back(std::move(res));
+        });
+}
+
+// ------------------------------------------------
+// pollResults
+// ------------------------------------------------
+void SuperChunkManager::pollResults()
+{
+    std::vector<BuildResult> local;
+    {
+        std::lock_guard<std::mutex> lock(m_resultMutex);
+        local.swap(m_results);
+    }
+
+    for (BuildResult& res : local)
+    {
+        auto it = m_superChunks.find(res.group);
+        if (it == m_superChunks.end()) continue; // dropped meanwhile
+
+        SuperChunk& sc = it->second;
+        if (!sc.building || sc.pendingSignature != res.signature) continue;
+        sc.building = false;
+
+        destroyMesh(sc);
+        sc.mesh = m_meshSink->uploadMesh(res.verts, res.inds);
+        sc.vertexCount = (uint32_t)res.verts.size();
+        sc.indexCount = sc.mesh ? sc.mesh->indexCount : 0;
+        sc.opaqueIndexCount = res.opaqueIndexCount;
+        sc.faceRanges = res.faceRanges;
+        sc.meshlets = std::move(res.meshlets);
+        sc.builtSignature = res.signature;
+        sc.built = true;
+        if (sc.mesh) {
+            m_residency->onSuperChunkUploaded(sc.mesh->byteSize);
+        }
+        LOG_DEBUG("Superchunk ({},{},{}) => {} verts", sc.gx, sc.gy, sc.gz, sc.vertexCount);
+    }
+}
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <vector>
+#include <mutex>
+#include <cstdint>
+#include <unordered_map>
+#include <glm/vec3.hpp>
+#include "ChunkManager.h"
+#include "ChunkMesher.h"
+#include "MeshSink.h"
+#include "MeshResidency.h"
+
+/**
+ * One far-field mesh covering a group x group block of chunks (one layer)
+ * at the coarsest LOD. Keyed by group coordinate: chunk (cx, cy, cz)
+ * belongs to group (floor(cx / group), cy, floor(cz / group)).
+ */
+struct SuperChunk
+{
+    int gx = 0, gy = 0, gz = 0;
+
+    GpuMesh* mesh = nullptr;
+    uint32_t vertexCount = 0;
+    uint32_t indexCount = 0;
+    uint32_t opaqueIndexCount = 0; // as in ChunkLODData
+    MeshFaceRanges faceRanges;     // as in ChunkLODData
+    std::vector<Meshlet> meshlets; // as in ChunkLODData
+
+    uint64_t builtSignature = 0;   // member versions + mip mode of the current mesh
+    uint64_t pendingSignature = 0; // ... of the build in flight
+    bool     built = false;        // has a mesh (possibly empty) for some signature
+    bool     building = false;
+    bool     active = false;       // drawn instead of its members
+};
+
+/**
+ * Far-field "superchunks": beyond a distance, groups of 4x4 (or 8x8)
+ * chunks are meshed together at the coarsest LOD and drawn as one mesh,
+ * with greedy merging across the old chunk borders. Cuts draw calls and
+ * triangles for distant terrain, where each chunk would only contribute a
+ * few quads.
+ *
+ * A group becomes a superchunk once all its members are loaded and
+ * generated. It is rebuilt whenever a member's version (or the mip
+ * reduction mode) changes; until the rebuild lands the old mesh stays up.
+ * While a superchunk is active the renderer skips its members, which keep
+ * their own meshes for when the camera comes closer.
+ *
+ * Mesh memory is reported to the world's MeshResidency.
+ *
+ * Main thread only, except the meshing jobs it queues on g_threadPool.
+ */
+class SuperChunkManager
+{
+public:
+    SuperChunkManager(MeshSink* meshSink, MeshResidency& residency);
+    ~SuperChunkManager();
+
+    SuperChunkManager(const SuperChunkManager&) = delete;
+    SuperChunkManager& operator=(const SuperChunkManager&) = delete;
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return m_enabled; }
+
+    /// Chunks per side of a group (4 or 8). Drops all existing superchunks.
+    void setGroupSize(int groupSize);
+    int  getGroupSize() const { return m_groupSize; }
+
+    /**
+     * Once per world update: uploads finished builds, then activates,
+     * deactivates and (re)builds superchunks. Groups count as far once
+     * their bounds are `farDistance` (+ hysteresis) from the viewer.
+     */
+    void update(const ChunkManager& chunks, ChunkMesher& mesher,
+        const glm::vec3& viewerPos, float farDistance, float hysteresis);
+
+    /// The active superchunk drawing chunk (cx, cy, cz), or nullptr.
+    const SuperChunk* findActive(int cx, int cy, int cz) const;
+
+    const std::unordered_map<ChunkCoord, SuperChunk, ChunkCoordHash>& getAll() const { return m_superChunks; }
+
+    void getBoundingBox(const SuperChunk& sc, glm::vec3& outMin, glm::vec3& outMax) const;
+
+    /// Releases every mesh (world shutdown / settings change).
+    void clear();
+
+    // Stats
+    int    getActiveCount() const { return m_activeCount; }
+
+private:
+    struct BuildResult
+    {
+        ChunkCoord            group{ 0, 0, 0 };
+        uint64_t              signature = 0;
+        std::vector<Vertex>   verts;
+        std::vector<uint32_t> inds;
+        uint32_t              opaqueIndexCount = 0;
+        MeshFaceRanges        faceRanges;
+        std::vector<Meshlet>  meshlets;
+    };
+
+    struct GroupScan
+    {
+        int      members = 0;
+        bool     generated = true;
+        uint64_t signature = 0;
+    };
+
+    // At most this many builds are gathered per update (main-thread cost)
+    static const int MAX_BUILDS_PER_UPDATE = 8;
+
+    MeshSink*      m_meshSink = nullptr;
+    MeshResidency* m_residency = nullptr;
+    bool           m_enabled = true;
+    int            m_groupSize = 4;
+
+    std::unordered_map<ChunkCoord, SuperChunk, ChunkCoordHash> m_superChunks;
+    std::unordered_map<ChunkCoord, GroupScan, ChunkCoordHash>  m_scan; // scratch
+
+    std::mutex               m_resultMutex;
+    std::vector<BuildResult> m_results;
+
+    int    m_activeCount = 0;
+
+    ChunkCoord groupOf(int cx, int cy, int cz) const;
+    void pollResults();
+    void scheduleBuild(SuperChunk& sc, uint64_t signature, const ChunkManager& chunks, ChunkMesher& mesher);
+    void destroyMesh(SuperChunk& sc);
+};
@@ -0,0 +1,51 @@
+#include "VoxelPropertyTable.h"
+#include "VoxelTypeRegistry.h"
+#include "Chunk.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+static_assert(VoxelPropertyTable::MAX_TYPES == Chunk::MAX_VOXEL_TYPES,
+    "The property table must cover every ID a chunk can hold");
+
+namespace
+{
+    uint32_t packChannel(float c, int shift)
+    {
+        float clamped = std::min(std::max(c, 0.f), 1.f);
+        return (uint32_t)(clamped * 255.f + 0.5f) << shift;
+    }
+}
+
+VoxelPropertyTable VoxelPropertyTable::build(const VoxelTypeRegistry& registry)
+{
+    int count = registry.getVoxelCount();
+    if (count > MAX_TYPES) {
+        throw std::runtime_error("Too many voxel types: " + std::to_string(count));
+    }
+
+    VoxelPropertyTable table;
+    table.count = count;
+    for (int id = 0; id < count; id++)
+    {
+        const VoxelType& vt = registry.getVoxel(id);
+        uint64_t bit = 1ull << id;
+
+        table.color[id] = { vt.color.r, vt.color.g, vt.color.b };
+        table.packedColor[id] = packChannel(vt.color.r, 0) | packChannel(vt.color.g, 8)
+            | packChannel(vt.color.b, 16) | 0xFF000000u;
+
+        if (vt.isSolid) table.solidBits |= bit;
+        if (vt.isLiquid) table.liquidBits |= bit;
+
+        // No see-through solids (glass) yet: solid means opaque
+        if (vt.isSolid) {
+            table.opaqueBits |= bit;
+            table.cullClass[id] = VoxelCullClass::Opaque;
+        }
+        else {
+            table.cullClass[id] = (id == 0) ? VoxelCullClass::Empty : VoxelCullClass::Translucent;
+        }
+    }
+    return table;
+}
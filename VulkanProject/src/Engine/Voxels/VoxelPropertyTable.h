@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+
+class VoxelTypeRegistry;
+
+/**
+ * How a voxel type takes part in face culling:
+ *  - Empty:       never has faces of its own (air)
+ *  - Opaque:      hides whatever is behind it
+ *  - Translucent: can be seen through (liquids)
+ */
+enum class VoxelCullClass : uint8_t
+{
+    Empty = 0,
+    Opaque,
+    Translucent
+};
+
+/**
+ * Frozen, flat copy of the registered voxel types for hot loops (meshing,
+ * downsampling): one plain array or 64-bit set per property, indexed by
+ * voxel ID, without strings or the registry singleton.
+ * Every ID a chunk can hold (< MAX_TYPES) is valid; unregistered ones
+ * read as black, empty entries. The arrays are not bounds checked; the
+ * isX() tests also take IDs outside that range (Chunk::getBlock's -1 for
+ * out-of-bounds) and return false.
+ *
+ * Built once by VoxelTypeRegistry::freeze() at the end of
+ * registerAllVoxels() and handed to its users by reference.
+ */
+struct VoxelPropertyTable
+{
+    static const int MAX_TYPES = 64; // Chunk::MAX_VOXEL_TYPES
+
+    struct Color
+    {
+        float r, g, b;
+    };
+
+    int            count = 0;                   // registered types
+    Color          color[MAX_TYPES] = {};       // mesher vertex colour
+    uint32_t       packedColor[MAX_TYPES] = {}; // RGBA8, red in the low byte
+    VoxelCullClass cullClass[MAX_TYPES] = {};
+    uint64_t       solidBits = 0;
+    uint64_t       liquidBits = 0;
+    uint64_t       opaqueBits = 0;
+
+    bool isSolid(int id) const { return hasBit(solidBits, id); }
+    bool isLiquid(int id) const { return hasBit(liquidBits, id); }
+    bool isOpaque(int id) const { return hasBit(opaqueBits, id); }
+
+    /**
+     * Flattens the registry's current types. Throws if it holds more
+     * than MAX_TYPES.
+     */
+    static VoxelPropertyTable build(const VoxelTypeRegistry& registry);
+
+private:
+    // One unsigned compare covers id < 0 too; shifting by it would be undefined
+    static bool hasBit(uint64_t bits, int id)
+    {
+        return (unsigned)id < (unsigned)MAX_TYPES && ((bits >> id) & 1u) != 0;
+    }
+};
@@ -0,0 +1,283 @@
+#include "VoxelRaycast.h"
+#include "Chunk.h"
+#include "ChunkManager.h"
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+#include <chrono>
+
+// ------------------------------------------------
+// Helpers
+// ------------------------------------------------
+static inline int floorDiv(int a, int b)
+{
+    // Integer division rounding towards -infinity (voxel -> chunk coordinate)
+    return (a >= 0) ? (a / b) : -((-a + b - 1) / b);
+}
+
+static inline uint32_t hashChunkCoord(int cx, int cy, int cz)
+{
+    uint32_t h = static_cast<uint32_t>(cx) * 73856093u
+        ^ static_cast<uint32_t>(cy) * 19349663u
+        ^ static_cast<uint32_t>(cz) * 83492791u;
+    return h;
+}
+
+// ------------------------------------------------
+// VoxelRaycaster
+// ------------------------------------------------
+VoxelRaycaster::VoxelRaycaster(const ChunkManager& manager)
+    : m_manager(manager)
+{
+}
+
+const Chunk* VoxelRaycaster::lookupChunk(int cx, int cy, int cz)
+{
+    CacheEntry& e = m_cache[hashChunkCoord(cx, cy, cz) & (CACHE_SIZE - 1)];
+    if (e.generation == m_generation && e.cx == cx && e.cy == cy && e.cz == cz) {
+        return e.chunk;
+    }
+
+    // Miss => go to the map. Missing chunks are cached as nullptr too,
+    // so rays through unloaded space don't keep hashing the same coord.
+    m_stats.chunkLookups++;
+    e.cx = cx;
+    e.cy = cy;
+    e.cz = cz;
+    e.generation = m_generation;
+    e.chunk = m_manager.getChunk(cx, cy, cz);
+    return e.chunk;
+}
+
+RaycastHit VoxelRaycaster::raycast(const glm::vec3& origin, const glm::vec3& dir, float maxDistance)
+{
+    bumpGeneration();
+    return traceRay(origin, dir, maxDistance);
+}
+
+void VoxelRaycaster::raycastBatch(const glm::vec3* origins,
+    const glm::vec3* dirs,
+    size_t count,
+    float maxDistance,
+    RaycastHit* outHits)
+{
+    // One generation for the whole batch => cached chunk pointers are shared
+    bumpGeneration();
+    for (size_t i = 0; i < count; i++) {
+        outHits[i] = traceRay(origins[i], dirs[i], maxDistance);
+    }
+}
+
+void VoxelRaycaster::bumpGeneration()
+{
+    if (++m_generation == 0) {
+        // Wrapped around => forget everything, 0 means "never filled"
+        for (auto& e : m_cache) {
+            e = CacheEntry();
+        }
+        m_generation = 1;
+    }
+}
+
+RaycastHit VoxelRaycaster::traceRay(const glm::vec3& origin, const glm::vec3& dirIn, float maxDistance)
+{
+    RaycastHit result;
+    m_stats.rays++;
+
+    float len = glm::length(dirIn);
+    if (len <= 0.f || maxDistance <= 0.f) {
+        return result;
+    }
+    glm::vec3 dir = dirIn / len;
+
+    const float INF = std::numeric_limits<float>::infinity();
+    const int chunkSize[3] = { Chunk::SIZE_X, Chunk::SIZE_Y, Chunk::SIZE_Z };
+
+    // Current voxel, step direction and the ray parameter at which we cross
+    // the next voxel boundary on each axis (Amanatides & Woo).
+    int   v[3];
+    int   step[3];
+    float tMax[3];
+    float tDelta[3];
+    for (int a = 0; a < 3; a++)
+    {
+        v[a] = static_cast<int>(std::floor(origin[a]));
+        if (dir[a] > 1e-12f) {
+            step[a] = 1;
+            tDelta[a] = 1.f / dir[a];
+            tMax[a] = (float(v[a] + 1) - origin[a]) * tDelta[a];
+        }
+        else if (dir[a] < -1e-12f) {
+            step[a] = -1;
+            tDelta[a] = -1.f / dir[a];
+            tMax[a] = (origin[a] - float(v[a])) * tDelta[a];
+        }
+        else {
+            step[a] = 0;
+            tDelta[a] = INF;
+            tMax[a] = INF;
+        }
+    }
+
+    float t = 0.f;          // ray parameter where we entered the current voxel
+    int   enteredAxis = -1; // axis we crossed to get here (-1 => ray origin)
+
+    const Chunk* chunk = nullptr;
+    int  c[3] = { 0, 0, 0 };
+    bool haveChunk = false;
+
+    while (t <= maxDistance)
+    {
+        int ncx = floorDiv(v[0], chunkSize[0]);
+        int ncy = floorDiv(v[1], chunkSize[1]);
+        int ncz = floorDiv(v[2], chunkSize[2]);
+        if (!haveChunk || ncx != c[0] || ncy != c[1] || ncz != c[2])
+        {
+            c[0] = ncx; c[1] = ncy; c[2] = ncz;
+            chunk = lookupChunk(ncx, ncy, ncz);
+            haveChunk = true;
+        }
+
+        if (!chunk || chunk->isEmpty())
+        {
+            // Nothing to hit in here => jump straight to where the ray leaves
+            // this chunk. n[a] = voxel crossings needed to exit along axis a.
+            int   n[3] = { 0, 0, 0 };
+            float tExit = INF;
+            int   exitAxis = -1;
+            for (int a = 0; a < 3; a++)
+            {
+                if (step[a] == 0) continue;
+                int base = c[a] * chunkSize[a];
+                n[a] = (step[a] > 0) ? (base + chunkSize[a] - v[a]) : (v[a] - base + 1);
+                float te = tMax[a] + float(n[a] - 1) * tDelta[a];
+                if (te < tExit) {
+                    tExit = te;
+                    exitAxis = a;
+                }
+            }
+            if (exitAxis < 0 || tExit > maxDistance) {
+                break;
+            }
+
+            // Advance every axis by the crossings that happen before tExit.
+            // The exit axis crosses out of the chunk; ties on the other axes
+            // are left to the regular stepping below, like plain DDA would.
+            for (int a = 0; a < 3; a++)
+            {
+                if (step[a] == 0) continue;
+                int k = 0;
+                if (a == exitAxis) {
+                    k = n[a];
+                }
+                else if (tMax[a] < tExit) {
+                    k = static_cast<int>(std::ceil((tExit - tMax[a]) / tDelta[a]));
+                    if (k > n[a] - 1) k = n[a] - 1;
+                }
+                v[a] += k * step[a];
+                tMax[a] += float(k) * tDelta[a];
+            }
+
+            t = tExit;
+            enteredAxis = exitAxis;
+            m_stats.chunkSkips++;
+            continue;
+        }
+
+        // Regular voxel test
+        m_stats.voxelSteps++;
+        int blockID = chunk->getBlock(
+            v[0] - c[0] * chunkSize[0],
+            v[1] - c[1] * chunkSize[1],
+            v[2] - c[2] * chunkSize[2]);
+        if (blockID > 0)
+        {
+            result.hit = true;
+            result.voxel = glm::ivec3(v[0], v[1], v[2]);
+            result.distance = t;
+            result.blockID = blockID;
+            if (enteredAxis >= 0) {
+                result.normal[enteredAxis] = -step[enteredAxis];
+            }
+            return result;
+        }
+
+        // Step to the next voxel along the axis with the nearest boundary
+        int a = 0;
+        if (tMax[1] < tMax[a]) a = 1;
+        if (tMax[2] < tMax[a]) a = 2;
+
+        t = tMax[a];
+        v[a] += step[a];
+        tMax[a] += tDelta[a];
+        enteredAxis = a;
+    }
+
+    return result;
+}
+
+// ------------------------------------------------
+// benchmarkRaycasts
+// ------------------------------------------------
+RaycastBenchmarkResult benchmarkRaycasts(const ChunkManager& manager,
+    const glm::vec3& origin,
+    int rayCount,
+    float maxDistance)
+{
+    RaycastBenchmarkResult out;
+    if (rayCount <= 0) {
+        return out;
+    }
+    out.rayCount = rayCount;
+
+    // Fixed seed so numbers are comparable between runs.
+    // Directions cover the horizon and the ground below the origin,
+    // which is where rays actually have work to do.
+    std::mt19937 rng(1337u);
+    std::uniform_real_distribution<float> yawDist(0.f, 6.2831853f);
+    std::uniform_real_distribution<float> pitchDist(-1.2f, 0.15f);
+
+    std::vector<glm::vec3> origins(rayCount, origin);
+    std::vector<glm::vec3> dirs(rayCount);
+    for (int i = 0; i < rayCount; i++)
+    {
+        float yaw = yawDist(rng);
+        float pitch = pitchDist(rng);
+        dirs[i] = glm::vec3(
+            std::cos(yaw) * std::cos(pitch),
+            std::sin(pitch),
+            std::sin(yaw) * std::cos(pitch));
+    }
+
+    std::vector<RaycastHit> hits(rayCount);
+
+    // 1) One ray at a time
+    {
+        VoxelRaycaster caster(manager);
+        auto t0 = std::chrono::high_resolution_clock::now();
+        for (int i = 0; i < rayCount; i++) {
+            hits[i] = caster.raycast(origins[i], dirs[i], maxDistance);
+        }
+        auto t1 = std::chrono::high_resolution_clock::now();
+        double sec = std::chrono::duration<double>(t1 - t0).count();
+        out.singleRaysPerSec = (sec > 0.0) ? double(rayCount) / sec : 0.0;
+    }
+
+    // 2) Batched
+    {
+        VoxelRaycaster caster(manager);
+        auto t0 = std::chrono::high_resolution_clock::now();
+        caster.raycastBatch(origins.data(), dirs.data(), hits.size(), maxDistance, hits.data());
+        auto t1 = std::chrono::high_resolution_clock::now();
+        double sec = std::chrono::duration<double>(t1 - t0).count();
+        out.batchRaysPerSec = (sec > 0.0) ? double(rayCount) / sec : 0.0;
+        out.stats = caster.getStats();
+    }
+
+    for (const auto& h : hits) {
+        if (h.hit) out.hitCount++;
+    }
+    return out;
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+
+class Chunk;
+class ChunkManager;
+
+/**
+ * Result of a single voxel ray query.
+ *  - voxel    : world-space voxel coordinate of the block that was hit
+ *  - normal   : face normal of the side the ray entered through
+ *               (zero if the ray started inside a solid block)
+ *  - distance : distance along the (normalized) ray to the entry point
+ *  - blockID  : voxel type ID of the hit block
+ */
+struct RaycastHit
+{
+    bool       hit = false;
+    glm::ivec3 voxel = glm::ivec3(0);
+    glm::ivec3 normal = glm::ivec3(0);
+    float      distance = 0.f;
+    int        blockID = 0;
+};
+
+/**
+ * Simple counters gathered while tracing, mostly for the debug overlay
+ * and the raycast benchmark.
+ */
+struct RaycastStats
+{
+    uint64_t rays = 0;
+    uint64_t voxelSteps = 0;   ///< voxels visited one at a time
+    uint64_t chunkSkips = 0;   ///< empty / missing chunks crossed in one step
+    uint64_t chunkLookups = 0; ///< lookups that had to go to the ChunkManager map
+};
+
+/**
+ * Amanatides & Woo voxel traversal over the ChunkManager.
+ *
+ * Voxels are stepped one at a time only inside chunks that actually contain
+ * blocks. Chunks that are missing or entirely air are crossed in a single
+ * step by jumping straight to the ray's exit point on the chunk boundary.
+ *
+ * Chunk lookups go through a small direct-mapped cache. A cache generation
+ * is bumped per raycast() call and once per raycastBatch() call, so a batch
+ * of rays shares its lookups while single rays never see stale pointers
+ * after chunks were streamed out.
+ *
+ * Any non-air block (ID != 0) counts as a hit.
+ *
+ * NOTE: The ChunkManager's map is only mutated on the main thread, so the
+ * raycaster must be used from there (or while streaming is paused).
+ */
+class VoxelRaycaster
+{
+public:
+    explicit VoxelRaycaster(const ChunkManager& manager);
+
+    /**
+     * Traces one ray. 'dir' does not need to be normalized.
+     * Returns a miss if nothing is hit within maxDistance.
+     */
+    RaycastHit raycast(const glm::vec3& origin, const glm::vec3& dir, float maxDistance);
+
+    /**
+     * Traces 'count' rays, writing one RaycastHit per ray into outHits.
+     * All rays share the chunk lookup cache, which makes many short rays
+     * from the same area (AI sight checks, visibility probes) much cheaper.
+     */
+    void raycastBatch(const glm::vec3* origins,
+        const glm::vec3* dirs,
+        size_t count,
+        float maxDistance,
+        RaycastHit* outHits);
+
+    const RaycastStats& getStats() const { return m_stats; }
+    void resetStats() { m_stats = RaycastStats(); }
+
+private:
+    static const int CACHE_SIZE = 64; // must be a power of two
+
+    struct CacheEntry
+    {
+        int          cx = 0, cy = 0, cz = 0;
+        uint32_t     generation = 0; // 0 => never filled
+        const Chunk* chunk = nullptr;
+    };
+
+    const Chunk* lookupChunk(int cx, int cy, int cz);
+    void         bumpGeneration();
+    RaycastHit   traceRay(const glm::vec3& origin, const glm::vec3& dir, float maxDistance);
+
+    const ChunkManager& m_manager;
+    CacheEntry          m_cache[CACHE_SIZE];
+    uint32_t            m_generation = 0;
+    RaycastStats        m_stats;
+};
+
+/**
+ * Benchmark numbers for benchmarkRaycasts().
+ */
+struct RaycastBenchmarkResult
+{
+    int    rayCount = 0;
+    int    hitCount = 0;
+    double singleRaysPerSec = 0.0;
+    double batchRaysPerSec = 0.0;
+    RaycastStats stats;
+};
+
+/**
+ * Fires 'rayCount' pseudo-random rays (fixed seed, so runs are comparable)
+ * from 'origin' into the lower hemisphere and the horizon, once one-by-one
+ * and once through raycastBatch(), and reports rays/second for both.
+ */
+RaycastBenchmarkResult benchmarkRaycasts(const ChunkManager& manager,
+    const glm::vec3& origin,
+    int rayCount,
+    float maxDistance);
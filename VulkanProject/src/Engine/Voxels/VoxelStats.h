@@ -0,0 +1,67 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include "Chunk.h"
+
+/**
+ * World-wide voxel counts per type, kept up to date by the chunks
+ * themselves (see Chunk::setStats): every setBlock/assignBlocks reports
+ * its delta, so reading totals is O(1) no matter how many chunks are loaded.
+ *
+ * Chunks are generated on worker threads, hence the (relaxed) atomics.
+ * Totals are exact once in-flight writes have finished.
+ */
+class VoxelStats
+{
+public:
+    VoxelStats()
+    {
+        for (int i = 0; i < Chunk::MAX_VOXEL_TYPES; i++) {
+            m_typeCounts[i].store(0, std::memory_order_relaxed);
+        }
+    }
+
+    VoxelStats(const VoxelStats&) = delete;
+    VoxelStats& operator=(const VoxelStats&) = delete;
+
+    // ---------------------------------------------------
+    // Updates (called by Chunk)
+    // ---------------------------------------------------
+    void addVoxels(int voxelID, int64_t count)
+    {
+        m_typeCounts[voxelID].fetch_add(count, std::memory_order_relaxed);
+    }
+
+    void onBlockChanged(int oldID, int newID)
+    {
+        addVoxels(oldID, -1);
+        addVoxels(newID, 1);
+    }
+
+    void addChunk(int64_t voxelCount)
+    {
+        m_totalVoxels.fetch_add(voxelCount, std::memory_order_relaxed);
+        m_chunkCount.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void removeChunk(int64_t voxelCount)
+    {
+        m_totalVoxels.fetch_sub(voxelCount, std::memory_order_relaxed);
+        m_chunkCount.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    // ---------------------------------------------------
+    // Queries
+    // ---------------------------------------------------
+    int64_t getTypeCount(int voxelID) const { return m_typeCounts[voxelID].load(std::memory_order_relaxed); }
+    int64_t getAirCount() const { return getTypeCount(0); }
+    int64_t getTotalVoxels() const { return m_totalVoxels.load(std::memory_order_relaxed); }
+    int64_t getNonAirCount() const { return getTotalVoxels() - getAirCount(); }
+    int64_t getChunkCount() const { return m_chunkCount.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<int64_t> m_typeCounts[Chunk::MAX_VOXEL_TYPES];
+    std::atomic<int64_t> m_totalVoxels{ 0 };
+    std::atomic<int64_t> m_chunkCount{ 0 };
+};
@@ -1,5 +1,7 @@
 #include "VoxelTypeRegistry.h"
+#include "BuiltinVoxels.h"
 #include <stdexcept>
+#include <string>
 
 VoxelTypeRegistry& VoxelTypeRegistry::get()
 {
@@ -9,6 +11,9 @@ VoxelTypeRegistry& VoxelTypeRegistry::get()
 
 int VoxelTypeRegistry::registerVoxel(const VoxelType& voxel)
 {
+    if (m_frozen) {
+        throw std::runtime_error("Voxel registry is frozen, can't register " + voxel.name);
+    }
     m_voxels.push_back(voxel);
     // Return the index => first voxel is ID=0, second is ID=1, etc.
     return static_cast<int>(m_voxels.size() - 1);
@@ -21,35 +26,37 @@ const VoxelType& VoxelTypeRegistry::getVoxel(int id) const
     return m_voxels[id];
 }
 
+void VoxelTypeRegistry::freeze()
+{
+    m_properties = VoxelPropertyTable::build(*this);
+    m_frozen = true;
+}
+
+const VoxelPropertyTable& VoxelTypeRegistry::getProperties() const
+{
+    if (!m_frozen) {
+        throw std::runtime_error("Voxel registry not frozen yet (call registerAllVoxels first)");
+    }
+    return m_properties;
+}
+
 void registerAllVoxels()
 {
     auto& registry = VoxelTypeRegistry::get();
 
-    // ID=0 => "Air"
-    // Not solid, not liquid, color doesn't matter, but let's store black for reference
-    int airID = registry.registerVoxel(
-        VoxelType("Air", false, false, { 0.0f, 0.0f, 0.0f })
-    );
-
-    // ID=1 => Stone (solid, gray)
-    int stoneID = registry.registerVoxel(
-        VoxelType("Stone", true, false, { 0.5f, 0.5f, 0.5f })
-    );
-
-    // ID=2 => Grass (solid, green)
-    int grassID = registry.registerVoxel(
-        VoxelType("Grass", true, false, { 0.1f, 1.0f, 0.1f })
-    );
-
-    // ID=3 => Dirt (solid, brown)
-    int dirtID = registry.registerVoxel(
-        VoxelType("Dirt", true, false, { 0.6f, 0.4f, 0.2f })
-    );
-
-    // ID=4 => Water (not solid, blue)
-    int waterID = registry.registerVoxel(
-        VoxelType("Water", false, true, { 0.0f, 0.3f, 0.8f })
-    );
+    // Built-ins first, so their IDs match BuiltinVoxels (0 = Air)
+    for (int builtin = 0; builtin < BuiltinVoxels::COUNT; builtin++)
+    {
+        const BuiltinVoxels::Definition& def = BuiltinVoxels::TYPES[builtin];
+        int id = registry.registerVoxel(
+            VoxelType(def.name, def.solid, def.liquid, { def.r, def.g, def.b })
+        );
+        if (id != builtin) {
+            throw std::runtime_error("Built-in voxel registered out of order: " + std::string(def.name));
+        }
+    }
     // ...Add more as needed...
     // e.g. "Sand", "Wood", "Leaves", etc.
+
+    registry.freeze();
 }
@@ -1,6 +1,7 @@
 #pragma once
 #include <vector>
 #include "VoxelType.h"
+#include "VoxelPropertyTable.h"
 
 ///
 /// A singleton that stores all VoxelType definitions.
@@ -15,15 +16,31 @@ public:
 
     // Register a new voxel type, returning an integer ID
     //   e.g. int stoneID = registerVoxel(VoxelType("Stone", true, false, {0.5f, 0.5f, 0.5f}));
+    // Throws once the registry is frozen.
     int registerVoxel(const VoxelType& voxel);
 
     // Retrieve the VoxelType by ID
     const VoxelType& getVoxel(int id) const;
 
+    // Number of registered types (valid IDs are 0..count-1)
+    int getVoxelCount() const { return static_cast<int>(m_voxels.size()); }
+
+    // Builds the flat property table; no more types can be registered after this.
+    // registerAllVoxels() calls it last.
+    void freeze();
+    bool isFrozen() const { return m_frozen; }
+
+    // The table built by freeze() (throws before that). Meant to be looked up
+    // once and passed by reference, not called per voxel.
+    const VoxelPropertyTable& getProperties() const;
+
 private:
     // Private constructor => enforce singleton usage
     VoxelTypeRegistry() = default;
 
     // The storage for all voxel definitions
     std::vector<VoxelType> m_voxels;
+
+    VoxelPropertyTable m_properties;
+    bool               m_frozen = false;
 };
\ No newline at end of file
@@ -3,16 +3,19 @@
 #include <cmath>
 #include <stdexcept>
 #include <chrono>
-#include "Engine/Graphics/VulkanContext.h"
+#include <atomic>
+#include <algorithm>
 #include "Engine/Utils/Logger.h"
 #include "Engine/Utils/ThreadPool.h"
-#include "LODDownsampler.h"
+#include "Engine/Utils/Profiler.h"
+#include "ChunkVisibility.h"
+#include "VoxelTypeRegistry.h"
 
 extern ThreadPool g_threadPool;
 
-// Timing stats for meshing
-static double s_totalMeshTime = 0.0;
-static int    s_meshCount = 0;
+// Timing stats for meshing (updated from worker threads)
+static std::atomic<uint64_t> s_totalMeshTimeNs{ 0 };
+static std::atomic<int>      s_meshCount{ 0 };
 
 // A struct for passing meshing results back from worker threads
 struct LODMeshBuildResult
@@ -22,15 +25,48 @@ struct LODMeshBuildResult
     int    lodLevel = 0;
     std::vector<Vertex> verts;
     std::vector<uint32_t> inds;
+    uint32_t opaqueIndexCount = 0;
+    MeshSliceLayout slices; // segmented LOD0 mesh
+    MeshFaceRanges faceRanges;
+    std::vector<Meshlet> meshlets;
+    uint64_t faceConnectivity = ChunkVisibility::ALL_CONNECTED;
+
+    // Slice patch instead of a full mesh (see scheduleSlicePatch):
+    // sliceVerts[pass][i] are the new quads of slice sliceIndices[i]
+    bool isSlicePatch = false;
+    std::vector<int> sliceIndices;
+    std::vector<std::vector<Vertex>> sliceVerts[MeshSliceLayout::PASS_COUNT];
 };
 
-// If you want to queue seam building results similarly
+// Seam meshes from worker threads. Looked up by coordinate when they
+// land, so a chunk unloaded in the meantime is simply skipped.
 struct SeamBuildResult
 {
-    Chunk* chunkPtr = nullptr;
-    Chunk::SeamDirection direction;
+    int    cx = 0, cy = 0, cz = 0;
+    Chunk::SeamDirection direction = Chunk::SEAM_POS_X;
+    int      lodLevel = 0;
+    uint64_t key = 0;
     std::vector<Vertex> verts;
     std::vector<uint32_t> inds;
+    uint32_t opaqueIndexCount = 0;
+};
+
+// Input for one seam job: a chunk's stale faces with both boundary layers
+struct SeamBuildJob
+{
+    struct Face
+    {
+        Chunk::SeamDirection direction = Chunk::SEAM_POS_X;
+        uint64_t         key = 0;
+        int              neighborLOD = 0;
+        size_t           vertexEstimate = 0; // the seam mesh it replaces
+        std::vector<int> layer;
+        std::vector<int> neighborLayer; // empty => no neighbor (air)
+    };
+
+    int cx = 0, cy = 0, cz = 0;
+    int lodLevel = 0;
+    std::vector<Face> faces;
 };
 
 // Global queues for results
@@ -40,29 +76,18 @@ static std::vector<LODMeshBuildResult> s_pendingLODResults;
 static std::mutex s_resultMutexSeam;
 static std::vector<SeamBuildResult> s_pendingSeamResults;
 
-// Marks neighbors dirty so we don’t see gaps at chunk boundaries
-static void markNeighborsDirty(ChunkManager& manager, int cx, int cy, int cz)
+// Everything a seam mesh depends on, folded into one key (splitmix64 steps)
+static uint64_t seamKey(int lod, uint32_t version, int neighborLOD, uint32_t neighborVersion,
+    MipReduction mode)
 {
-    static const int offsets[6][3] = {
-        {1,0,0}, {-1,0,0},
-        {0,1,0}, {0,-1,0},
-        {0,0,1}, {0,0,-1}
+    auto mix = [](uint64_t x) {
+        x += 0x9E3779B97F4A7C15ull;
+        x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+        x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+        return x ^ (x >> 31);
     };
-    for (auto& off : offsets)
-    {
-        int nx = cx + off[0];
-        int ny = cy + off[1];
-        int nz = cz + off[2];
-        if (manager.hasChunk(nx, ny, nz))
-        {
-            Chunk* nChunk = manager.getChunk(nx, ny, nz);
-            if (nChunk) {
-                nChunk->markAllLODsDirty();
-                // Also mark all seams dirty if you want
-                // nChunk->markAllSeamsDirty();
-            }
-        }
-    }
+    uint64_t h = mix(((uint64_t)version << 32) | neighborVersion);
+    return mix(h ^ (uint64_t)((lod + 1) | ((neighborLOD + 1) << 8) | ((int)mode << 16)));
 }
 
 // ------------------------------------------------
@@ -70,21 +95,31 @@ static void markNeighborsDirty(ChunkManager& manager, int cx, int cy, int cz)
 // ------------------------------------------------
 double VoxelWorld::getAvgMeshTime()
 {
-    if (s_meshCount == 0) return 0.0;
-    return s_totalMeshTime / s_meshCount;
+    int count = s_meshCount.load(std::memory_order_relaxed);
+    if (count == 0) return 0.0;
+    return (s_totalMeshTimeNs.load(std::memory_order_relaxed) / 1.0e9) / count;
+}
+
+int VoxelWorld::getMeshCount()
+{
+    return s_meshCount.load(std::memory_order_relaxed);
 }
 
 // ------------------------------------------------
 // Constructor / Destructor
 // ------------------------------------------------
-VoxelWorld::VoxelWorld(VulkanContext* context)
-    : m_context(context)
+VoxelWorld::VoxelWorld(MeshSink* meshSink)
+    : m_meshSink(meshSink)
+    , m_mesher(VoxelTypeRegistry::get().getProperties())
+    , m_raycaster(m_chunkManager)
+    , m_superChunks(meshSink, m_residency)
 {
+    m_mesher.setBuildIndices(!m_meshSink->usesSharedQuadIndices());
 }
 
 VoxelWorld::~VoxelWorld()
 {
-    // Destroy GPU buffers for all chunks
+    // Hand every chunk's meshes back to the sink
     auto& allChunks = m_chunkManager.getAllChunks();
     for (auto& kv : allChunks) {
         Chunk* c = kv.second.get();
@@ -107,7 +142,7 @@ VoxelWorld::~VoxelWorld()
 // ------------------------------------------------
 void VoxelWorld::initWorld()
 {
-    Logger::Info("initWorld() => Generating initial region at (0,0).");
+    LOG_INFO("initWorld() => Generating initial region at (0,0).");
     for (int cx = -VIEW_DISTANCE; cx <= VIEW_DISTANCE; ++cx)
     {
         for (int cz = -VIEW_DISTANCE; cz <= VIEW_DISTANCE; ++cz)
@@ -119,10 +154,6 @@ void VoxelWorld::initWorld()
             g_threadPool.enqueueTask([this, cx, cy, cz, newChunk]()
                 {
                     m_terrainGenerator.generateChunk(*newChunk, cx, cy, cz);
-                    newChunk->markAllLODsDirty();
-
-                    std::lock_guard<std::mutex> lock(m_neighborMutex);
-                    m_pendingNeighborDirty.emplace_back(cx, cy, cz);
                 });
         }
     }
@@ -131,41 +162,39 @@ void VoxelWorld::initWorld()
 // ------------------------------------------------
 // updateChunksAroundPlayer
 //  Each frame, spawn new chunks near the player,
-//  remove far ones, handle neighbors, etc.
+//  remove far ones, mesh, stitch, etc.
 // ------------------------------------------------
-void VoxelWorld::updateChunksAroundPlayer(float playerPosX, float playerPosZ)
+void VoxelWorld::updateChunksAroundPlayer(const glm::vec3& playerPos)
 {
-    int centerChunkX = (int)std::floor(playerPosX / (float)Chunk::SIZE_X);
-    int centerChunkZ = (int)std::floor(playerPosZ / (float)Chunk::SIZE_Z);
+    PROFILE_ZONE("Stream Chunks");
+    int centerChunkX = (int)std::floor(playerPos.x / (float)Chunk::SIZE_X);
+    int centerChunkZ = (int)std::floor(playerPos.z / (float)Chunk::SIZE_Z);
 
     // 1) Create missing chunks
-    for (int cx = centerChunkX - VIEW_DISTANCE; cx <= centerChunkX + VIEW_DISTANCE; cx++)
     {
-        for (int cz = centerChunkZ - VIEW_DISTANCE; cz <= centerChunkZ + VIEW_DISTANCE; cz++)
+        PROFILE_ZONE("Create Chunks");
+        for (int cx = centerChunkX - VIEW_DISTANCE; cx <= centerChunkX + VIEW_DISTANCE; cx++)
         {
-            int cy = 0;
-            if (!m_chunkManager.hasChunk(cx, cy, cz))
+            for (int cz = centerChunkZ - VIEW_DISTANCE; cz <= centerChunkZ + VIEW_DISTANCE; cz++)
             {
-                Logger::Info("Needs chunk at ("
-                    + std::to_string(cx) + ","
-                    + std::to_string(cy) + ","
-                    + std::to_string(cz) + ")");
-                Chunk* newChunk = m_chunkManager.createChunk(cx, cy, cz);
-
-                g_threadPool.enqueueTask([this, cx, cy, cz, newChunk]()
-                    {
-                        m_terrainGenerator.generateChunk(*newChunk, cx, cy, cz);
-                        newChunk->markAllLODsDirty();
-
-                        std::lock_guard<std::mutex> lock(m_neighborMutex);
-                        m_pendingNeighborDirty.emplace_back(cx, cy, cz);
-                    });
+                int cy = 0;
+                if (!m_chunkManager.hasChunk(cx, cy, cz))
+                {
+                    LOG_DEBUG("Needs chunk at ({},{},{})", cx, cy, cz);
+                    Chunk* newChunk = m_chunkManager.createChunk(cx, cy, cz);
+
+                    g_threadPool.enqueueTask([this, cx, cy, cz, newChunk]()
+                        {
+                            m_terrainGenerator.generateChunk(*newChunk, cx, cy, cz);
+                        });
+                }
             }
         }
     }
 
     // 2) Unload out-of-range
     {
+        PROFILE_ZONE("Unload Chunks");
         std::vector<ChunkCoord> toRemove;
         const auto& allChunks = m_chunkManager.getAllChunks();
         for (auto& kv : allChunks) {
@@ -180,8 +209,9 @@ void VoxelWorld::updateChunksAroundPlayer(float playerPosX, float playerPosZ)
 
         for (auto& rc : toRemove) {
             Chunk* oldC = m_chunkManager.getChunk(rc.x, rc.y, rc.z);
-            if (oldC) {
-                vkDeviceWaitIdle(m_context->getDevice());
+            // A mesh job still holds this chunk; unload once its result is in
+            if (oldC && !oldC->isUploading()) {
+                // The sink defers the actual release until frames in flight are done
                 for (int L = 0; L < LOD_COUNT; L++) {
                     destroyChunkLOD(*oldC, L);
                 }
@@ -193,205 +223,347 @@ void VoxelWorld::updateChunksAroundPlayer(float playerPosX, float playerPosZ)
         }
     }
 
-    // 3) Mark neighbors dirty if needed
-    {
-        std::lock_guard<std::mutex> lock(m_neighborMutex);
-        for (auto& cCoord : m_pendingNeighborDirty) {
-            markNeighborsDirty(m_chunkManager, cCoord.x, cCoord.y, cCoord.z);
+    // 3) Schedule meshing, then the seams for the new target LODs.
+    //    A newly generated chunk only changes its neighbors' seams on the
+    //    shared faces (their keys include its version), never their meshes.
+    scheduleMeshingForDirtyChunks(playerPos);
+    scheduleSeamBuilds();
+
+    // 4) Poll results
+    pollMeshBuildResults();
+
+    // 5) Far-field superchunks (groups beyond the coarsest LOD's switch distance)
+    m_superChunks.update(m_chunkManager, m_mesher, playerPos,
+        m_lodPolicy.getSwitchDistance(LOD_COUNT - 1), m_lodPolicy.getHysteresis());
+
+    // 6) Drop least recently drawn meshes if over the GPU memory budget
+    evictMeshesOverBudget();
+
+    // 7) Let the sink submit this update's uploads
+    m_meshSink->endFrame();
+    m_residency.beginFrame();
+}
+
+// ------------------------------------------------
+// setMipReduction
+// ------------------------------------------------
+void VoxelWorld::setMipReduction(MipReduction mode)
+{
+    if (mode == m_mesher.getMipReduction()) {
+        return;
+    }
+    m_mesher.setMipReduction(mode);
+
+    for (auto& kv : m_chunkManager.getAllChunks()) {
+        for (int L = 1; L < LOD_COUNT; L++) {
+            kv.second->markLODDirty(L);
         }
-        m_pendingNeighborDirty.clear();
     }
+}
+
+// ------------------------------------------------
+// evictMeshesOverBudget
+//  Evicted LODs are marked dirty again so they are
+//  rebuilt if the chunk switches back to them.
+// ------------------------------------------------
+void VoxelWorld::evictMeshesOverBudget()
+{
+    PROFILE_ZONE("Evict Meshes");
+    m_residency.collectEvictions(m_chunkManager, m_evictions);
+    for (const MeshResidency::Eviction& e : m_evictions)
+    {
+        destroyChunkLOD(*e.chunk, e.lodLevel);
+        e.chunk->markLODDirty(e.lodLevel);
+    }
+    if (!m_evictions.empty()) {
+        LOG_DEBUG("Evicted {} LOD meshes, {} bytes resident", m_evictions.size(),
+            m_residency.getTotalResidentBytes());
+    }
+}
 
-    // 4) Schedule meshing
-    scheduleMeshingForDirtyChunks(centerChunkX, centerChunkZ);
+// ------------------------------------------------
+// raycast
+//  DDA query against the loaded chunks (see VoxelRaycast.h)
+// ------------------------------------------------
+RaycastHit VoxelWorld::raycast(const glm::vec3& origin, const glm::vec3& dir, float maxDistance)
+{
+    return m_raycaster.raycast(origin, dir, maxDistance);
+}
 
-    // 5) Poll results
-    pollMeshBuildResults();
+// ------------------------------------------------
+// setVoxel
+// ------------------------------------------------
+static int floorDiv(int a, int b)
+{
+    return (a >= 0) ? a / b : -((-a + b - 1) / b);
+}
+
+bool VoxelWorld::setVoxel(int x, int y, int z, int voxelID)
+{
+    int cx = floorDiv(x, Chunk::SIZE_X);
+    int cy = floorDiv(y, Chunk::SIZE_Y);
+    int cz = floorDiv(z, Chunk::SIZE_Z);
+    Chunk* chunk = m_chunkManager.getChunk(cx, cy, cz);
+    if (!chunk || chunk->getVersion() == 0) {
+        return false; // not loaded / still generating
+    }
+    chunk->setBlock(x - cx * Chunk::SIZE_X, y - cy * Chunk::SIZE_Y, z - cz * Chunk::SIZE_Z, voxelID);
+    return true;
 }
 
 // ------------------------------------------------
 // scheduleMeshingForDirtyChunks
-// We adopt "max LOD difference = 1" across neighbors.
-// We'll pick an LOD, but ensure we never have e.g. LOD0 next to LOD2.
+//  LODBalancer sets every target ("max LOD difference = 1"
+//  across neighbors); chunks it moved are queued first,
+//  then whatever else is dirty (generation, edits).
 // ------------------------------------------------
-void VoxelWorld::scheduleMeshingForDirtyChunks(int centerChunkX, int centerChunkZ)
+void VoxelWorld::scheduleMeshingForDirtyChunks(const glm::vec3& viewerPos)
 {
-    const auto& allChunks = m_chunkManager.getAllChunks();
-    for (auto& kv : allChunks)
+    PROFILE_ZONE("Schedule Meshing");
+    m_lodBalancer.update(m_chunkManager, m_lodPolicy, viewerPos);
+    m_lodChanges = (int)m_lodBalancer.getChangedChunks().size();
+
+    for (Chunk* chunk : m_lodBalancer.getChangedChunks()) {
+        scheduleChunkBuild(chunk);
+    }
+    for (auto& kv : m_chunkManager.getAllChunks()) {
+        if (kv.second) scheduleChunkBuild(kv.second.get());
+    }
+}
+
+// ------------------------------------------------
+// scheduleChunkBuild
+// ------------------------------------------------
+void VoxelWorld::scheduleChunkBuild(Chunk* chunk)
+{
+    // Not generated yet: a job now would mesh (and cache) all air
+    if (chunk->getVersion() == 0) return;
+
+    ChunkCoord coord(chunk->worldX(), chunk->worldY(), chunk->worldZ());
+
+    // Edits: patch the touched LOD0 slices into the resident mesh, or
+    // fall back to a full LOD0 rebuild when there is none to patch
+    if (chunk->hasDirtySlices() && !chunk->isUploading())
     {
-        const ChunkCoord& coord = kv.first;
-        Chunk* chunk = kv.second.get();
-        if (!chunk) continue;
+        if (scheduleSlicePatch(chunk)) return;
+        chunk->markLODDirty(0);
+        chunk->clearDirtySlices();
+    }
 
-        // Skip if uploading 
-        if (chunk->isUploading()) {
-            continue;
-        }
+    int chosenLOD = chunk->getTargetLOD();
+    if (chosenLOD < 0) return;
 
-        // Check if *any* LOD is dirty
-        bool anyDirty = false;
-        int firstDirtyLOD = -1;
-        for (int L = 0; L < LOD_COUNT; L++) {
-            if (chunk->isLODDirty(L)) {
-                anyDirty = true;
-                if (firstDirtyLOD < 0) {
-                    firstDirtyLOD = L;
-                }
-            }
-        }
-        if (!anyDirty) {
-            continue;
-        }
+    // Build the target first, then the coarsest LOD so a LOD switch
+    // always has a resident mesh to fall back on (see MeshResidency).
+    // Other LODs stay dirty until the chunk actually moves to them.
+    int buildLOD = chosenLOD;
+    if (!chunk->isLODDirty(buildLOD)) {
+        buildLOD = MeshResidency::COARSEST_LOD;
+    }
+
+    // Only one build in flight per chunk
+    if (chunk->isUploading() || !chunk->isLODDirty(buildLOD)) {
+        return;
+    }
+
+    // Mark chunk as uploading 
+    chunk->setIsUploading(true);
 
-        // distance^2 
-        int dx = coord.x - centerChunkX;
-        int dz = coord.z - centerChunkZ;
-        int distSq = dx * dx + dz * dz;
-
-        // Decide LOD normally
-        int chosenLOD = 0;
-        if (distSq > 25) chosenLOD = 1;
-        if (distSq > 100) chosenLOD = 2;
-
-        // But ensure no neighbor is 2 levels away
-        // Example: if we pick chosenLOD=2 but a neighbor is LOD0, that's a problem.
-        // We'll check neighbors. 
-        // (This is a naive approach. For full correctness, we might need an iterative pass.)
-        static const int offsets[6][3] = {
-            {1,0,0}, {-1,0,0},
-            {0,1,0}, {0,-1,0},
-            {0,0,1}, {0,0,-1}
-        };
-
-        for (auto& off : offsets)
+    // Output buffers come from the pool, reserved for the mesh being replaced
+    const size_t vertexEstimate = chunk->getLODData(buildLOD).vertexCount;
+    const size_t indexEstimate = m_mesher.getBuildIndices() ? vertexEstimate / 4 * 6 : 0;
+
+    // Submit a meshing job
+    g_threadPool.enqueueTask([this, chunk, coord, buildLOD, vertexEstimate, indexEstimate]()
         {
-            int nx = coord.x + off[0];
-            int ny = coord.y + off[1];
-            int nz = coord.z + off[2];
-            if (!m_chunkManager.hasChunk(nx, ny, nz))
-                continue;
-
-            Chunk* neighbor = m_chunkManager.getChunk(nx, ny, nz);
-            if (!neighbor) continue;
-
-            // Check each neighbor's highest valid LOD 
-            // (or some approach to see what neighbor is building)
-            // We'll do a quick approach:
-            for (int L = 0; L < LOD_COUNT; L++)
+            PROFILE_ZONE("Mesh Job");
+            auto t0 = std::chrono::high_resolution_clock::now();
+
+            LODMeshBuildResult res;
+            bool hasResult = false;
+
+            if (chunk->isLODDirty(buildLOD))
             {
-                // If neighbor has that LOD data valid => we see what L is
-                // But if they're dirty, this is in flux. Real solutions do more robust logic.
-                const auto& nLOD = neighbor->getLODData(L);
-                if (nLOD.valid)
+                chunk->clearLODDirty(buildLOD);
+
+                // Build geometry (LOD0 segmented, so edits can patch it),
+                // unless a chunk with the same voxels already did
+                m_meshBuffers.acquire(vertexEstimate, indexEstimate, res.verts, res.inds);
+                MeshSliceLayout* slices = (buildLOD == 0) ? &res.slices : nullptr;
+                const uint32_t version = chunk->getVersion();
+                const uint64_t key = MeshCache::chunkKey(*chunk, buildLOD, m_mesher.getMipReduction(),
+                    slices != nullptr, m_mesher.getBuildIndices());
+                const int offX = coord.x * Chunk::SIZE_X;
+                const int offY = coord.y * Chunk::SIZE_Y;
+                const int offZ = coord.z * Chunk::SIZE_Z;
+                if (!m_meshCache.lookup(key, offX, offY, offZ, res.verts, res.inds,
+                    res.opaqueIndexCount, slices, res.faceRanges))
                 {
-                    // If difference > 1 => clamp chosenLOD
-                    int diff = std::abs(L - chosenLOD);
-                    if (diff > 1)
-                    {
-                        // E.g. if L=0, chosenLOD=2 => that's 2 levels difference.
-                        // We can clamp to 1 for now.
-                        chosenLOD = (chosenLOD > L) ? (L + 1) : (L - 1);
+                    m_mesher.buildLODMesh(*chunk, coord.x, coord.y, coord.z, buildLOD,
+                        res.verts, res.inds, nullptr,
+                        slices, &res.opaqueIndexCount, &res.faceRanges);
+                    // An edit between hashing and meshing: the mesh may not
+                    // match the key (the chunk is dirty again anyway)
+                    if (chunk->getVersion() == version) {
+                        m_meshCache.store(key, offX, offY, offZ, res.verts, res.inds,
+                            res.opaqueIndexCount, slices, res.faceRanges);
                     }
                 }
+                ChunkMesher::buildMeshlets(res.verts, res.opaqueIndexCount, res.faceRanges, res.meshlets);
+
+                res.chunkPtr = chunk;
+                res.cx = coord.x;
+                res.cy = coord.y;
+                res.cz = coord.z;
+                res.lodLevel = buildLOD;
+                // Cave culling: which faces see each other through air
+                {
+                    PROFILE_ZONE("Face Connectivity");
+                    res.faceConnectivity =
+                        ChunkVisibility::computeFaceConnectivity(chunk->getBlocks());
+                }
+                hasResult = true;
             }
-        }
 
-        // Mark chunk as uploading 
-        chunk->setIsUploading(true);
+            auto t1 = std::chrono::high_resolution_clock::now();
+            s_totalMeshTimeNs.fetch_add(
+                (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count(),
+                std::memory_order_relaxed);
+            s_meshCount.fetch_add(1, std::memory_order_relaxed);
 
-        // Clear other LOD dirty except chosen
-        for (int L = 0; L < LOD_COUNT; L++) {
-            if (L != chosenLOD) {
-                chunk->clearLODDirty(L);
+            // Transfer the result to the global queue
+            if (hasResult) {
+                std::lock_guard<std::mutex> guard(s_resultMutexLOD);
+                s_pendingLODResults.push_back(std::move(res));
             }
-        }
+        });
+}
 
-        int offsetX = coord.x * Chunk::SIZE_X;
-        int offsetY = coord.y * Chunk::SIZE_Y;
-        int offsetZ = coord.z * Chunk::SIZE_Z;
+// ------------------------------------------------
+// scheduleSlicePatch
+//  Re-meshes only the LOD0 slices an edit touched
+//  (Chunk::getDirtySlices); applySlicePatch writes them
+//  into the resident mesh.
+// ------------------------------------------------
+bool VoxelWorld::scheduleSlicePatch(Chunk* chunk)
+{
+    const ChunkLODData& lod0 = chunk->getLODData(0);
+    if (chunk->isLODDirty(0) || !lod0.mesh || lod0.slices.empty()) {
+        return false;
+    }
 
-        // Submit a meshing job
-        g_threadPool.enqueueTask([this, chunk, coord, chosenLOD, offsetX, offsetY, offsetZ]()
+    std::vector<int> slices;
+    for (int face = 0; face < 6; face++)
+    {
+        uint16_t mask = chunk->getDirtySlices(face);
+        for (int layer = 0; layer < Chunk::SIZE_X; layer++) {
+            if (mask & (1u << layer)) slices.push_back(face * Chunk::SIZE_X + layer);
+        }
+    }
+    chunk->clearDirtySlices();
+    chunk->setIsUploading(true);
+
+    ChunkCoord coord(chunk->worldX(), chunk->worldY(), chunk->worldZ());
+    g_threadPool.enqueueTask([this, chunk, coord, slices = std::move(slices)]()
+        {
+            PROFILE_ZONE("Slice Patch Job");
+            LODMeshBuildResult res;
+            res.chunkPtr = chunk;
+            res.cx = coord.x;
+            res.cy = coord.y;
+            res.cz = coord.z;
+            res.lodLevel = 0;
+            res.isSlicePatch = true;
+            res.sliceIndices = slices;
+            res.sliceVerts[0].resize(slices.size());
+            res.sliceVerts[1].resize(slices.size());
+            for (size_t i = 0; i < slices.size(); i++)
             {
-                auto t0 = std::chrono::high_resolution_clock::now();
+                m_mesher.buildSliceQuads(*chunk,
+                    slices[i] / Chunk::SIZE_X, slices[i] % Chunk::SIZE_X,
+                    coord.x * Chunk::SIZE_X, coord.y * Chunk::SIZE_Y, coord.z * Chunk::SIZE_Z,
+                    res.sliceVerts[0][i], res.sliceVerts[1][i]);
+            }
+            res.faceConnectivity = ChunkVisibility::computeFaceConnectivity(chunk->getBlocks());
 
-                std::vector<LODMeshBuildResult> localResults;
+            std::lock_guard<std::mutex> guard(s_resultMutexLOD);
+            s_pendingLODResults.push_back(std::move(res));
+        });
+    return true;
+}
 
-                if (chunk->isLODDirty(chosenLOD))
-                {
-                    chunk->clearLODDirty(chosenLOD);
-
-                    // Build geometry
-                    std::vector<Vertex> verts;
-                    std::vector<uint32_t> inds;
-
-                    if (chosenLOD == 0)
-                    {
-                        m_mesher.generateMeshGreedy(
-                            *chunk,
-                            coord.x, coord.y, coord.z,
-                            verts, inds,
-                            offsetX, offsetY, offsetZ,
-                            m_chunkManager
-                        );
-                    }
-                    else
-                    {
-                        const std::vector<int>& fullData = chunk->getBlocks();
-                        std::vector<int> dsData = downsampleVoxelData(
-                            fullData,
-                            Chunk::SIZE_X,
-                            Chunk::SIZE_Y,
-                            Chunk::SIZE_Z,
-                            chosenLOD
-                        );
-
-                        int dsX = Chunk::SIZE_X >> chosenLOD;
-                        int dsY = Chunk::SIZE_Y >> chosenLOD;
-                        int dsZ = Chunk::SIZE_Z >> chosenLOD;
-
-                        m_mesher.generateMeshFromArray(
-                            dsData, dsX, dsY, dsZ,
-                            offsetX, offsetY, offsetZ,
-                            verts, inds,
-                            true /* useGreedy */
-                        );
-                    }
+// ------------------------------------------------
+// applySlicePatch
+//  A slice that fits its run is rewritten in place (padded
+//  with degenerate quads); one that outgrew it moves to its
+//  pass's spare slots and its old run is blanked. Opaque and
+//  translucent quads are patched separately. All or nothing.
+// ------------------------------------------------
+bool VoxelWorld::applySlicePatch(Chunk& chunk, LODMeshBuildResult& res)
+{
+    ChunkLODData& lod0 = chunk.getLODData(0);
+    if (!lod0.mesh || lod0.slices.empty()) {
+        return false; // evicted meanwhile
+    }
 
-                    LODMeshBuildResult res;
-                    res.chunkPtr = chunk;
-                    res.cx = coord.x;
-                    res.cy = coord.y;
-                    res.cz = coord.z;
-                    res.lodLevel = chosenLOD;
-                    res.verts = std::move(verts);
-                    res.inds = std::move(inds);
-                    localResults.push_back(std::move(res));
+    const size_t passSlices = (size_t)6 * Chunk::SIZE_X;
+    MeshSliceLayout layout = lod0.slices;
+    std::vector<MeshPatch> patches;
+    patches.reserve(res.sliceIndices.size() * 2);
+    for (int pass = 0; pass < MeshSliceLayout::PASS_COUNT; pass++)
+    {
+        for (size_t i = 0; i < res.sliceIndices.size(); i++)
+        {
+            MeshSlice& slice = layout.slices[pass * passSlices + (size_t)res.sliceIndices[i]];
+            std::vector<Vertex>& verts = res.sliceVerts[pass][i];
+            int quads = (int)(verts.size() / 4);
+            if (quads > slice.capacity)
+            {
+                uint16_t capacity = ChunkMesher::sliceCapacity(quads);
+                if (layout.freeSlot[pass] + capacity > layout.passEnd[pass]) {
+                    return false; // out of spare slots
                 }
-
-                auto t1 = std::chrono::high_resolution_clock::now();
-                double elapsedSec = std::chrono::duration<double>(t1 - t0).count();
-                s_totalMeshTime += elapsedSec;
-                s_meshCount++;
-
-                // Transfer results to global queue
+                if (slice.capacity > 0)
                 {
-                    std::lock_guard<std::mutex> guard(s_resultMutexLOD);
-                    for (auto& r : localResults) {
-                        s_pendingLODResults.push_back(std::move(r));
-                    }
+                    MeshPatch hole;
+                    hole.firstVertex = slice.first * 4;
+                    ChunkMesher::padQuads(hole.verts, slice.capacity);
+                    patches.push_back(std::move(hole));
                 }
-            });
+                slice.first = layout.freeSlot[pass];
+                slice.capacity = capacity;
+                layout.freeSlot[pass] += capacity;
+            }
+            if (slice.capacity == 0) continue;
+
+            MeshPatch patch;
+            patch.firstVertex = slice.first * 4;
+            patch.verts = std::move(verts);
+            ChunkMesher::padQuads(patch.verts, slice.capacity);
+            patches.push_back(std::move(patch));
+            slice.used = (uint16_t)quads;
+        }
     }
+
+    if (!m_meshSink->patchMesh(lod0.mesh, patches)) {
+        return false;
+    }
+    for (const MeshPatch& patch : patches) {
+        ChunkMesher::growMeshlets(lod0.meshlets, patch.firstVertex, patch.verts);
+    }
+    lod0.slices = std::move(layout);
+    m_slicePatches += (uint64_t)res.sliceIndices.size();
+    return true;
 }
 
 // ------------------------------------------------
 // pollMeshBuildResults
-//  Copy finished geometry from workers -> GPU
-//  Then handle seam building if needed
+//  Copy finished geometry from workers -> GPU,
+//  LOD meshes first, then seams
 // ------------------------------------------------
 void VoxelWorld::pollMeshBuildResults()
 {
+    PROFILE_ZONE("Poll Mesh Results");
     std::vector<LODMeshBuildResult> localCopy;
     {
         std::lock_guard<std::mutex> guard(s_resultMutexLOD);
@@ -405,306 +577,173 @@ void VoxelWorld::pollMeshBuildResults()
     {
         if (!res.chunkPtr) continue;
         Chunk* c = res.chunkPtr;
+        c->setFaceConnectivity(res.faceConnectivity);
+
+        if (res.isSlicePatch)
+        {
+            if (!applySlicePatch(*c, res)) {
+                // No room left (or the sink can't patch): rebuild LOD0 whole
+                c->markLODDirty(0);
+                m_slicePatchFallbacks++;
+            }
+            c->setIsUploading(false);
+            m_chunkManager.refreshBounds(c);
+            continue;
+        }
 
-        if (!res.verts.empty() && !res.inds.empty())
+        if (!res.verts.empty())
         {
-            Logger::Info("Finalizing LOD " + std::to_string(res.lodLevel)
-                + " for chunk(" + std::to_string(res.cx) + ","
-                + std::to_string(res.cy) + ","
-                + std::to_string(res.cz) + ") => "
-                + std::to_string(res.verts.size()) + " verts, "
-                + std::to_string(res.inds.size()) + " inds");
+            LOG_DEBUG("Finalizing LOD {} for chunk({},{},{}) => {} verts, {} inds",
+                res.lodLevel, res.cx, res.cy, res.cz, res.verts.size(), res.inds.size());
 
             destroyChunkLOD(*c, res.lodLevel);
-            uploadLODMeshToChunk(*c, res.lodLevel, res.verts, res.inds);
-            c->getLODData(res.lodLevel).valid = true;
+            uploadLODMeshToChunk(*c, res.lodLevel, res.verts, res.inds, res.opaqueIndexCount);
+            ChunkLODData& lodData = c->getLODData(res.lodLevel);
+            if (lodData.mesh) {
+                lodData.slices = std::move(res.slices);
+                lodData.faceRanges = res.faceRanges;
+                lodData.meshlets = std::move(res.meshlets);
+            }
         }
         else
         {
             destroyChunkLOD(*c, res.lodLevel);
         }
+        m_meshBuffers.release(res.verts, res.inds);
         c->setIsUploading(false);
+        m_chunkManager.refreshBounds(c); // voxels may have changed since the last mesh
     }
 
-    // 2) (Optional) Build seam geometry in a background job
-    // For example, for each chunk that got updated, check neighbors with different LOD,
-    // and if difference == 1, build the seam. 
-    // We'll skip a full example here. You might queue tasks to produce SeamBuildResult.
-
-    // 3) Poll seam results 
-    // (In a real engine, you'd do something similar to the LOD approach.)
+    // 2) Upload seam geometry (see scheduleSeamBuilds)
+    std::vector<SeamBuildResult> seamResults;
     {
         std::lock_guard<std::mutex> guard(s_resultMutexSeam);
-        // If any seam results exist, we upload them:
-        // (Implementation left out for brevity.)
+        seamResults.swap(s_pendingSeamResults);
+    }
+    for (auto& res : seamResults)
+    {
+        Chunk* c = m_chunkManager.getChunk(res.cx, res.cy, res.cz);
+        if (!c) continue; // unloaded meanwhile
+
+        // A chunk re-created at the same spot has no build in flight
+        ChunkSeamData& seam = c->getSeamData(res.direction);
+        if (!seam.building || seam.pendingKey != res.key) continue;
+        seam.building = false;
+
+        destroyChunkSeam(*c, res.direction);
+        if (!res.verts.empty()) {
+            uploadSeamMeshToChunk(*c, res.direction, res.verts, res.inds, res.opaqueIndexCount);
+        }
+        m_meshBuffers.release(res.verts, res.inds);
+        seam.lod = res.lodLevel;
+        seam.builtKey = res.key;
+        seam.built = true;
     }
 }
 
 // ------------------------------------------------
-// buildSeamBetweenChunks
-//  Placeholder for the code that calculates bridging geometry
-//  between chunkA (lodA) and chunkB (lodB) at a given face.
+// scheduleSeamBuilds
+//  Each chunk face has a seam mesh with the border faces
+//  against the neighbor, at the LODs both sides target.
+//  It is rebuilt only when either side's LOD or version
+//  (or the mip reduction) changes. Boundary layers are
+//  copied here, so the jobs never touch a chunk.
 // ------------------------------------------------
-void VoxelWorld::buildSeamBetweenChunks(Chunk& chunkA, int lodA,
-    Chunk& chunkB, int lodB,
-    int faceDirection)
+void VoxelWorld::scheduleSeamBuilds()
 {
-    // ------------------------------------------------------------
-    // 1) We’ll demonstrate faceDirection == +X specifically:
-    //    chunkB is at (chunkA.worldX + 1, chunkA.worldY, chunkA.worldZ).
-    // ------------------------------------------------------------
-    if (faceDirection != /* +X */ 0) // or however you define +X
-    {
-        Logger::Info("buildSeamBetweenChunks() => Only handle +X in this example. Skipping.");
-        return;
-    }
-
-    // If the LOD difference isn’t exactly 1, skip or do nothing
-    // e.g. if |lodA - lodB| != 1, we might not build a seam.
-    if (std::abs(lodA - lodB) != 1)
-    {
-        Logger::Info("buildSeamBetweenChunks() => LOD difference != 1, skipping seam.");
-        return;
-    }
-
-    // Decide which chunk is finer (lower LOD index => higher resolution).
-    // e.g. LOD0 < LOD1 < LOD2
-    Chunk* finerChunk = (lodA < lodB ? &chunkA : &chunkB);
-    Chunk* coarserChunk = (finerChunk == &chunkA ? &chunkB : &chunkA);
+    PROFILE_ZONE("Schedule Seams");
+    m_seamBuilds = 0;
 
-    int finerLOD = (lodA < lodB ? lodA : lodB);
-    int coarserLOD = (finerLOD == lodA ? lodB : lodA);
-
-    // We'll store the new geometry in the chunk that is finer,
-    // on the face that abuts the other chunk.  This is arbitrary;
-    // you could store in either chunk or both.
-    // If chunkA is the finer side, that means chunkA's +X seam data.
-    // If chunkB is the finer side, that means chunkB's -X seam data, etc.
-
-    // In this example, we'll assume chunkA is "the chunk with faceDirection = +X",
-    // so if chunkA is the finer chunk, we store seam in chunkA's SEAM_POS_X.
-    // Otherwise, if chunkB is the finer chunk, store in chunkB's SEAM_NEG_X.
+    static const int offsets[6][3] = {
+        {1,0,0}, {-1,0,0},
+        {0,1,0}, {0,-1,0},
+        {0,0,1}, {0,0,-1}
+    };
+    const MipReduction mode = m_mesher.getMipReduction();
 
-    Chunk::SeamDirection seamDirForFiner;
-    if (finerChunk == &chunkA)
+    for (auto& kv : m_chunkManager.getAllChunks())
     {
-        // chunkA is on the left, chunkB is on the right => chunkA’s seam is +X
-        seamDirForFiner = Chunk::SEAM_POS_X;
-    }
-    else
-    {
-        // chunkB is the finer chunk => chunkB's seam is -X
-        seamDirForFiner = Chunk::SEAM_NEG_X;
-    }
+        if (m_seamBuilds >= MAX_SEAM_JOBS_PER_UPDATE) break;
 
-    // ------------------------------------------------------------
-    // 2) Figure out how many samples (subdivisions) each chunk’s boundary has
-    //    If chunk resolution is 16x16 for LOD0, that means along +X face,
-    //    we have 16 segments in Z direction (since X=16 is the boundary).
-    //
-    //    For LOD1, we'd have half that resolution, so 8 segments, etc.
-    //    In general, #samples = 1 << (4 - lodLevel) if SIZE_X=16. 
-    //    (But let's do it formulaically.)
-    // ------------------------------------------------------------
-    int finerResolution = (Chunk::SIZE_Z >> finerLOD);   // e.g. 16 >> 0 = 16
-    int coarserResolution = (Chunk::SIZE_Z >> coarserLOD); // e.g. 16 >> 1 = 8
-
-    // We’ll gather “surface height” along that boundary from each chunk.
-    // The boundary we’re bridging is the line X=SIZE_X (for chunk with +X face)
-    // or X=0 for chunk with -X face. For chunkB, if it’s coarser, we read from x=0.
-    // If chunkB is the finer chunk, we read from x=16, etc. We'll define a small helper:
-
-    auto getSurfaceHeight = [&](Chunk& c, int lodLevel, int localX, int localZ)->int
+        const ChunkCoord& coord = kv.first;
+        const Chunk* chunk = kv.second.get();
+        int lod = chunk ? chunk->getTargetLOD() : -1;
+        uint32_t version = chunk ? chunk->getVersion() : 0;
+        if (lod < 0 || version == 0) continue; // not generated / no LOD yet
+
+        SeamBuildJob job;
+        job.cx = coord.x;
+        job.cy = coord.y;
+        job.cz = coord.z;
+        job.lodLevel = lod;
+
+        for (int face = 0; face < 6; face++)
         {
-            // This function finds the topmost block in that column, naive approach:
-            // localX, localZ range depends on the chunk’s effective size at that LOD.
-            // Typically the chunk has full data, so we can do a quick "downsample coordinate"
-            // or read c.getBlock(...) if we want the actual block data.
-
-            // For simplicity, we’ll do a direct scale:
-            int factor = lodLevel; // e.g. LOD=1 => factor=1 => half
-            // Or better: factor = (1 << lodLevel)
-
-            // Convert localX in [0..(SIZE_Z>>lodLevel)] to the full chunk coordinate
-            int fullZ = localZ << lodLevel;
-            // We'll fix the X boundary: if it's the +X face, x=15 for LOD0, x=7 for LOD1, etc.
-            // Actually let's do if we read the chunk’s entire block array at the real resolution, 
-            // the boundary is x=Chunk::SIZE_X - 1 for +X.
-            int boundaryX = (faceDirection == 0 /* +X */)
-                ? (Chunk::SIZE_X - 1)
-                : 0;
-            if (c.worldX() > coarserChunk->worldX()) {
-                // c is on the right => x=0 if we are reading chunk c for the -X face
+            Chunk::SeamDirection dir = static_cast<Chunk::SeamDirection>(face);
+            ChunkSeamData& seam = kv.second->getSeamData(dir);
+            if (seam.building) continue; // one build per face in flight
+
+            // Missing or not yet generated neighbors count as air
+            const Chunk* neighbor = m_chunkManager.getChunk(
+                coord.x + offsets[face][0], coord.y + offsets[face][1], coord.z + offsets[face][2]);
+            uint32_t neighborVersion = neighbor ? neighbor->getVersion() : 0;
+            int neighborLOD = -1;
+            if (neighborVersion != 0) {
+                neighborLOD = (neighbor->getTargetLOD() >= 0) ? neighbor->getTargetLOD() : lod;
             }
 
-            // If we are generating for chunk c's +X boundary at LOD=0 => boundaryX=15
-            // at LOD=1 => boundaryX=7 (?). This can get complicated quickly, so
-            // let's keep it super naive: just always read x=SIZE_X-1 for +X face 
-            // or x=0 for -X face in the chunk’s real block array.
-
-            int highestY = -1;
-            for (int y = Chunk::SIZE_Y - 1; y >= 0; y--)
-            {
-                int blockID = c.getBlock(boundaryX, y, fullZ);
-                if (blockID > 0) // found a non-air block
-                {
-                    highestY = y;
-                    break;
-                }
+            uint64_t key = seamKey(lod, version, neighborLOD, neighborVersion, mode);
+            if (seam.built && seam.builtKey == key) continue;
+
+            SeamBuildJob::Face f;
+            f.direction = dir;
+            f.key = key;
+            f.neighborLOD = neighborLOD;
+            f.vertexEstimate = seam.vertexCount;
+            chunk->copyBoundaryLayer(face, lod, mode, m_mesher.getProperties(), f.layer);
+            if (neighborVersion != 0) {
+                // Opposite face: +X <-> -X etc.
+                neighbor->copyBoundaryLayer(face ^ 1, neighborLOD, mode, m_mesher.getProperties(),
+                    f.neighborLayer);
             }
-            return highestY < 0 ? 0 : highestY;
-        };
-
-    // Gather the boundary heights from the finer chunk in an array
-    // e.g. size = finerResolution + 1 for the corners
-    std::vector<int> finerHeights(finerResolution + 1, 0);
-
-    // We'll do the same for coarser chunk => coarserResolution + 1
-    std::vector<int> coarserHeights(coarserResolution + 1, 0);
-
-    for (int i = 0; i <= finerResolution; i++)
-    {
-        finerHeights[i] = getSurfaceHeight(*finerChunk, finerLOD, /*localX*/ 0, /*localZ*/ i);
-    }
-    for (int i = 0; i <= coarserResolution; i++)
-    {
-        coarserHeights[i] = getSurfaceHeight(*coarserChunk, coarserLOD, /*localX*/ 0, /*localZ*/ i);
-    }
+            job.faces.push_back(std::move(f));
 
-    // ------------------------------------------------------------
-    // 3) Build bridging geometry
-    //    For each segment in the coarser boundary, we match it to
-    //    two segments in the finer boundary. (Because it’s half resolution.)
-    // ------------------------------------------------------------
-    std::vector<Vertex> seamVerts;
-    std::vector<uint32_t> seamIndices;
-
-    // We'll define the base world offset for the "finer" chunk’s boundary in X.
-    int chunkSizeX = Chunk::SIZE_X;
-    int chunkSizeZ = Chunk::SIZE_Z;
-
-    // We'll assume chunkX, chunkZ to place these points in world space.
-    // E.g. if chunkA is at (cx, cz) => offsetX = cx*16, etc.
-    // Actually we can do a quick approach using the chunk’s world coords:
-    float finerWorldX = float(finerChunk->worldX() * Chunk::SIZE_X);
-    float finerWorldZ = float(finerChunk->worldZ() * Chunk::SIZE_Z);
-
-    float coarserWorldX = float(coarserChunk->worldX() * Chunk::SIZE_X);
-    float coarserWorldZ = float(coarserChunk->worldZ() * Chunk::SIZE_Z);
-
-    // If faceDirection = +X => the boundary is at x = chunkSizeX for chunk on left,
-    // or x=0 for chunk on the right. We'll define that the bridging is in the Z direction.
-
-    // We'll color them differently just to see
-    float rf = 0.8f, gf = 0.2f, bf = 0.8f; // color for "finer"
-    float rc = 0.2f, gc = 0.8f, bc = 0.2f; // color for "coarser"
-
-    // coarserResolution * 2 => how many segments the finer boundary has in that region
-    // For each coarser i in [0..coarserResolution-1], 
-    // the corresponding finer i2 in [0..(2*coarserResolution)-1].
-    // We'll produce a small quads bridging the two lines of heights.
-
-    for (int i = 0; i < coarserResolution; i++)
-    {
-        // coarser segment is [i.. i+1]
-        int h0c = coarserHeights[i];
-        int h1c = coarserHeights[i + 1];
+            seam.building = true;
+            seam.pendingKey = key;
+        }
 
-        // The corresponding finer range is [2*i.. 2*i+2]
-        int iF0 = 2 * i;
-        int iF1 = 2 * i + 2;
+        if (job.faces.empty()) continue;
+        m_seamBuilds++;
 
-        if (iF1 > finerResolution) {
-            // just clamp 
-            iF1 = finerResolution;
-        }
+        g_threadPool.enqueueTask([this, job = std::move(job)]()
+            {
+                PROFILE_ZONE("Seam Job");
+                std::vector<SeamBuildResult> localResults;
+                localResults.reserve(job.faces.size());
 
-        int h0f = (iF0 <= finerResolution) ? finerHeights[iF0] : finerHeights.back();
-        int h1f = (iF1 <= finerResolution) ? finerHeights[iF1] : finerHeights.back();
-
-        // Now we have 2 vertical “columns” => coarser at z0..z1, finer at z0..z2
-        // We'll define the actual z positions in world space:
-        float z0c = coarserWorldZ + float(i) * (float(Chunk::SIZE_Z) / coarserResolution);
-        float z1c = coarserWorldZ + float(i + 1) * (float(Chunk::SIZE_Z) / coarserResolution);
-        float z0f = finerWorldZ + float(iF0) * (float(Chunk::SIZE_Z) / finerResolution);
-        float z1f = finerWorldZ + float(iF1) * (float(Chunk::SIZE_Z) / finerResolution);
-
-        // The x positions for the seam if the finer chunk is to the left => x=some boundary
-        // We'll do xF = (finer chunk's worldX + chunkSizeX - 0.1f) 
-        // and xC = (coarser chunk's worldX + 0.1f) for a small bridging. 
-        // Or just do the same x if you want no gap.
-
-        float xF = float(finerChunk->worldX() * Chunk::SIZE_X + Chunk::SIZE_X);
-        float xC = float(coarserChunk->worldX() * Chunk::SIZE_X);
-
-        // We'll build two quads bridging these columns:
-        // e.g. the geometry in the XZ plane, y=height. 
-        // It's basically a trapezoid between (xF, h0f, z0f) and (xC, h0c, z0c).
-
-        // For simplicity, let's build a single big quad bridging
-        // coarser (i.. i+1) to finer (2i.. 2i+2).
-        // We'll do it in two triangles.
-
-        // We'll define 4 corners:
-        //  corner0 => coarser i => (xC, h0c, z0c)
-        //  corner1 => coarser i+1 => (xC, h1c, z1c)
-        //  corner2 => finer iF0 => (xF, h0f, z0f)
-        //  corner3 => finer iF1 => (xF, h1f, z1f)
-
-        // We'll do something like:
-        int baseIndex = (int)seamVerts.size();
-
-        // corner0 coarser
-        seamVerts.push_back(Vertex(
-            xC, (float)h0c, z0c,
-            rc, gc, bc
-        ));
-        // corner1 coarser
-        seamVerts.push_back(Vertex(
-            xC, (float)h1c, z1c,
-            rc, gc, bc
-        ));
-        // corner2 finer
-        seamVerts.push_back(Vertex(
-            xF, (float)h0f, z0f,
-            rf, gf, bf
-        ));
-        // corner3 finer
-        seamVerts.push_back(Vertex(
-            xF, (float)h1f, z1f,
-            rf, gf, bf
-        ));
-
-        // Now build 2 triangles: (0,1,2) and (2,1,3)
-        seamIndices.push_back(baseIndex + 0);
-        seamIndices.push_back(baseIndex + 1);
-        seamIndices.push_back(baseIndex + 2);
-
-        seamIndices.push_back(baseIndex + 2);
-        seamIndices.push_back(baseIndex + 1);
-        seamIndices.push_back(baseIndex + 3);
-    }
+                for (const SeamBuildJob::Face& f : job.faces)
+                {
+                    SeamBuildResult res;
+                    res.cx = job.cx;
+                    res.cy = job.cy;
+                    res.cz = job.cz;
+                    res.direction = f.direction;
+                    res.lodLevel = job.lodLevel;
+                    res.key = f.key;
+                    m_meshBuffers.acquire(f.vertexEstimate,
+                        m_mesher.getBuildIndices() ? f.vertexEstimate / 4 * 6 : 0, res.verts, res.inds);
+                    m_mesher.buildLODBoundaryStitch(f.direction,
+                        f.layer, job.lodLevel, f.neighborLayer, f.neighborLOD,
+                        job.cx * Chunk::SIZE_X, job.cy * Chunk::SIZE_Y, job.cz * Chunk::SIZE_Z,
+                        res.verts, res.inds, &res.opaqueIndexCount);
+                    localResults.push_back(std::move(res));
+                }
 
-    // ------------------------------------------------------------
-    // 4) Upload to the “finer” chunk’s seam buffer
-    //    If chunkA is the finer, we do chunkA->SEAM_POS_X,
-    //    else chunkB->SEAM_NEG_X, etc.
-    // ------------------------------------------------------------
-    if (!seamVerts.empty() && !seamIndices.empty())
-    {
-        Logger::Info("buildSeamBetweenChunks => Building seam with "
-            + std::to_string(seamVerts.size()) + " verts, "
-            + std::to_string(seamIndices.size()) + " inds.");
-
-        // But recall we’re inside VoxelWorld, so we can call:
-        destroyChunkSeam(*finerChunk, seamDirForFiner); // remove old if any
-        uploadSeamMeshToChunk(*finerChunk, seamDirForFiner,
-            seamVerts, seamIndices);
-    }
-    else
-    {
-        // no geometry => destroy if any
-        destroyChunkSeam(*finerChunk, seamDirForFiner);
+                std::lock_guard<std::mutex> guard(s_resultMutexSeam);
+                for (auto& r : localResults) {
+                    s_pendingSeamResults.push_back(std::move(r));
+                }
+            });
     }
 }
 
@@ -715,76 +754,22 @@ void VoxelWorld::uploadLODMeshToChunk(
     Chunk& chunk,
     int lodLevel,
     const std::vector<Vertex>& verts,
-    const std::vector<uint32_t>& inds)
+    const std::vector<uint32_t>& inds,
+    uint32_t opaqueIndexCount)
 {
-    VkDeviceSize vbSize = sizeof(Vertex) * verts.size();
-    VkDeviceSize ibSize = sizeof(uint32_t) * inds.size();
-
-    // 1) Create device-local buffers
-    VkBuffer       newVB = VK_NULL_HANDLE;
-    VkDeviceMemory newVBMem = VK_NULL_HANDLE;
-    VkBuffer       newIB = VK_NULL_HANDLE;
-    VkDeviceMemory newIBMem = VK_NULL_HANDLE;
-
-    createBuffer(vbSize,
-        VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
-        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-        newVB, newVBMem);
-
-    createBuffer(ibSize,
-        VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
-        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-        newIB, newIBMem);
-
-    // 2) Staging
-    VkBuffer stagingVB = VK_NULL_HANDLE;
-    VkDeviceMemory stagingVBMem = VK_NULL_HANDLE;
-    createBuffer(vbSize,
-        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-        (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT),
-        stagingVB, stagingVBMem);
-
-    VkBuffer stagingIB = VK_NULL_HANDLE;
-    VkDeviceMemory stagingIBMem = VK_NULL_HANDLE;
-    createBuffer(ibSize,
-        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-        (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT),
-        stagingIB, stagingIBMem);
-
-    // 3) Copy CPU => staging
-    {
-        void* dataPtr = nullptr;
-        vkMapMemory(m_context->getDevice(), stagingVBMem, 0, vbSize, 0, &dataPtr);
-        memcpy(dataPtr, verts.data(), (size_t)vbSize);
-        vkUnmapMemory(m_context->getDevice(), stagingVBMem);
-
-        vkMapMemory(m_context->getDevice(), stagingIBMem, 0, ibSize, 0, &dataPtr);
-        memcpy(dataPtr, inds.data(), (size_t)ibSize);
-        vkUnmapMemory(m_context->getDevice(), stagingIBMem);
-    }
-
-    // 4) Transfer
-    copyBuffer(stagingVB, newVB, vbSize);
-    copyBuffer(stagingIB, newIB, ibSize);
+    PROFILE_ZONE("Upload LOD Mesh");
 
-    // 5) Destroy staging
-    {
-        VkDevice dev = m_context->getDevice();
-        vkDestroyBuffer(dev, stagingVB, nullptr);
-        vkFreeMemory(dev, stagingVBMem, nullptr);
-        vkDestroyBuffer(dev, stagingIB, nullptr);
-        vkFreeMemory(dev, stagingIBMem, nullptr);
-    }
-
-    // 6) Assign
     auto& lodData = chunk.getLODData(lodLevel);
-    lodData.vertexBuffer = newVB;
-    lodData.vertexMemory = newVBMem;
-    lodData.indexBuffer = newIB;
-    lodData.indexMemory = newIBMem;
+    lodData.mesh = m_meshSink->uploadMesh(verts, inds);
     lodData.vertexCount = (uint32_t)verts.size();
-    lodData.indexCount = (uint32_t)inds.size();
-    lodData.valid = true;
+    lodData.indexCount = lodData.mesh ? lodData.mesh->indexCount : 0;
+    lodData.opaqueIndexCount = opaqueIndexCount;
+    lodData.valid = (lodData.mesh != nullptr);
+    if (lodData.mesh) {
+        // Fresh meshes count as used so they aren't the first to go
+        lodData.lastUsedFrame = m_residency.getFrame();
+        m_residency.onMeshUploaded(lodLevel, lodData.mesh->byteSize);
+    }
 }
 
 // ------------------------------------------------
@@ -795,74 +780,20 @@ void VoxelWorld::uploadLODMeshToChunk(
 void VoxelWorld::uploadSeamMeshToChunk(Chunk& chunk,
     Chunk::SeamDirection seamDir,
     const std::vector<Vertex>& verts,
-    const std::vector<uint32_t>& inds)
+    const std::vector<uint32_t>& inds,
+    uint32_t opaqueIndexCount)
 {
-    // Very similar to uploadLODMeshToChunk, but writes to chunk.getSeamData(dir).
-    // We'll do a minimal version here:
-
-    VkDeviceSize vbSize = sizeof(Vertex) * verts.size();
-    VkDeviceSize ibSize = sizeof(uint32_t) * inds.size();
-
-    VkBuffer       newVB = VK_NULL_HANDLE;
-    VkDeviceMemory newVBMem = VK_NULL_HANDLE;
-    VkBuffer       newIB = VK_NULL_HANDLE;
-    VkDeviceMemory newIBMem = VK_NULL_HANDLE;
-
-    createBuffer(vbSize,
-        VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
-        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-        newVB, newVBMem);
-    createBuffer(ibSize,
-        VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT,
-        VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-        newIB, newIBMem);
-
-    // Staging
-    VkBuffer stagingVB = VK_NULL_HANDLE;
-    VkDeviceMemory stagingVBMem = VK_NULL_HANDLE;
-    createBuffer(vbSize,
-        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-        (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT),
-        stagingVB, stagingVBMem);
-
-    VkBuffer stagingIB = VK_NULL_HANDLE;
-    VkDeviceMemory stagingIBMem = VK_NULL_HANDLE;
-    createBuffer(ibSize,
-        VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-        (VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT),
-        stagingIB, stagingIBMem);
-
-    {
-        void* dataPtr = nullptr;
-        vkMapMemory(m_context->getDevice(), stagingVBMem, 0, vbSize, 0, &dataPtr);
-        memcpy(dataPtr, verts.data(), (size_t)vbSize);
-        vkUnmapMemory(m_context->getDevice(), stagingVBMem);
-
-        vkMapMemory(m_context->getDevice(), stagingIBMem, 0, ibSize, 0, &dataPtr);
-        memcpy(dataPtr, inds.data(), (size_t)ibSize);
-        vkUnmapMemory(m_context->getDevice(), stagingIBMem);
-    }
+    PROFILE_ZONE("Upload Seam Mesh");
 
-    copyBuffer(stagingVB, newVB, vbSize);
-    copyBuffer(stagingIB, newIB, ibSize);
-
-    {
-        VkDevice dev = m_context->getDevice();
-        vkDestroyBuffer(dev, stagingVB, nullptr);
-        vkFreeMemory(dev, stagingVBMem, nullptr);
-        vkDestroyBuffer(dev, stagingIB, nullptr);
-        vkFreeMemory(dev, stagingIBMem, nullptr);
-    }
-
-    // Store
     auto& seamData = chunk.getSeamData(seamDir);
-    seamData.seamVertexBuffer = newVB;
-    seamData.seamVertexMemory = newVBMem;
-    seamData.seamIndexBuffer = newIB;
-    seamData.seamIndexMemory = newIBMem;
+    seamData.mesh = m_meshSink->uploadMesh(verts, inds);
     seamData.vertexCount = (uint32_t)verts.size();
-    seamData.indexCount = (uint32_t)inds.size();
-    seamData.valid = true;
+    seamData.indexCount = seamData.mesh ? seamData.mesh->indexCount : 0;
+    seamData.opaqueIndexCount = opaqueIndexCount;
+    seamData.valid = (seamData.mesh != nullptr);
+    if (seamData.mesh) {
+        m_seamResidentBytes += seamData.mesh->byteSize;
+    }
 }
 
 // ------------------------------------------------
@@ -871,27 +802,18 @@ void VoxelWorld::uploadSeamMeshToChunk(Chunk& chunk,
 void VoxelWorld::destroyChunkLOD(Chunk& chunk, int lodLevel)
 {
     auto& lodData = chunk.getLODData(lodLevel);
-    VkDevice device = m_context->getDevice();
-
-    if (lodData.vertexBuffer != VK_NULL_HANDLE) {
-        vkDestroyBuffer(device, lodData.vertexBuffer, nullptr);
-        lodData.vertexBuffer = VK_NULL_HANDLE;
-    }
-    if (lodData.vertexMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(device, lodData.vertexMemory, nullptr);
-        lodData.vertexMemory = VK_NULL_HANDLE;
-    }
-    if (lodData.indexBuffer != VK_NULL_HANDLE) {
-        vkDestroyBuffer(device, lodData.indexBuffer, nullptr);
-        lodData.indexBuffer = VK_NULL_HANDLE;
-    }
-    if (lodData.indexMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(device, lodData.indexMemory, nullptr);
-        lodData.indexMemory = VK_NULL_HANDLE;
+    if (lodData.mesh) {
+        m_residency.onMeshDestroyed(lodLevel, lodData.mesh->byteSize);
     }
+    m_meshSink->destroyMesh(lodData.mesh);
+    lodData.mesh = nullptr;
     lodData.vertexCount = 0;
     lodData.indexCount = 0;
+    lodData.opaqueIndexCount = 0;
     lodData.valid = false;
+    lodData.slices.clear();
+    lodData.faceRanges = MeshFaceRanges();
+    lodData.meshlets.clear();
 }
 
 // ------------------------------------------------
@@ -900,112 +822,13 @@ void VoxelWorld::destroyChunkLOD(Chunk& chunk, int lodLevel)
 void VoxelWorld::destroyChunkSeam(Chunk& chunk, Chunk::SeamDirection dir)
 {
     auto& seamData = chunk.getSeamData(dir);
-    VkDevice device = m_context->getDevice();
-
-    if (seamData.seamVertexBuffer != VK_NULL_HANDLE) {
-        vkDestroyBuffer(device, seamData.seamVertexBuffer, nullptr);
-        seamData.seamVertexBuffer = VK_NULL_HANDLE;
-    }
-    if (seamData.seamVertexMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(device, seamData.seamVertexMemory, nullptr);
-        seamData.seamVertexMemory = VK_NULL_HANDLE;
-    }
-    if (seamData.seamIndexBuffer != VK_NULL_HANDLE) {
-        vkDestroyBuffer(device, seamData.seamIndexBuffer, nullptr);
-        seamData.seamIndexBuffer = VK_NULL_HANDLE;
-    }
-    if (seamData.seamIndexMemory != VK_NULL_HANDLE) {
-        vkFreeMemory(device, seamData.seamIndexMemory, nullptr);
-        seamData.seamIndexMemory = VK_NULL_HANDLE;
+    if (seamData.mesh) {
+        m_seamResidentBytes -= std::min(seamData.mesh->byteSize, m_seamResidentBytes);
     }
+    m_meshSink->destroyMesh(seamData.mesh);
+    seamData.mesh = nullptr;
     seamData.vertexCount = 0;
     seamData.indexCount = 0;
+    seamData.opaqueIndexCount = 0;
     seamData.valid = false;
 }
-
-// ------------------------------------------------
-// createBuffer, copyBuffer, findMemoryType
-// ------------------------------------------------
-void VoxelWorld::createBuffer(VkDeviceSize size,
-    VkBufferUsageFlags usage,
-    VkMemoryPropertyFlags properties,
-    VkBuffer& buffer,
-    VkDeviceMemory& memory)
-{
-    VkBufferCreateInfo bufInfo{};
-    bufInfo.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
-    bufInfo.size = size;
-    bufInfo.usage = usage;
-    bufInfo.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
-
-    if (vkCreateBuffer(m_context->getDevice(), &bufInfo, nullptr, &buffer) != VK_SUCCESS) {
-        throw std::runtime_error("Failed to create buffer!");
-    }
-
-    VkMemoryRequirements memReq;
-    vkGetBufferMemoryRequirements(m_context->getDevice(), buffer, &memReq);
-
-    VkMemoryAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
-    allocInfo.allocationSize = memReq.size;
-    allocInfo.memoryTypeIndex = findMemoryType(memReq.memoryTypeBits, properties);
-
-    if (vkAllocateMemory(m_context->getDevice(), &allocInfo, nullptr, &memory) != VK_SUCCESS) {
-        throw std::runtime_error("Failed to allocate buffer memory!");
-    }
-
-    vkBindBufferMemory(m_context->getDevice(), buffer, memory, 0);
-}
-
-void VoxelWorld::copyBuffer(VkBuffer src, VkBuffer dst, VkDeviceSize size)
-{
-    VkCommandPool cmdPool = m_context->getCommandPool();
-    VkQueue       gfxQueue = m_context->getGraphicsQueue();
-
-    VkCommandBufferAllocateInfo allocInfo{};
-    allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
-    allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
-    allocInfo.commandPool = cmdPool;
-    allocInfo.commandBufferCount = 1;
-
-    VkCommandBuffer cmdBuf;
-    vkAllocateCommandBuffers(m_context->getDevice(), &allocInfo, &cmdBuf);
-
-    VkCommandBufferBeginInfo beginInfo{};
-    beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-    beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
-
-    vkBeginCommandBuffer(cmdBuf, &beginInfo);
-
-    VkBufferCopy copyRegion{};
-    copyRegion.size = size;
-    vkCmdCopyBuffer(cmdBuf, src, dst, 1, &copyRegion);
-
-    vkEndCommandBuffer(cmdBuf);
-
-    VkSubmitInfo submitInfo{};
-    submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-    submitInfo.commandBufferCount = 1;
-    submitInfo.pCommandBuffers = &cmdBuf;
-
-    vkQueueSubmit(gfxQueue, 1, &submitInfo, VK_NULL_HANDLE);
-    vkQueueWaitIdle(gfxQueue);
-
-    vkFreeCommandBuffers(m_context->getDevice(), cmdPool, 1, &cmdBuf);
-}
-
-uint32_t VoxelWorld::findMemoryType(uint32_t filter, VkMemoryPropertyFlags props)
-{
-    VkPhysicalDeviceMemoryProperties memProps;
-    vkGetPhysicalDeviceMemoryProperties(m_context->getPhysicalDevice(), &memProps);
-
-    for (uint32_t i = 0; i < memProps.memoryTypeCount; i++)
-    {
-        if ((filter & (1 << i)) &&
-            (memProps.memoryTypes[i].propertyFlags & props) == props)
-        {
-            return i;
-        }
-    }
-    throw std::runtime_error("Failed to find suitable memory type!");
-}
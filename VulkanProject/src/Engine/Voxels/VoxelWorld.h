@@ -1,22 +1,29 @@
 ﻿#pragma once
 
-#include <vulkan/vulkan.h>
 #include <vector>
 #include <cstdint>
 #include <mutex>
 #include "ChunkManager.h"
 #include "ChunkMesher.h"
+#include "VoxelRaycast.h"
+#include "LODPolicy.h"
+#include "LODBalancer.h"
+#include "MeshResidency.h"
+#include "MeshBufferPool.h"
+#include "MeshCache.h"
+#include "SuperChunkManager.h"
+#include "MeshSink.h"
 #include "Generation/TerrainGenerator.h"
 
-/**
- * For advanced LOD transitions, define a new function pointer or functor
- * if you prefer a separate bridging approach.
- */
-class VulkanContext;
+struct LODMeshBuildResult; // meshing job output, see VoxelWorld.cpp
 
 /**
  * VoxelWorld orchestrates chunk creation, LOD scheduling, uploading,
- * and now includes partial code for stitching boundaries.
+ * and the seam meshes that close chunk borders between LODs.
+ *
+ * Finished meshes go to a MeshSink, so the world itself has no graphics
+ * API dependency (the renderer passes a VulkanMeshSink; tools can pass
+ * anything). The sink must outlive the world.
  */
 class VoxelWorld
 {
@@ -26,37 +33,142 @@ public:
 
     // Provide read access to meshing stats
     static double getAvgMeshTime();
+    static int    getMeshCount(); // full LOD mesh builds so far
 
-    VoxelWorld(VulkanContext* context);
+    explicit VoxelWorld(MeshSink* meshSink);
     ~VoxelWorld();
 
     void initWorld();
-    void updateChunksAroundPlayer(float playerPosX, float playerPosZ);
+    void updateChunksAroundPlayer(const glm::vec3& playerPos);
 
     ChunkManager& getChunkManager() { return m_chunkManager; }
 
+    /**
+     * Which LOD each chunk is built and drawn at. The renderer feeds it the
+     * camera projection; LOD choices land in Chunk::getTargetLOD().
+     */
+    LODPolicy& getLODPolicy() { return m_lodPolicy; }
+
+    /**
+     * Switches how LOD1+ voxels are reduced and re-dirties those LODs so
+     * they are rebuilt with it.
+     */
+    void         setMipReduction(MipReduction mode);
+    MipReduction getMipReduction() const { return m_mesher.getMipReduction(); }
+
+    /// Chunks whose target LOD changed during the last update.
+    int getLODChangeCount() const { return m_lodChanges; }
+
+    /// The 2:1 balancing pass behind the targets (runtime / reassignment stats).
+    const LODBalancer& getLODBalancer() const { return m_lodBalancer; }
+
+    /// Seam jobs (one per chunk with stale faces) queued during the last update.
+    int    getSeamBuildCount() const { return m_seamBuilds; }
+    size_t getSeamResidentBytes() const { return m_seamResidentBytes; }
+
+    /**
+     * GPU memory budget and LRU state for the LOD meshes. The renderer
+     * marks what it draws; the world evicts at the end of each update.
+     */
+    MeshResidency& getMeshResidency() { return m_residency; }
+
+    /**
+     * Far-field meshes that replace groups of distant chunks (see
+     * SuperChunkManager). Groups switch over at the coarsest LOD's
+     * switch distance.
+     */
+    SuperChunkManager& getSuperChunks() { return m_superChunks; }
+
+    /**
+     * Picking / line-of-sight query against the loaded chunks (main thread only).
+     */
+    RaycastHit raycast(const glm::vec3& origin, const glm::vec3& dir, float maxDistance);
+    VoxelRaycaster& getRaycaster() { return m_raycaster; }
+
+    /**
+     * Edits one voxel (world voxel coordinates, main thread). Only the
+     * LOD0 slices around it are re-meshed and patched into the resident
+     * mesh; coarser LODs and the seams follow the chunk's version.
+     * Returns false if the chunk isn't loaded and generated yet.
+     */
+    bool setVoxel(int x, int y, int z, int voxelID);
+
+    /// Slices patched in place so far, and patches that fell back to a full LOD0 rebuild.
+    uint64_t getSlicePatchCount() const { return m_slicePatches; }
+    uint64_t getSlicePatchFallbacks() const { return m_slicePatchFallbacks; }
+
+    /// Recycled vertex/index vectors of the meshing jobs (reuse stats)
+    const MeshBufferPool& getMeshBuffers() const { return m_meshBuffers; }
+
+    /// Chunk meshes by voxel content, shared by identical chunks (hit stats)
+    const MeshCache& getMeshCache() const { return m_meshCache; }
+
 private:
     static constexpr int VIEW_DISTANCE = 16;
 
-    VulkanContext* m_context = nullptr;
+    // Bounds the main-thread layer copies per update
+    static constexpr int MAX_SEAM_JOBS_PER_UPDATE = 64;
+
+    MeshSink*      m_meshSink = nullptr;
     ChunkManager    m_chunkManager;
     TerrainGenerator m_terrainGenerator;
     ChunkMesher      m_mesher;
+    VoxelRaycaster   m_raycaster;
+    LODPolicy        m_lodPolicy;
+    LODBalancer      m_lodBalancer;
+    int              m_lodChanges = 0;
+    int              m_seamBuilds = 0;
+    size_t           m_seamResidentBytes = 0;
+    uint64_t         m_slicePatches = 0;
+    uint64_t         m_slicePatchFallbacks = 0;
+    MeshResidency    m_residency;
+    MeshBufferPool   m_meshBuffers; // meshing job outputs, back in the pool after upload
+    MeshCache        m_meshCache;
+    SuperChunkManager m_superChunks;
+    std::vector<MeshResidency::Eviction> m_evictions; // scratch
+
+    /**
+     * Updates every chunk's target LOD (LODPolicy + LODBalancer, "LOD
+     * difference <= 1" with neighbors) and schedules a build when that
+     * LOD's mesh is out of date.
+     */
+    void scheduleMeshingForDirtyChunks(const glm::vec3& viewerPos);
+
+    /**
+     * Queues a meshing job for the chunk's target LOD (or, once that is
+     * clean, its coarsest) if dirty and no job is in flight.
+     */
+    void scheduleChunkBuild(Chunk* chunk);
+
+    /**
+     * Queues a job re-meshing the chunk's dirty LOD0 slices. Returns false
+     * (nothing queued) if LOD0 has no segmented mesh to patch.
+     */
+    bool scheduleSlicePatch(Chunk* chunk);
 
-    // Worker thread neighbor updates
-    std::mutex              m_neighborMutex;
-    std::vector<ChunkCoord> m_pendingNeighborDirty;
+    /**
+     * Writes a slice patch result into the chunk's LOD0 mesh. False if it
+     * doesn't fit (or the sink can't patch); LOD0 is then rebuilt.
+     */
+    bool applySlicePatch(Chunk& chunk, LODMeshBuildResult& res);
 
     /**
-     * Schedules a new mesh build for dirty chunks, respecting the "LOD difference <= 1" rule.
+     * Queues background seam builds for chunk faces whose own or neighbor
+     * LOD/version changed since their seam was built. Results are uploaded
+     * in pollMeshBuildResults.
      */
-    void scheduleMeshingForDirtyChunks(int centerChunkX, int centerChunkZ);
+    void scheduleSeamBuilds();
 
     /**
      * Poll results from the background meshing tasks & upload to GPU.
      */
     void pollMeshBuildResults();
 
+    /**
+     * Destroys the LOD meshes MeshResidency picks while over budget.
+     */
+    void evictMeshesOverBudget();
+
     /**
      * Upload geometry data to chunk’s LOD buffers (or seam).
      */
@@ -64,14 +176,8 @@ private:
         Chunk& chunk,
         int lodLevel,
         const std::vector<Vertex>& verts,
-        const std::vector<uint32_t>& inds);
-
-    /**
-     * Possibly build seam geometry between this chunk and its neighbor, if LOD differs by 1.
-     * This is a placeholder. Implementation might be in the mesher or a dedicated class.
-     */
-    void buildSeamBetweenChunks(Chunk& chunkA, int lodA, Chunk& chunkB, int lodB,
-        int faceDirection);
+        const std::vector<uint32_t>& inds,
+        uint32_t opaqueIndexCount);
 
     /**
      * Upload seam geometry to chunk’s seam data for the specified face.
@@ -79,7 +185,8 @@ private:
     void uploadSeamMeshToChunk(Chunk& chunk,
         Chunk::SeamDirection seamDir,
         const std::vector<Vertex>& verts,
-        const std::vector<uint32_t>& inds);
+        const std::vector<uint32_t>& inds,
+        uint32_t opaqueIndexCount);
 
     void destroyChunkLOD(Chunk& chunk, int lodLevel);
 
@@ -87,16 +194,4 @@ private:
      * For seam destruction if needed, or to handle re-build.
      */
     void destroyChunkSeam(Chunk& chunk, Chunk::SeamDirection dir);
-
-    /**
-     * Basic buffer creation/copy
-     */
-    void createBuffer(VkDeviceSize size,
-        VkBufferUsageFlags usage,
-        VkMemoryPropertyFlags properties,
-        VkBuffer& buffer,
-        VkDeviceMemory& memory);
-
-    void copyBuffer(VkBuffer src, VkBuffer dst, VkDeviceSize size);
-    uint32_t findMemoryType(uint32_t filter, VkMemoryPropertyFlags props);
 };
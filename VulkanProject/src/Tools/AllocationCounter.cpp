@@ -0,0 +1,31 @@
+// -----------------------------------------------------------------------------
+// Global operator new / delete replacements for world_bench, counting every
+// heap allocation. They live in a translation unit of their own: inlined
+// into a caller, GCC would see free() on a pointer from operator new and
+// warn (-Wmismatched-new-delete). The array and nothrow forms forward to
+// these by default.
+// -----------------------------------------------------------------------------
+#include "AllocationCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<uint64_t> s_allocations{ 0 };
+
+uint64_t allocationCount()
+{
+    return s_allocations.load(std::memory_order_relaxed);
+}
+
+void* operator new(std::size_t size)
+{
+    s_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
@@ -0,0 +1,9 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Heap allocations so far, across all threads. world_bench replaces the
+ * global operator new / delete to count them (AllocationCounter.cpp).
+ */
+uint64_t allocationCount();
@@ -0,0 +1,1347 @@
+// -----------------------------------------------------------------------------
+// world_bench
+//
+// Headless benchmark of the world pipeline: terrain generation and meshing of
+// every LOD on the thread pool, "uploads" into a CPU-side MeshSink. No window,
+// no Vulkan, so it runs on build machines. Prints one JSON document.
+//
+//   world_bench [--size N] [--seed S] [--mip majority|solid|surface]
+//               [--shared-indices | --packed-quads] [--out file.json]
+//
+// The world is N x N chunks (one vertical layer, like VoxelWorld). With a
+// fixed seed the output is deterministic except for timings; "meshHash"
+// changes only if generated geometry does. --shared-indices meshes and
+// uploads like the shared quad index buffer mode (vertices only),
+// --packed-quads like vertex pulling (8-byte PackedQuad records, checked
+// against the vertices they came from), so their bytes and hash differ
+// from the default.
+//
+// "allocations" re-meshes every chunk twice on one thread with pooled
+// output buffers and rebuilt mip chains, counting global operator new
+// calls (AllocationCounter.cpp); the second round must not allocate at
+// all, otherwise world_bench exits with an error.
+// "meshlets" compares LOD0 triangles submitted with chunk-level frustum and
+// facing culling against meshlet culling, for a few fixed cameras.
+// "frustumCull" times frustum tests over 1k, 10k and 100k boxes one at a
+// time and batched (SIMD); batched results that differ are an error.
+// "mipKernels" runs voxel downsampling through the SIMD and the scalar
+// kernels on random input; any difference is an error.
+// "quadtree" culls the loaded chunks through ChunkManager's quadtree and
+// through a flat loop over all of them; differing results are an error.
+// "raycast" reports VoxelRaycaster rays/s (benchmarkRaycasts) and checks
+// random rays, single and batched, against per-voxel stepping without the
+// empty-chunk skip or the chunk cache; a different hit is an error.
+// "meshCache" meshes every chunk and LOD through a MeshCache; a hit that
+// differs from a fresh build is an error too. With --packed-quads the
+// sink shares identical quad records like VulkanMeshSink, so
+// "residentBytes" counts them once.
+// -----------------------------------------------------------------------------
+#include "AllocationCounter.h"
+#include "Engine/Graphics/Frustum.h"
+#include "Engine/Voxels/ChunkManager.h"
+#include "Engine/Voxels/ChunkMesher.h"
+#include "Engine/Voxels/ChunkVisibility.h"
+#include "Engine/Voxels/LODDownsampler.h"
+#include "Engine/Voxels/MeshBufferPool.h"
+#include "Engine/Voxels/MeshCache.h"
+#include "Engine/Voxels/MeshSink.h"
+#include "Engine/Voxels/PackedQuad.h"
+#include "Engine/Voxels/VoxelSetup.h"
+#include "Engine/Voxels/VoxelTypeRegistry.h"
+#include "Engine/Voxels/VoxelRaycast.h"
+#include "Engine/Voxels/VoxelWorld.h"
+#include "Engine/Voxels/Generation/TerrainGenerator.h"
+#include "Engine/Utils/Logger.h"
+#include "Engine/Utils/ThreadPool.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// VoxelWorld and friends expect the application's global pool
+ThreadPool g_threadPool(0);
+
+namespace
+{
+    typedef std::chrono::steady_clock Clock;
+
+    const int LOD_COUNT = VoxelWorld::LOD_COUNT;
+
+    uint64_t elapsedNs(Clock::time_point t0, Clock::time_point t1)
+    {
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count();
+    }
+
+    /**
+     * Blocks until every task counted with add() has called done().
+     */
+    class WaitGroup
+    {
+    public:
+        void add(int n) { std::lock_guard<std::mutex> lock(m_mutex); m_pending += n; }
+        void done()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (--m_pending == 0) m_cv.notify_all();
+        }
+        void wait()
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this]() { return m_pending == 0; });
+        }
+
+    private:
+        std::mutex              m_mutex;
+        std::condition_variable m_cv;
+        int                     m_pending = 0;
+    };
+
+    /// Mirrors VulkanMeshSink::Format
+    enum class SinkFormat
+    {
+        Indexed,
+        SharedQuadIndices,
+        PackedQuads
+    };
+
+    const char* sinkFormatName(SinkFormat format)
+    {
+        switch (format)
+        {
+        case SinkFormat::SharedQuadIndices: return "sharedQuadIndices";
+        case SinkFormat::PackedQuads:       return "packedQuads";
+        default:                            return "indexed";
+        }
+    }
+
+    uint64_t fnv1a(uint64_t hash, const void* data, size_t size)
+    {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; i++) {
+            hash ^= p[i];
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+    /**
+     * MeshSink that keeps geometry in host memory and counts what it got.
+     * The copy stands in for the staging memcpy of the Vulkan sink.
+     * Like VulkanMeshSink it can take vertex-only meshes, and pack them
+     * into quad records; every packed quad is unpacked again and compared
+     * with its vertices, as quad_pull.vert would expand it. Meshes with
+     * the same records share them, as in VulkanMeshSink.
+     */
+    struct CpuMesh : public GpuMesh
+    {
+        std::vector<char> data;
+        uint64_t          quadKey = 0; // packed records' hash, 0 if not packed
+    };
+
+    class StatsMeshSink : public MeshSink
+    {
+    public:
+        explicit StatsMeshSink(SinkFormat format) : m_format(format) {}
+
+        GpuMesh* uploadMesh(const std::vector<Vertex>& verts, const std::vector<uint32_t>& inds) override
+        {
+            const bool quadsOnly = usesSharedQuadIndices();
+            if (verts.empty() || (inds.empty() && !quadsOnly)) {
+                return nullptr;
+            }
+            const void* vertexData = verts.data();
+            size_t vbSize = sizeof(Vertex) * verts.size();
+            size_t ibSize = quadsOnly ? 0 : sizeof(uint32_t) * inds.size();
+            if (m_format == SinkFormat::PackedQuads)
+            {
+                packAndCheck(verts);
+                vertexData = m_quads.data();
+                vbSize = sizeof(PackedQuad) * m_quads.size();
+            }
+
+            CpuMesh* mesh = new CpuMesh();
+            mesh->vertexCount = (uint32_t)verts.size();
+            mesh->indexCount = quadsOnly ? (uint32_t)(verts.size() / 4 * 6) : (uint32_t)inds.size();
+            mesh->byteSize = vbSize + ibSize;
+            m_uploads++;
+            if (m_format == SinkFormat::PackedQuads)
+            {
+                mesh->quadKey = fnv1a(1469598103934665603ull, m_quads.data(), vbSize) | 1;
+                if (m_quadRefs[mesh->quadKey]++ > 0)
+                {
+                    m_sharedUploads++;
+                    return mesh; // the first mesh with these records holds them
+                }
+            }
+            mesh->data.resize(vbSize + ibSize);
+            std::memcpy(mesh->data.data(), vertexData, vbSize);
+            if (ibSize > 0) {
+                std::memcpy(mesh->data.data() + vbSize, inds.data(), ibSize);
+            }
+
+            m_liveBytes += mesh->byteSize;
+            return mesh;
+        }
+
+        void destroyMesh(GpuMesh* mesh) override
+        {
+            if (!mesh) return;
+            CpuMesh* cpuMesh = static_cast<CpuMesh*>(mesh);
+            if (cpuMesh->quadKey != 0 && --m_quadRefs[cpuMesh->quadKey] > 0)
+            {
+                delete cpuMesh;
+                return;
+            }
+            m_quadRefs.erase(cpuMesh->quadKey);
+            m_liveBytes -= mesh->byteSize;
+            delete cpuMesh;
+        }
+
+        bool     usesSharedQuadIndices() const override { return m_format != SinkFormat::Indexed; }
+        size_t   getLiveBytes() const { return m_liveBytes; }
+        uint64_t getUploadCount() const { return m_uploads; }
+        uint64_t getSharedUploadCount() const { return m_sharedUploads; }
+        uint64_t getPackedQuadCount() const { return m_packedQuads; }
+        uint64_t getPackMismatchCount() const { return m_packMismatches; }
+
+    private:
+        void packAndCheck(const std::vector<Vertex>& verts)
+        {
+            int origin[3];
+            PackedQuads::meshOrigin(verts, origin);
+            m_quads.resize(verts.size() / 4);
+            for (size_t q = 0; q < m_quads.size(); q++)
+            {
+                const Vertex* corners = &verts[q * 4];
+                Vertex unpacked[4] = {
+                    Vertex(0, 0, 0, 0, 0, 0), Vertex(0, 0, 0, 0, 0, 0),
+                    Vertex(0, 0, 0, 0, 0, 0), Vertex(0, 0, 0, 0, 0, 0)
+                };
+                bool ok = PackedQuads::pack(corners, origin, m_quads[q]);
+                bool padding = ok && m_quads[q].lo == 0 && m_quads[q].hi == 0;
+                if (ok && !padding)
+                {
+                    PackedQuads::unpack(m_quads[q], origin, unpacked);
+                    for (int i = 0; i < 4 && ok; i++)
+                    {
+                        ok = unpacked[i].px == corners[i].px && unpacked[i].py == corners[i].py
+                            && unpacked[i].pz == corners[i].pz
+                            && std::fabs(unpacked[i].cx - corners[i].cx) <= 0.5f / 127.f
+                            && std::fabs(unpacked[i].cy - corners[i].cy) <= 0.5f / 127.f
+                            && std::fabs(unpacked[i].cz - corners[i].cz) <= 0.5f / 127.f;
+                    }
+                }
+                m_packedQuads++;
+                if (!ok) m_packMismatches++;
+            }
+        }
+
+        SinkFormat              m_format = SinkFormat::Indexed;
+        std::vector<PackedQuad> m_quads;
+        uint64_t                m_packedQuads = 0;
+        uint64_t                m_packMismatches = 0;
+        size_t                  m_liveBytes = 0;
+        uint64_t                m_uploads = 0;
+        uint64_t                m_sharedUploads = 0;
+        std::map<uint64_t, int> m_quadRefs; // live packed records by hash
+    };
+
+    /**
+     * Latency samples of one stage, reported as percentiles in ms.
+     */
+    struct LatencySeries
+    {
+        std::vector<uint64_t> samplesNs;
+
+        void writeJson(FILE* f)
+        {
+            std::sort(samplesNs.begin(), samplesNs.end());
+            double sum = 0.0;
+            for (uint64_t s : samplesNs) sum += (double)s;
+
+            size_t n = samplesNs.size();
+            std::fprintf(f, "{\"count\":%zu,\"mean\":%.4f,\"p50\":%.4f,\"p90\":%.4f,\"p99\":%.4f,\"max\":%.4f}",
+                n,
+                n ? sum / n / 1.0e6 : 0.0,
+                percentileMs(0.50), percentileMs(0.90), percentileMs(0.99),
+                n ? samplesNs.back() / 1.0e6 : 0.0);
+        }
+
+        // Nearest-rank percentile; samples must be sorted
+        double percentileMs(double p) const
+        {
+            if (samplesNs.empty()) return 0.0;
+            size_t rank = (size_t)std::ceil(p * samplesNs.size());
+            if (rank < 1) rank = 1;
+            return samplesNs[std::min(rank, samplesNs.size()) - 1] / 1.0e6;
+        }
+    };
+
+    /**
+     * One meshing job's output, filled by a worker.
+     */
+    struct MeshJob
+    {
+        Chunk*                chunk = nullptr;
+        int                   cx = 0, cy = 0, cz = 0;
+        int                   lodLevel = 0;
+        std::vector<Vertex>   verts;
+        std::vector<uint32_t> inds;
+        uint32_t              opaqueIndexCount = 0;
+        MeshFaceRanges        faceRanges;
+        MeshBuildTimings      timings;
+        uint64_t              connectivityNs = 0;
+        uint64_t              totalNs = 0;
+    };
+
+    struct LODTotals
+    {
+        uint64_t      meshes = 0;      // non-empty meshes
+        uint64_t      vertices = 0;
+        uint64_t      triangles = 0;
+        uint64_t      bytes = 0;
+        LatencySeries meshLatency;
+        LatencySeries downsampleLatency;
+    };
+
+    struct SeamTotals
+    {
+        uint64_t meshes = 0;    // non-empty seam meshes
+        uint64_t triangles = 0;
+        uint64_t wallNs = 0;
+    };
+
+    int floorDiv(int a, int b)
+    {
+        return (a >= 0) ? (a / b) : -((-a + b - 1) / b);
+    }
+
+    /**
+     * Reference for VoxelRaycaster: plain Amanatides & Woo, one voxel at a
+     * time through every chunk (empty or missing ones too), looking each
+     * chunk up in the ChunkManager directly.
+     */
+    RaycastHit referenceRaycast(const ChunkManager& manager, const glm::vec3& origin,
+        const glm::vec3& dirIn, float maxDistance)
+    {
+        RaycastHit result;
+        const float len = glm::length(dirIn);
+        if (len <= 0.f || maxDistance <= 0.f) return result;
+        const glm::vec3 dir = dirIn / len;
+
+        const int chunkSize[3] = { Chunk::SIZE_X, Chunk::SIZE_Y, Chunk::SIZE_Z };
+        int   v[3], step[3];
+        float tMax[3], tDelta[3];
+        for (int a = 0; a < 3; a++)
+        {
+            v[a] = (int)std::floor(origin[a]);
+            if (dir[a] > 1e-12f) {
+                step[a] = 1;
+                tDelta[a] = 1.f / dir[a];
+                tMax[a] = (float(v[a] + 1) - origin[a]) * tDelta[a];
+            }
+            else if (dir[a] < -1e-12f) {
+                step[a] = -1;
+                tDelta[a] = -1.f / dir[a];
+                tMax[a] = (origin[a] - float(v[a])) * tDelta[a];
+            }
+            else {
+                step[a] = 0;
+                tDelta[a] = INFINITY;
+                tMax[a] = INFINITY;
+            }
+        }
+
+        float t = 0.f;
+        int enteredAxis = -1;
+        while (t <= maxDistance)
+        {
+            int c[3];
+            for (int a = 0; a < 3; a++) c[a] = floorDiv(v[a], chunkSize[a]);
+            const Chunk* chunk = manager.getChunk(c[0], c[1], c[2]);
+            const int id = chunk ? chunk->getBlock(v[0] - c[0] * chunkSize[0],
+                v[1] - c[1] * chunkSize[1], v[2] - c[2] * chunkSize[2]) : 0;
+            if (id > 0)
+            {
+                result.hit = true;
+                result.voxel = glm::ivec3(v[0], v[1], v[2]);
+                result.distance = t;
+                result.blockID = id;
+                if (enteredAxis >= 0) result.normal[enteredAxis] = -step[enteredAxis];
+                return result;
+            }
+
+            int a = 0;
+            if (tMax[1] < tMax[a]) a = 1;
+            if (tMax[2] < tMax[a]) a = 2;
+            t = tMax[a];
+            v[a] += step[a];
+            tMax[a] += tDelta[a];
+            enteredAxis = a;
+        }
+        return result;
+    }
+
+    /// Same hit; distances may differ in rounding (a chunk skip sums fewer steps)
+    bool sameHit(const RaycastHit& a, const RaycastHit& b)
+    {
+        if (a.hit != b.hit) return false;
+        if (!a.hit) return true;
+        return a.voxel == b.voxel && a.normal == b.normal && a.blockID == b.blockID
+            && std::fabs(a.distance - b.distance) <= 1e-3f * std::max(1.0f, b.distance);
+    }
+
+    void printUsage()
+    {
+        std::fprintf(stderr, "usage: world_bench [--size N] [--seed S] [--mip majority|solid|surface] [--shared-indices | --packed-quads] [--out file.json]\n");
+    }
+}
+
+int main(int argc, char** argv)
+{
+    int         worldSize = 16;
+    int         seed = 1337;
+    std::string outPath;
+    MipReduction mip = MipReduction::SurfacePreserving;
+    SinkFormat  sinkFormat = SinkFormat::Indexed;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (!std::strcmp(argv[i], "--size") && i + 1 < argc)      worldSize = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "--seed") && i + 1 < argc) seed = std::atoi(argv[++i]);
+        else if (!std::strcmp(argv[i], "--out") && i + 1 < argc)  outPath = argv[++i];
+        else if (!std::strcmp(argv[i], "--shared-indices"))       sinkFormat = SinkFormat::SharedQuadIndices;
+        else if (!std::strcmp(argv[i], "--packed-quads"))         sinkFormat = SinkFormat::PackedQuads;
+        else if (!std::strcmp(argv[i], "--mip") && i + 1 < argc)
+        {
+            const char* m = argv[++i];
+            if (!std::strcmp(m, "majority"))     mip = MipReduction::Majority;
+            else if (!std::strcmp(m, "solid"))   mip = MipReduction::MostSolid;
+            else if (!std::strcmp(m, "surface")) mip = MipReduction::SurfacePreserving;
+            else { printUsage(); return EXIT_FAILURE; }
+        }
+        else { printUsage(); return EXIT_FAILURE; }
+    }
+    if (worldSize < 1) {
+        printUsage();
+        return EXIT_FAILURE;
+    }
+
+    Logger::setLevel(LogLevel::Warn); // chunk create/remove logs would dominate
+    registerAllVoxels();
+
+    ChunkManager     chunkManager;
+    TerrainGenerator generator;
+    ChunkMesher      mesher(VoxelTypeRegistry::get().getProperties());
+    StatsMeshSink    sink(sinkFormat);
+    generator.setSeed(seed);
+    mesher.setMipReduction(mip);
+    mesher.setBuildIndices(!sink.usesSharedQuadIndices());
+
+    // Chunk list in a fixed order (the map's iteration order isn't)
+    std::vector<Chunk*> chunks;
+    for (int cz = 0; cz < worldSize; cz++) {
+        for (int cx = 0; cx < worldSize; cx++) {
+            chunks.push_back(chunkManager.createChunk(cx, 0, cz));
+        }
+    }
+    const size_t chunkCount = chunks.size();
+
+    // ------------------------------------------------------------
+    // 1) Generation
+    // ------------------------------------------------------------
+    std::vector<uint64_t> genNs(chunkCount, 0);
+    Clock::time_point genStart = Clock::now();
+    {
+        WaitGroup wg;
+        wg.add((int)chunkCount);
+        for (size_t i = 0; i < chunkCount; i++)
+        {
+            g_threadPool.enqueueTask([&, i]()
+                {
+                    Chunk* c = chunks[i];
+                    Clock::time_point t0 = Clock::now();
+                    generator.generateChunk(*c, c->worldX(), c->worldY(), c->worldZ());
+                    genNs[i] = elapsedNs(t0, Clock::now());
+                    wg.done();
+                });
+        }
+        wg.wait();
+    }
+    uint64_t genWallNs = elapsedNs(genStart, Clock::now());
+
+    // ------------------------------------------------------------
+    // 2) Meshing, every LOD of every chunk
+    // ------------------------------------------------------------
+    std::vector<MeshJob> jobs(chunkCount * LOD_COUNT);
+    for (size_t i = 0; i < chunkCount; i++) {
+        for (int L = 0; L < LOD_COUNT; L++) {
+            MeshJob& job = jobs[i * LOD_COUNT + L];
+            job.chunk = chunks[i];
+            job.cx = chunks[i]->worldX();
+            job.cy = chunks[i]->worldY();
+            job.cz = chunks[i]->worldZ();
+            job.lodLevel = L;
+        }
+    }
+
+    Clock::time_point meshStart = Clock::now();
+    {
+        WaitGroup wg;
+        wg.add((int)jobs.size());
+        for (size_t j = 0; j < jobs.size(); j++)
+        {
+            g_threadPool.enqueueTask([&, j]()
+                {
+                    MeshJob& job = jobs[j];
+                    Clock::time_point t0 = Clock::now();
+                    mesher.buildLODMesh(*job.chunk, job.cx, job.cy, job.cz, job.lodLevel,
+                        job.verts, job.inds, &job.timings,
+                        nullptr, &job.opaqueIndexCount, &job.faceRanges);
+
+                    // Same per-job extra work as VoxelWorld's meshing jobs
+                    Clock::time_point t1 = Clock::now();
+                    if (job.lodLevel == 0) {
+                        job.chunk->setFaceConnectivity(
+                            ChunkVisibility::computeFaceConnectivity(job.chunk->getBlocks()));
+                    }
+                    Clock::time_point t2 = Clock::now();
+                    job.connectivityNs = elapsedNs(t1, t2);
+                    job.totalNs = elapsedNs(t0, t2);
+                    wg.done();
+                });
+        }
+        wg.wait();
+    }
+    uint64_t meshWallNs = elapsedNs(meshStart, Clock::now());
+
+    // ------------------------------------------------------------
+    // 3) Upload (main thread, like VoxelWorld::pollMeshBuildResults)
+    // ------------------------------------------------------------
+    LODTotals     lodTotals[LOD_COUNT];
+    LatencySeries uploadLatency;
+    LatencySeries connectivityLatency;
+    LatencySeries jobLatency;
+    uint64_t      meshHash = 1469598103934665603ull;
+    std::vector<GpuMesh*> meshes;
+    meshes.reserve(jobs.size());
+
+    Clock::time_point uploadStart = Clock::now();
+    for (MeshJob& job : jobs)
+    {
+        LODTotals& t = lodTotals[job.lodLevel];
+        t.meshLatency.samplesNs.push_back(job.timings.meshNs);
+        if (job.lodLevel > 0) t.downsampleLatency.samplesNs.push_back(job.timings.downsampleNs);
+        if (job.lodLevel == 0) connectivityLatency.samplesNs.push_back(job.connectivityNs);
+        jobLatency.samplesNs.push_back(job.totalNs);
+
+        meshHash = fnv1a(meshHash, job.verts.data(), job.verts.size() * sizeof(Vertex));
+        meshHash = fnv1a(meshHash, job.inds.data(), job.inds.size() * sizeof(uint32_t));
+
+        Clock::time_point t0 = Clock::now();
+        GpuMesh* mesh = sink.uploadMesh(job.verts, job.inds);
+        uploadLatency.samplesNs.push_back(elapsedNs(t0, Clock::now()));
+        sink.endFrame();
+
+        if (mesh)
+        {
+            meshes.push_back(mesh);
+            t.meshes++;
+            t.vertices += mesh->vertexCount;
+            t.triangles += mesh->indexCount / 3;
+            t.bytes += mesh->byteSize;
+        }
+    }
+    uint64_t uploadWallNs = elapsedNs(uploadStart, Clock::now());
+    size_t   residentBytes = sink.getLiveBytes();
+
+    for (GpuMesh* m : meshes) {
+        sink.destroyMesh(m);
+    }
+
+    // ------------------------------------------------------------
+    // 3a) Seams (single thread): every chunk's six border meshes, once
+    //     per LOD with all chunks at that LOD, and once as a LOD0/LOD1
+    //     checkerboard where every border is a LOD transition
+    // ------------------------------------------------------------
+    static const int faceOffsets[6][3] = {
+        {1,0,0}, {-1,0,0},
+        {0,1,0}, {0,-1,0},
+        {0,0,1}, {0,0,-1}
+    };
+    const int seamCases = LOD_COUNT + 1;
+    std::vector<SeamTotals> seamTotals(seamCases);
+    std::vector<uint64_t> coarsestSeamTriangles(chunkCount, 0);
+    {
+        auto seamCaseLOD = [&](int seamCase, int cx, int cz) {
+            return (seamCase < LOD_COUNT) ? seamCase : ((cx + cz) & 1);
+        };
+
+        std::vector<int>      layer, neighborLayer;
+        std::vector<Vertex>   verts;
+        std::vector<uint32_t> inds;
+        for (int sc = 0; sc < seamCases; sc++)
+        {
+            SeamTotals& t = seamTotals[sc];
+            Clock::time_point t0 = Clock::now();
+            for (size_t i = 0; i < chunkCount; i++)
+            {
+                const Chunk* c = chunks[i];
+                int lod = seamCaseLOD(sc, c->worldX(), c->worldZ());
+                for (int face = 0; face < 6; face++)
+                {
+                    int nx = c->worldX() + faceOffsets[face][0];
+                    int ny = c->worldY() + faceOffsets[face][1];
+                    int nz = c->worldZ() + faceOffsets[face][2];
+                    bool hasNeighbor = ny == 0 && nx >= 0 && nx < worldSize && nz >= 0 && nz < worldSize;
+                    int neighborLOD = hasNeighbor ? seamCaseLOD(sc, nx, nz) : 0;
+
+                    c->copyBoundaryLayer(face, lod, mip, mesher.getProperties(), layer);
+                    neighborLayer.clear();
+                    if (hasNeighbor) {
+                        chunks[(size_t)nz * worldSize + nx]->copyBoundaryLayer(face ^ 1, neighborLOD, mip,
+                            mesher.getProperties(), neighborLayer);
+                    }
+                    mesher.buildLODBoundaryStitch(face, layer, lod, neighborLayer, neighborLOD,
+                        c->worldX() * Chunk::SIZE_X, c->worldY() * Chunk::SIZE_Y, c->worldZ() * Chunk::SIZE_Z,
+                        verts, inds);
+
+                    if (!verts.empty()) {
+                        t.meshes++;
+                        t.triangles += verts.size() / 2;
+                    }
+                    if (sc == LOD_COUNT - 1) {
+                        coarsestSeamTriangles[i] += verts.size() / 2;
+                    }
+                }
+            }
+            t.wallNs = elapsedNs(t0, Clock::now());
+        }
+    }
+
+    // ------------------------------------------------------------
+    // 3b) Far-field superchunks: every full 4x4 group at the coarsest
+    //     LOD as one mesh, against the same chunks' separate meshes
+    // ------------------------------------------------------------
+    const int superGroup = 4;
+    const int coarsest = LOD_COUNT - 1;
+    uint64_t superMeshes = 0, superTriangles = 0;
+    uint64_t memberMeshes = 0, memberTriangles = 0;
+    Clock::time_point superStart = Clock::now();
+    for (int gz = 0; gz + superGroup <= worldSize; gz += superGroup)
+    {
+        for (int gx = 0; gx + superGroup <= worldSize; gx += superGroup)
+        {
+            std::vector<std::vector<int>> members((size_t)superGroup * superGroup);
+            for (int mz = 0; mz < superGroup; mz++)
+            {
+                for (int mx = 0; mx < superGroup; mx++)
+                {
+                    size_t ci = (size_t)(gz + mz) * worldSize + (gx + mx);
+                    chunks[ci]->copyMipLevel(coarsest, mip, mesher.getProperties(),
+                        members[(size_t)mx + (size_t)superGroup * mz]);
+
+                    // Member meshes plus their border faces (seams)
+                    const MeshJob& job = jobs[ci * LOD_COUNT + coarsest];
+                    if (!job.verts.empty()) {
+                        memberMeshes++;
+                        memberTriangles += job.verts.size() / 2;
+                    }
+                    memberTriangles += coarsestSeamTriangles[ci];
+                }
+            }
+
+            std::vector<Vertex>   verts;
+            std::vector<uint32_t> inds;
+            mesher.buildSuperChunkMesh(members, superGroup, coarsest,
+                gx * Chunk::SIZE_X, 0, gz * Chunk::SIZE_Z, verts, inds);
+            if (!verts.empty()) {
+                superMeshes++;
+                superTriangles += verts.size() / 2;
+            }
+        }
+    }
+    uint64_t superWallNs = elapsedNs(superStart, Clock::now());
+
+    // ------------------------------------------------------------
+    // 3c) Facing: LOD0 triangles the renderer submits when it skips
+    //     face directions pointing away from the eye (MeshFaceRanges),
+    //     from above the world's centre, above a corner and from
+    //     inside the terrain. Index counts as the renderer sees them.
+    // ------------------------------------------------------------
+    const float worldExtent = float(worldSize * Chunk::SIZE_X);
+    const glm::vec3 facingEyes[] = {
+        glm::vec3(worldExtent * 0.5f, Chunk::SIZE_Y + 8.f, worldExtent * 0.5f),
+        glm::vec3(-8.f, Chunk::SIZE_Y + 8.f, -8.f),
+        glm::vec3(worldExtent * 0.5f, Chunk::SIZE_Y * 0.5f, worldExtent * 0.5f)
+    };
+    const int facingEyeCount = (int)(sizeof(facingEyes) / sizeof(facingEyes[0]));
+    uint64_t facingTriangles = 0, facingSubmitted = 0;
+    uint64_t facingPassDraws = 0, facingRangeDraws = 0;
+    for (const MeshJob& job : jobs)
+    {
+        if (job.lodLevel != 0 || job.verts.empty()) continue;
+
+        // Index counts don't depend on the sink's format
+        const uint32_t indexCount = (uint32_t)(job.verts.size() / 4 * 6);
+        glm::vec3 minB, maxB;
+        job.chunk->getBoundingBox(minB, maxB);
+        for (int e = 0; e < facingEyeCount; e++)
+        {
+            const uint8_t mask = MeshFaceRanges::facingMask(facingEyes[e], minB, maxB);
+            for (int pass = 0; pass < MeshSliceLayout::PASS_COUNT; pass++)
+            {
+                const uint32_t passBegin = (pass == 0) ? 0 : job.opaqueIndexCount;
+                const uint32_t passEnd = (pass == 0) ? job.opaqueIndexCount : indexCount;
+                if (passEnd <= passBegin) continue;
+
+                uint32_t firsts[MeshFaceRanges::MAX_RANGES];
+                uint32_t counts[MeshFaceRanges::MAX_RANGES];
+                int ranges = job.faceRanges.visibleRanges(pass, passBegin, passEnd, mask, firsts, counts);
+                for (int r = 0; r < ranges; r++) {
+                    facingSubmitted += counts[r] / 3;
+                }
+                facingTriangles += (passEnd - passBegin) / 3;
+                facingPassDraws++;
+                facingRangeDraws += (uint64_t)ranges;
+            }
+        }
+    }
+
+    // ------------------------------------------------------------
+    // 3d) Meshlets: LOD0 triangles submitted with the renderer's two
+    //     culling modes, for cameras at the facing eyes looking across
+    //     the world: whole chunks against the frustum plus face
+    //     ranges, versus meshlets against the frustum and the eye
+    //     (ChunkMesher::buildMeshlets, as VoxelWorld's jobs build them).
+    // ------------------------------------------------------------
+    const glm::vec3 meshletTargets[] = {
+        glm::vec3(worldExtent, 0.f, worldExtent),
+        glm::vec3(worldExtent * 0.5f, 0.f, worldExtent * 0.5f),
+        glm::vec3(worldExtent, Chunk::SIZE_Y * 0.5f, worldExtent * 0.5f)
+    };
+    Frustum meshletFrustums[facingEyeCount];
+    for (int e = 0; e < facingEyeCount; e++)
+    {
+        const glm::mat4 proj = glm::perspective(glm::radians(70.f), 16.f / 9.f, 0.1f, 1000.f);
+        const glm::mat4 view = glm::lookAt(facingEyes[e], meshletTargets[e], glm::vec3(0.f, 1.f, 0.f));
+        meshletFrustums[e].extractPlanes(proj * view);
+    }
+    uint64_t meshletCount = 0, meshletBuildNs = 0;
+    uint64_t meshletChunkTriangles = 0, meshletSubmitted = 0;
+    uint64_t meshletsDrawn = 0, meshletsCulled = 0, meshletCullNs = 0;
+    std::vector<Meshlet> meshlets;
+    for (const MeshJob& job : jobs)
+    {
+        if (job.lodLevel != 0 || job.verts.empty()) continue;
+
+        const auto buildStart = Clock::now();
+        ChunkMesher::buildMeshlets(job.verts, job.opaqueIndexCount, job.faceRanges, meshlets);
+        meshletBuildNs += elapsedNs(buildStart, Clock::now());
+        meshletCount += meshlets.size();
+
+        const uint32_t indexCount = (uint32_t)(job.verts.size() / 4 * 6);
+        glm::vec3 minB, maxB;
+        job.chunk->getBoundingBox(minB, maxB);
+        for (int e = 0; e < facingEyeCount; e++)
+        {
+            if (!meshletFrustums[e].intersectsAABB(minB, maxB)) continue;
+
+            const uint8_t mask = MeshFaceRanges::facingMask(facingEyes[e], minB, maxB);
+            for (int pass = 0; pass < MeshSliceLayout::PASS_COUNT; pass++)
+            {
+                const uint32_t passBegin = (pass == 0) ? 0 : job.opaqueIndexCount;
+                const uint32_t passEnd = (pass == 0) ? job.opaqueIndexCount : indexCount;
+                if (passEnd <= passBegin) continue;
+
+                uint32_t firsts[MeshFaceRanges::MAX_RANGES];
+                uint32_t counts[MeshFaceRanges::MAX_RANGES];
+                int ranges = job.faceRanges.visibleRanges(pass, passBegin, passEnd, mask, firsts, counts);
+                for (int r = 0; r < ranges; r++) {
+                    meshletChunkTriangles += counts[r] / 3;
+                }
+            }
+
+            const auto cullStart = Clock::now();
+            for (const Meshlet& m : meshlets)
+            {
+                if (m.isEmpty()) continue;
+                if (!m.facesEye(facingEyes[e]) || !meshletFrustums[e].intersectsAABB(m.minB, m.maxB)) {
+                    meshletsCulled++;
+                    continue;
+                }
+                meshletsDrawn++;
+                meshletSubmitted += m.indexCount / 3;
+            }
+            meshletCullNs += elapsedNs(cullStart, Clock::now());
+        }
+    }
+
+    // ------------------------------------------------------------
+    // 3e) Frustum culling: chunk boxes on a square grid around a camera
+    //     at its centre, one at a time (intersectsAABB) versus batched
+    //     over an AABBList (cullAABBs). Independent of --size; repeated
+    //     so each count does about the same work.
+    // ------------------------------------------------------------
+    const size_t cullBoxCounts[] = { 1000, 10000, 100000 };
+    const int cullCaseCount = (int)(sizeof(cullBoxCounts) / sizeof(cullBoxCounts[0]));
+    uint64_t cullScalarNs[cullCaseCount], cullBatchNs[cullCaseCount];
+    size_t cullVisible[cullCaseCount];
+    int cullReps[cullCaseCount];
+    uint64_t cullMismatches = 0;
+    for (int c = 0; c < cullCaseCount; c++)
+    {
+        const size_t boxCount = cullBoxCounts[c];
+        const int side = (int)std::ceil(std::sqrt((double)boxCount));
+        AABBList boxes;
+        boxes.reserve(boxCount);
+        for (size_t b = 0; b < boxCount; b++)
+        {
+            glm::vec3 minB(float(((int)b % side - side / 2) * Chunk::SIZE_X), 0.f,
+                           float(((int)b / side - side / 2) * Chunk::SIZE_Z));
+            boxes.add(minB, minB + glm::vec3(Chunk::SIZE_X, Chunk::SIZE_Y, Chunk::SIZE_Z));
+        }
+
+        const float far = float(side * Chunk::SIZE_X);
+        Frustum frustum;
+        frustum.extractPlanes(glm::perspective(glm::radians(70.f), 16.f / 9.f, 0.1f, far)
+            * glm::lookAt(glm::vec3(0.f, Chunk::SIZE_Y + 8.f, 0.f), glm::vec3(far, 0.f, far * 0.5f),
+                glm::vec3(0.f, 1.f, 0.f)));
+
+        cullReps[c] = (int)std::max<size_t>(1, 2000000 / boxCount);
+        std::vector<uint32_t> scalarVisible, batchVisible;
+        scalarVisible.reserve(boxCount);
+        const auto scalarStart = Clock::now();
+        for (int rep = 0; rep < cullReps[c]; rep++)
+        {
+            scalarVisible.clear();
+            for (size_t b = 0; b < boxCount; b++)
+            {
+                glm::vec3 minB(boxes.minX[b], boxes.minY[b], boxes.minZ[b]);
+                glm::vec3 maxB(boxes.maxX[b], boxes.maxY[b], boxes.maxZ[b]);
+                if (frustum.intersectsAABB(minB, maxB)) scalarVisible.push_back((uint32_t)b);
+            }
+        }
+        cullScalarNs[c] = elapsedNs(scalarStart, Clock::now());
+
+        const auto batchStart = Clock::now();
+        for (int rep = 0; rep < cullReps[c]; rep++) {
+            frustum.cullAABBs(boxes, batchVisible);
+        }
+        cullBatchNs[c] = elapsedNs(batchStart, Clock::now());
+
+        cullVisible[c] = batchVisible.size();
+        if (batchVisible != scalarVisible) cullMismatches++;
+    }
+
+    // ------------------------------------------------------------
+    // 3f) Mip kernels: downsampleVoxels2x against its scalar kernel
+    //     on random voxels (half air, so ties between equal keys
+    //     come up), every reduction, sizes that cover the SIMD
+    //     kernel's 16- and 8-wide steps and its scalar tail
+    // ------------------------------------------------------------
+    const int mipSizes[] = { 2, 4, 6, 8, 10, 16, 18, 24, 34 };
+    const MipReduction mipModes[] = { MipReduction::Majority, MipReduction::MostSolid, MipReduction::SurfacePreserving };
+    const int mipTrials = 40;
+    uint64_t mipCases = 0, mipMismatches = 0;
+    {
+        uint32_t rng = 0x9E3779B9u ^ (uint32_t)seed;
+        std::vector<uint8_t> src, simdOut, scalarOut;
+        for (int size : mipSizes)
+        {
+            const size_t count = (size_t)size * size * size;
+            const size_t half = count / 8;
+            src.resize(count);
+            simdOut.resize(half);
+            scalarOut.resize(half);
+            for (int t = 0; t < mipTrials; t++)
+            {
+                for (size_t v = 0; v < count; v++)
+                {
+                    rng = rng * 1664525u + 1013904223u;
+                    const uint32_t bits = rng >> 8;
+                    src[v] = (bits & 1) ? uint8_t((bits >> 1) % Chunk::MAX_VOXEL_TYPES) : 0;
+                }
+                for (MipReduction mode : mipModes)
+                {
+                    downsampleVoxels2x(src.data(), size, simdOut.data(), mode, mesher.getProperties());
+                    downsampleVoxels2xScalar(src.data(), size, scalarOut.data(), mode, mesher.getProperties());
+                    if (simdOut != scalarOut) mipMismatches++;
+                    mipCases++;
+                }
+            }
+        }
+    }
+
+    // ------------------------------------------------------------
+    // 3g) Quadtree culling: the chunk manager's ChunkQuadtree (bounds
+    //     refreshed after generation, as VoxelWorld does on upload)
+    //     culled like the renderer does, for the meshlet cameras at
+    //     half the world's width, against a flat loop over every
+    //     loaded chunk's (precomputed) bounds. Both must pick the
+    //     same chunks.
+    // ------------------------------------------------------------
+    const ChunkQuadtree& quadtree = chunkManager.getQuadtree();
+    const auto refreshStart = Clock::now();
+    for (Chunk* c : chunks) {
+        chunkManager.refreshBounds(c);
+    }
+    const uint64_t treeRefreshNs = elapsedNs(refreshStart, Clock::now());
+
+    const float treeDistance = worldExtent * 0.5f;
+    const int treeReps = (int)std::max<size_t>(1, 100000 / chunkCount);
+    uint64_t treeNs = 0, flatNs = 0, treeMismatches = 0;
+    uint64_t treeVisible = 0, treeNodesVisited = 0, treeNodesCulled = 0;
+    {
+        std::vector<Chunk*> inside, candidateChunks, treeChunks, flatChunks;
+        std::vector<uint32_t> candidateVisible;
+        AABBList candidates, flatBounds;
+        std::vector<Chunk*> flatBoundsChunks;
+        for (auto& kv : chunkManager.getAllChunks())
+        {
+            glm::vec3 minB, maxB;
+            if (!ChunkQuadtree::chunkBounds(*kv.second, minB, maxB)) continue;
+            flatBounds.add(minB, maxB);
+            flatBoundsChunks.push_back(kv.second.get());
+        }
+        for (int e = 0; e < facingEyeCount; e++)
+        {
+            const Frustum& frustum = meshletFrustums[e];
+            const glm::vec3& eye = facingEyes[e];
+            ChunkQuadtree::CullStats treeStats;
+
+            const auto treeStart = Clock::now();
+            for (int rep = 0; rep < treeReps; rep++)
+            {
+                quadtree.cull(&frustum, eye, treeDistance, inside, candidates, candidateChunks, &treeStats);
+                frustum.cullAABBs(candidates, candidateVisible);
+                treeChunks.assign(inside.begin(), inside.end());
+                for (uint32_t index : candidateVisible) {
+                    treeChunks.push_back(candidateChunks[index]);
+                }
+            }
+            treeNs += elapsedNs(treeStart, Clock::now());
+
+            const auto flatStart = Clock::now();
+            for (int rep = 0; rep < treeReps; rep++)
+            {
+                flatChunks.clear();
+                for (size_t b = 0; b < flatBoundsChunks.size(); b++)
+                {
+                    const glm::vec3 minB(flatBounds.minX[b], flatBounds.minY[b], flatBounds.minZ[b]);
+                    const glm::vec3 maxB(flatBounds.maxX[b], flatBounds.maxY[b], flatBounds.maxZ[b]);
+                    const glm::vec3 nearest = glm::max(minB, glm::min(eye, maxB));
+                    const glm::vec3 d = nearest - eye;
+                    if (d.x * d.x + d.y * d.y + d.z * d.z > treeDistance * treeDistance) continue;
+                    if (frustum.intersectsAABB(minB, maxB)) flatChunks.push_back(flatBoundsChunks[b]);
+                }
+            }
+            flatNs += elapsedNs(flatStart, Clock::now());
+
+            std::sort(treeChunks.begin(), treeChunks.end());
+            std::sort(flatChunks.begin(), flatChunks.end());
+            if (treeChunks != flatChunks) treeMismatches++;
+            treeVisible += treeChunks.size();
+            treeNodesVisited += treeStats.nodesVisited;
+            treeNodesCulled += treeStats.nodesCulled;
+        }
+    }
+
+    // ------------------------------------------------------------
+    // 3h) Allocations: every chunk and LOD through buildLODMesh (LOD0
+    //     segmented, outputs from a MeshBufferPool reserved for the
+    //     previous mesh, returned after "upload"), twice on this
+    //     thread. Every chunk's version is bumped before each round, so
+    //     its mip chain is rebuilt too. The first round warms the pool,
+    //     the chains and the thread's scratch; the second must not
+    //     allocate. This is only the meshing inside a VoxelWorld job:
+    //     its result record, meshlets and MeshCache entries are not
+    //     covered.
+    // ------------------------------------------------------------
+    const int allocRounds = 2;
+    uint64_t allocCounts[allocRounds] = {};
+    uint64_t allocMeshes = 0;
+    MeshBufferPool allocPool;
+    {
+        std::vector<Vertex>   verts;
+        std::vector<uint32_t> inds;
+        MeshSliceLayout       layout;
+        MeshFaceRanges        faceRanges;
+        uint32_t              opaqueIndexCount = 0;
+        std::vector<int>      blocks;
+        for (int round = 0; round < allocRounds; round++)
+        {
+            // Same voxels, new version: cached mip levels are stale
+            for (Chunk* c : chunks)
+            {
+                blocks = c->getBlocks();
+                c->assignBlocks(blocks.data());
+            }
+
+            const uint64_t before = allocationCount();
+            for (const MeshJob& job : jobs)
+            {
+                const size_t estimate = job.verts.size();
+                allocPool.acquire(estimate, mesher.getBuildIndices() ? estimate / 4 * 6 : 0, verts, inds);
+                mesher.buildLODMesh(*job.chunk, job.cx, job.cy, job.cz, job.lodLevel,
+                    verts, inds, nullptr, (job.lodLevel == 0) ? &layout : nullptr,
+                    &opaqueIndexCount, &faceRanges);
+                allocPool.release(verts, inds);
+                if (round == 0) allocMeshes++;
+            }
+            allocCounts[round] = allocationCount() - before;
+        }
+    }
+
+    // ------------------------------------------------------------
+    // 3i) Mesh cache: every chunk and LOD meshed as VoxelWorld's jobs
+    //     do with a MeshCache (single thread): identical chunks are
+    //     meshed once. Every hit is checked against a fresh build.
+    // ------------------------------------------------------------
+    MeshCache meshCache;
+    uint64_t cacheHitNs = 0, cacheMissNs = 0, cacheMismatches = 0;
+    {
+        std::vector<Vertex>   verts, built;
+        std::vector<uint32_t> inds, builtInds;
+        MeshSliceLayout       layout, builtLayout;
+        MeshFaceRanges        faceRanges, builtFaceRanges;
+        uint32_t              opaqueIndexCount = 0, builtOpaque = 0;
+        for (const MeshJob& job : jobs)
+        {
+            MeshSliceLayout* slices = (job.lodLevel == 0) ? &layout : nullptr;
+            const int offX = job.cx * Chunk::SIZE_X;
+            const int offY = job.cy * Chunk::SIZE_Y;
+            const int offZ = job.cz * Chunk::SIZE_Z;
+
+            Clock::time_point t0 = Clock::now();
+            const uint64_t key = MeshCache::chunkKey(*job.chunk, job.lodLevel, mip,
+                slices != nullptr, mesher.getBuildIndices());
+            if (meshCache.lookup(key, offX, offY, offZ, verts, inds, opaqueIndexCount, slices, faceRanges))
+            {
+                cacheHitNs += elapsedNs(t0, Clock::now());
+
+                MeshSliceLayout* builtSlices = slices ? &builtLayout : nullptr;
+                mesher.buildLODMesh(*job.chunk, job.cx, job.cy, job.cz, job.lodLevel,
+                    built, builtInds, nullptr, builtSlices, &builtOpaque, &builtFaceRanges);
+                bool same = built.size() == verts.size()
+                    && std::memcmp(built.data(), verts.data(), sizeof(Vertex) * verts.size()) == 0
+                    && builtInds == inds && builtOpaque == opaqueIndexCount
+                    && std::memcmp(&builtFaceRanges, &faceRanges, sizeof(faceRanges)) == 0;
+                if (same && slices)
+                {
+                    same = builtLayout.slices.size() == layout.slices.size()
+                        && std::memcmp(builtLayout.slices.data(), layout.slices.data(),
+                            sizeof(MeshSlice) * layout.slices.size()) == 0
+                        && std::memcmp(builtLayout.freeSlot, layout.freeSlot, sizeof(layout.freeSlot)) == 0
+                        && std::memcmp(builtLayout.passEnd, layout.passEnd, sizeof(layout.passEnd)) == 0;
+                }
+                if (!same) cacheMismatches++;
+            }
+            else
+            {
+                mesher.buildLODMesh(*job.chunk, job.cx, job.cy, job.cz, job.lodLevel,
+                    verts, inds, nullptr, slices, &opaqueIndexCount, &faceRanges);
+                meshCache.store(key, offX, offY, offZ, verts, inds, opaqueIndexCount, slices, faceRanges);
+                cacheMissNs += elapsedNs(t0, Clock::now());
+            }
+        }
+    }
+
+    // ------------------------------------------------------------
+    // 3j) Raycasts: rays/s of benchmarkRaycasts from above the world's
+    //     centre, then random rays (origins above and inside the
+    //     terrain, through missing and empty chunks) traced one by one
+    //     and batched (shared chunk cache) against referenceRaycast.
+    // ------------------------------------------------------------
+    const int rayBenchCount = 20000;
+    const int rayCheckCount = 20000;
+    const float rayMaxDistance = 96.0f;
+    RaycastBenchmarkResult rayBench;
+    uint64_t rayCheckHits = 0, rayMismatches = 0, rayReferenceNs = 0, rayCheckNs = 0;
+    RaycastStats rayCheckStats;
+    {
+        const float worldExtent = float(worldSize * Chunk::SIZE_X);
+        rayBench = benchmarkRaycasts(chunkManager,
+            glm::vec3(worldExtent * 0.5f, float(Chunk::SIZE_Y) + 8.0f, worldExtent * 0.5f),
+            rayBenchCount, rayMaxDistance);
+
+        std::vector<glm::vec3> origins(rayCheckCount), dirs(rayCheckCount);
+        uint32_t rng = 0x2545F491u ^ (uint32_t)seed;
+        auto next = [&rng]() {
+            rng = rng * 1664525u + 1013904223u;
+            return (rng >> 8) / float(1u << 24);
+        };
+        for (int i = 0; i < rayCheckCount; i++)
+        {
+            // Up to three chunk layers above the one that exists
+            origins[i] = glm::vec3(next() * worldExtent, next() * 4.0f * Chunk::SIZE_Y, next() * worldExtent);
+            dirs[i] = glm::vec3(next() * 2.0f - 1.0f, next() * 2.0f - 1.0f, next() * 2.0f - 1.0f);
+        }
+
+        std::vector<RaycastHit> reference(rayCheckCount), batched(rayCheckCount);
+        Clock::time_point t0 = Clock::now();
+        for (int i = 0; i < rayCheckCount; i++) {
+            reference[i] = referenceRaycast(chunkManager, origins[i], dirs[i], rayMaxDistance);
+        }
+        rayReferenceNs = elapsedNs(t0, Clock::now());
+
+        VoxelRaycaster caster(chunkManager);
+        t0 = Clock::now();
+        for (int i = 0; i < rayCheckCount; i++)
+        {
+            const RaycastHit single = caster.raycast(origins[i], dirs[i], rayMaxDistance);
+            if (!sameHit(single, reference[i])) rayMismatches++;
+        }
+        caster.raycastBatch(origins.data(), dirs.data(), origins.size(), rayMaxDistance, batched.data());
+        rayCheckNs = elapsedNs(t0, Clock::now());
+        rayCheckStats = caster.getStats();
+        for (int i = 0; i < rayCheckCount; i++)
+        {
+            if (!sameHit(batched[i], reference[i])) rayMismatches++;
+            if (reference[i].hit) rayCheckHits++;
+        }
+    }
+
+    // ------------------------------------------------------------
+    // 3k) Edits: dig the top voxel of each chunk's centre column and
+    //     re-mesh LOD0 both ways: the whole greedy mesh, or only the
+    //     dirty slices of a segmented mesh (what VoxelWorld patches).
+    //     Bytes are what would be uploaded. Runs last, it edits chunks.
+    // ------------------------------------------------------------
+    uint64_t editCount = 0, editSlices = 0;
+    uint64_t fullEditNs = 0, fullEditBytes = 0;
+    uint64_t sliceEditNs = 0, sliceEditBytes = 0;
+    {
+        std::vector<Vertex>   verts;
+        std::vector<uint32_t> inds;
+        MeshSliceLayout       layout;
+        const int col = Chunk::SIZE_X / 2;
+        for (size_t i = 0; i < chunkCount; i++)
+        {
+            Chunk* c = chunks[i];
+            int top = -1;
+            for (int y = Chunk::SIZE_Y - 1; y >= 0 && top < 0; y--) {
+                if (c->getBlock(col, y, col) > 0) top = y;
+            }
+            if (top < 0) continue;
+
+            int offX = c->worldX() * Chunk::SIZE_X;
+            int offY = c->worldY() * Chunk::SIZE_Y;
+            int offZ = c->worldZ() * Chunk::SIZE_Z;
+            mesher.buildSegmentedMesh(*c, c->worldX(), c->worldY(), c->worldZ(), verts, inds, layout);
+            c->clearDirtySlices();
+            c->setBlock(col, top, col, 0);
+            editCount++;
+
+            Clock::time_point t0 = Clock::now();
+            mesher.generateMeshGreedy(*c, verts, inds, offX, offY, offZ);
+            fullEditNs += elapsedNs(t0, Clock::now());
+            fullEditBytes += sizeof(Vertex) * verts.size() + sizeof(uint32_t) * inds.size();
+
+            t0 = Clock::now();
+            for (int face = 0; face < 6; face++)
+            {
+                for (int layer = 0; layer < Chunk::SIZE_X; layer++)
+                {
+                    if (!(c->getDirtySlices(face) & (1u << layer))) continue;
+                    std::vector<Vertex> passVerts[MeshSliceLayout::PASS_COUNT];
+                    mesher.buildSliceQuads(*c, face, layer, offX, offY, offZ, passVerts[0], passVerts[1]);
+
+                    // A slice that outgrows its run moves and blanks the old one
+                    for (int pass = 0; pass < MeshSliceLayout::PASS_COUNT; pass++)
+                    {
+                        const MeshSlice& slice = layout.slices[((size_t)pass * 6 + face) * Chunk::SIZE_X + layer];
+                        size_t quads = passVerts[pass].size() / 4;
+                        size_t written = (quads > slice.capacity)
+                            ? ChunkMesher::sliceCapacity((int)quads) + slice.capacity
+                            : slice.capacity;
+                        sliceEditBytes += sizeof(Vertex) * 4 * written;
+                    }
+                    editSlices++;
+                }
+            }
+            sliceEditNs += elapsedNs(t0, Clock::now());
+            c->clearDirtySlices();
+        }
+    }
+
+    // ------------------------------------------------------------
+    // 4) Report
+    // ------------------------------------------------------------
+    FILE* f = stdout;
+    if (!outPath.empty())
+    {
+        f = std::fopen(outPath.c_str(), "w");
+        if (!f) {
+            std::fprintf(stderr, "world_bench: can't open %s\n", outPath.c_str());
+            return EXIT_FAILURE;
+        }
+    }
+
+    LatencySeries genLatency;
+    genLatency.samplesNs = genNs;
+
+    double totalWallSec = (genWallNs + meshWallNs + uploadWallNs) / 1.0e9;
+
+    std::fprintf(f, "{\n");
+    std::fprintf(f, "  \"config\": {\"worldSize\":%d,\"chunks\":%zu,\"seed\":%d,\"threads\":%zu,\"lodCount\":%d,\"mipReduction\":\"%s\",\"meshFormat\":\"%s\"},\n",
+        worldSize, chunkCount, seed, g_threadPool.getThreadCount(), LOD_COUNT, mipReductionName(mip),
+        sinkFormatName(sinkFormat));
+
+    std::fprintf(f, "  \"generation\": {\"wallMs\":%.3f,\"chunksPerSec\":%.1f,\"solidVoxels\":%lld,\"latencyMs\":",
+        genWallNs / 1.0e6, chunkCount / (genWallNs / 1.0e9),
+        (long long)chunkManager.getVoxelStats().getNonAirCount());
+    genLatency.writeJson(f);
+    std::fprintf(f, "},\n");
+
+    std::fprintf(f, "  \"meshing\": {\"wallMs\":%.3f,\"chunksPerSec\":%.1f,\"jobLatencyMs\":",
+        meshWallNs / 1.0e6, chunkCount / (meshWallNs / 1.0e9));
+    jobLatency.writeJson(f);
+    std::fprintf(f, ",\"connectivityLatencyMs\":");
+    connectivityLatency.writeJson(f);
+    std::fprintf(f, ",\n    \"lods\": [\n");
+    for (int L = 0; L < LOD_COUNT; L++)
+    {
+        LODTotals& t = lodTotals[L];
+        std::fprintf(f, "      {\"lod\":%d,\"meshes\":%llu,\"vertices\":%llu,\"triangles\":%llu,\"bytes\":%llu,\"meshLatencyMs\":",
+            L, (unsigned long long)t.meshes, (unsigned long long)t.vertices,
+            (unsigned long long)t.triangles, (unsigned long long)t.bytes);
+        t.meshLatency.writeJson(f);
+        std::fprintf(f, ",\"downsampleLatencyMs\":");
+        t.downsampleLatency.writeJson(f);
+        std::fprintf(f, "}%s\n", L + 1 < LOD_COUNT ? "," : "");
+    }
+    std::fprintf(f, "    ]},\n");
+
+    std::fprintf(f, "  \"upload\": {\"wallMs\":%.3f,\"meshes\":%llu,\"residentBytes\":%zu,"
+        "\"sharedUploads\":%llu,\"packedQuads\":%llu,\"packMismatches\":%llu,\"latencyMs\":",
+        uploadWallNs / 1.0e6, (unsigned long long)sink.getUploadCount(), residentBytes,
+        (unsigned long long)sink.getSharedUploadCount(),
+        (unsigned long long)sink.getPackedQuadCount(), (unsigned long long)sink.getPackMismatchCount());
+    uploadLatency.writeJson(f);
+    std::fprintf(f, "},\n");
+
+    std::fprintf(f, "  \"seams\": [\n");
+    for (int sc = 0; sc < seamCases; sc++)
+    {
+        const SeamTotals& t = seamTotals[sc];
+        std::fprintf(f, "    {\"lods\":\"%s\",\"meshes\":%llu,\"triangles\":%llu,\"wallMs\":%.3f}%s\n",
+            sc < LOD_COUNT ? std::to_string(sc).c_str() : "0/1",
+            (unsigned long long)t.meshes, (unsigned long long)t.triangles, t.wallNs / 1.0e6,
+            sc + 1 < seamCases ? "," : "");
+    }
+    std::fprintf(f, "  ],\n");
+
+    std::fprintf(f, "  \"superchunks\": {\"groupSize\":%d,\"lod\":%d,\"wallMs\":%.3f,\"meshes\":%llu,\"triangles\":%llu,"
+        "\"chunkMeshes\":%llu,\"chunkTriangles\":%llu},\n",
+        superGroup, coarsest, superWallNs / 1.0e6, (unsigned long long)superMeshes, (unsigned long long)superTriangles,
+        (unsigned long long)memberMeshes, (unsigned long long)memberTriangles);
+
+    std::fprintf(f, "  \"edits\": {\"count\":%llu,\"slices\":%llu,\"fullRemeshMs\":%.3f,\"fullBytes\":%llu,"
+        "\"sliceRemeshMs\":%.3f,\"patchBytes\":%llu},\n",
+        (unsigned long long)editCount, (unsigned long long)editSlices,
+        fullEditNs / 1.0e6, (unsigned long long)fullEditBytes,
+        sliceEditNs / 1.0e6, (unsigned long long)sliceEditBytes);
+
+    std::fprintf(f, "  \"allocations\": {\"meshes\":%llu,\"warmRound\":%llu,\"steadyRound\":%llu,"
+        "\"poolReuses\":%llu,\"poolMisses\":%llu},\n",
+        (unsigned long long)allocMeshes, (unsigned long long)allocCounts[0],
+        (unsigned long long)allocCounts[allocRounds - 1],
+        (unsigned long long)allocPool.getReuseCount(), (unsigned long long)allocPool.getMissCount());
+
+    const uint64_t cacheLookups = meshCache.getLookupCount();
+    const uint64_t cacheHits = meshCache.getHitCount();
+    std::fprintf(f, "  \"meshCache\": {\"lookups\":%llu,\"hits\":%llu,\"hitRate\":%.3f,\"entries\":%zu,\"bytes\":%zu,"
+        "\"missMs\":%.3f,\"hitMs\":%.3f,\"mismatches\":%llu},\n",
+        (unsigned long long)cacheLookups, (unsigned long long)cacheHits,
+        cacheLookups ? (double)cacheHits / cacheLookups : 0.0,
+        meshCache.getEntryCount(), meshCache.getBytes(),
+        cacheMissNs / 1.0e6, cacheHitNs / 1.0e6, (unsigned long long)cacheMismatches);
+
+    std::fprintf(f, "  \"facing\": {\"lod\":0,\"viewpoints\":%d,\"triangles\":%llu,\"submittedTriangles\":%llu,"
+        "\"passDraws\":%llu,\"rangeDraws\":%llu},\n",
+        facingEyeCount, (unsigned long long)facingTriangles, (unsigned long long)facingSubmitted,
+        (unsigned long long)facingPassDraws, (unsigned long long)facingRangeDraws);
+    std::fprintf(f, "  \"meshlets\": {\"lod\":0,\"cameras\":%d,\"meshlets\":%llu,\"buildMs\":%.3f,"
+        "\"chunkCulledTriangles\":%llu,\"meshletCulledTriangles\":%llu,\"drawn\":%llu,\"culled\":%llu,\"cullMs\":%.3f},\n",
+        facingEyeCount, (unsigned long long)meshletCount, meshletBuildNs / 1.0e6,
+        (unsigned long long)meshletChunkTriangles, (unsigned long long)meshletSubmitted,
+        (unsigned long long)meshletsDrawn, (unsigned long long)meshletsCulled, meshletCullNs / 1.0e6);
+    std::fprintf(f, "  \"frustumCull\": {\"simd\":\"%s\",\"mismatches\":%llu,\"cases\":[",
+        Frustum::simdPath(), (unsigned long long)cullMismatches);
+    for (int c = 0; c < cullCaseCount; c++)
+    {
+        const double boxesTested = (double)cullBoxCounts[c] * cullReps[c];
+        std::fprintf(f, "%s\n    {\"boxes\":%zu,\"visible\":%zu,\"reps\":%d,\"scalarNsPerBox\":%.3f,\"batchNsPerBox\":%.3f}",
+            c ? "," : "", cullBoxCounts[c], cullVisible[c], cullReps[c],
+            cullScalarNs[c] / boxesTested, cullBatchNs[c] / boxesTested);
+    }
+    std::fprintf(f, "]},\n");
+    std::fprintf(f, "  \"mipKernels\": {\"kernel\":\"%s\",\"cases\":%llu,\"mismatches\":%llu},\n",
+        mipKernelName(), (unsigned long long)mipCases, (unsigned long long)mipMismatches);
+    std::fprintf(f, "  \"quadtree\": {\"chunks\":%zu,\"nodes\":%zu,\"refreshMs\":%.3f,\"cameras\":%d,\"reps\":%d,"
+        "\"visibleChunks\":%llu,\"nodesVisited\":%llu,\"nodesCulled\":%llu,\"treeUsPerCull\":%.3f,\"flatUsPerCull\":%.3f,"
+        "\"mismatches\":%llu},\n",
+        quadtree.getChunkCount(), quadtree.getNodeCount(), treeRefreshNs / 1.0e6, facingEyeCount, treeReps,
+        (unsigned long long)treeVisible, (unsigned long long)treeNodesVisited, (unsigned long long)treeNodesCulled,
+        treeNs / 1.0e3 / ((double)treeReps * facingEyeCount), flatNs / 1.0e3 / ((double)treeReps * facingEyeCount),
+        (unsigned long long)treeMismatches);
+
+    std::fprintf(f, "  \"raycast\": {\"rays\":%d,\"hits\":%d,\"singleRaysPerSec\":%.0f,\"batchRaysPerSec\":%.0f,"
+        "\"checkedRays\":%d,\"checkedHits\":%llu,\"acceleratedRaysPerSec\":%.0f,\"referenceRaysPerSec\":%.0f,"
+        "\"voxelSteps\":%llu,\"chunkSkips\":%llu,\"chunkLookups\":%llu,\"mismatches\":%llu},\n",
+        rayBench.rayCount, rayBench.hitCount, rayBench.singleRaysPerSec, rayBench.batchRaysPerSec,
+        rayCheckCount, (unsigned long long)rayCheckHits,
+        rayCheckNs ? 2.0 * rayCheckCount * 1.0e9 / rayCheckNs : 0.0,
+        rayReferenceNs ? rayCheckCount * 1.0e9 / rayReferenceNs : 0.0,
+        (unsigned long long)rayCheckStats.voxelSteps, (unsigned long long)rayCheckStats.chunkSkips,
+        (unsigned long long)rayCheckStats.chunkLookups, (unsigned long long)rayMismatches);
+
+    std::fprintf(f, "  \"total\": {\"wallMs\":%.3f,\"chunksPerSec\":%.1f},\n",
+        totalWallSec * 1.0e3, chunkCount / totalWallSec);
+    std::fprintf(f, "  \"meshHash\": \"%016llx\"\n", (unsigned long long)meshHash);
+    std::fprintf(f, "}\n");
+
+    if (f != stdout) std::fclose(f);
+
+    const bool steadyAllocFree = (allocCounts[allocRounds - 1] == 0);
+    if (!steadyAllocFree) {
+        std::fprintf(stderr, "world_bench: steady-state meshing allocated %llu times\n",
+            (unsigned long long)allocCounts[allocRounds - 1]);
+    }
+    if (cacheMismatches > 0) {
+        std::fprintf(stderr, "world_bench: %llu mesh cache hits differ from a fresh build\n",
+            (unsigned long long)cacheMismatches);
+    }
+    if (mipMismatches > 0) {
+        std::fprintf(stderr, "world_bench: SIMD voxel downsampling differs from scalar in %llu cases\n",
+            (unsigned long long)mipMismatches);
+    }
+    if (treeMismatches > 0) {
+        std::fprintf(stderr, "world_bench: quadtree culling differs from a flat loop for %llu cameras\n",
+            (unsigned long long)treeMismatches);
+    }
+    if (rayMismatches > 0) {
+        std::fprintf(stderr, "world_bench: %llu raycasts differ from per-voxel stepping\n",
+            (unsigned long long)rayMismatches);
+    }
+    if (cullMismatches > 0) {
+        std::fprintf(stderr, "world_bench: batched frustum culling differs from intersectsAABB in %llu cases\n",
+            (unsigned long long)cullMismatches);
+    }
+
+    g_threadPool.shutdown();
+    Logger::shutdown();
+    return (steadyAllocFree && cacheMismatches == 0 && cullMismatches == 0 && mipMismatches == 0 && treeMismatches == 0
+        && rayMismatches == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}